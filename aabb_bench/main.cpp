@@ -0,0 +1,255 @@
+// aabb_bench: compares the per-box ball sweep with the SIMD batch kernels of sweepbatch.h
+// and the uniform grid broadphase of spatialgrid.h
+#include "sweepbatch.h"
+#include "spatialgrid.h"
+#include "config.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <cmath>
+
+/**
+ * @struct BenchBoxes
+ * @brief Random obstacle boxes stored as structure of arrays, like an ObstacleStore.
+ */
+struct BenchBoxes
+{
+    std::vector<float> x, y, width, height;
+    std::vector<uint8_t> active;
+
+    BoxBatch getBatch() const
+    {
+        BoxBatch batch;
+        batch.x = x.data();
+        batch.y = y.data();
+        batch.width = width.data();
+        batch.height = height.data();
+        batch.active = active.data();
+        batch.count = x.size();
+        return batch;
+    }
+};
+
+/**
+ * @brief Scatters obstacle-sized boxes over the canvas; one in eight is inactive.
+ */
+static BenchBoxes makeBoxes(size_t count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> pos_x(0.0f, CANVAS_WIDTH);
+    std::uniform_real_distribution<float> pos_y(0.0f, CANVAS_HEIGHT);
+    std::uniform_real_distribution<float> size(20.0f, 120.0f);
+
+    BenchBoxes boxes;
+    for (size_t i = 0; i < count; i++)
+    {
+        boxes.x.push_back(pos_x(rng));
+        boxes.y.push_back(pos_y(rng));
+        boxes.width.push_back(size(rng));
+        boxes.height.push_back(size(rng));
+        boxes.active.push_back(i % 8 != 7 ? 1 : 0);
+    }
+    return boxes;
+}
+
+/**
+ * @brief A ball position and its movement over one tick.
+ */
+struct BenchQuery
+{
+    Box ball;
+    float dx, dy;
+};
+
+/**
+ * @brief Random ball queries; a few move along a single axis to exercise those paths.
+ */
+static std::vector<BenchQuery> makeQueries(size_t count, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> pos_x(0.0f, CANVAS_WIDTH);
+    std::uniform_real_distribution<float> pos_y(0.0f, CANVAS_HEIGHT);
+    std::uniform_real_distribution<float> move(-60.0f, 60.0f);
+
+    std::vector<BenchQuery> queries;
+    for (size_t i = 0; i < count; i++)
+    {
+        BenchQuery query{ Box(pos_x(rng), pos_y(rng), 20.0f, 20.0f), move(rng), move(rng) };
+        if (i % 16 == 0)
+            query.dx = 0.0f;
+        else if (i % 16 == 1)
+            query.dy = 0.0f;
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+/**
+ * @brief Earliest hit with the per-box loop Simulation used before the batch kernels.
+ */
+static float earliestPerBox(const BenchQuery& query, const BoxBatch& batch)
+{
+    float earliest = 2.0f;
+    for (size_t i = 0; i < batch.count; i++)
+    {
+        if (!batch.active[i])
+            continue;
+        float normal_x, normal_y;
+        float time = query.ball.sweep(Box(batch.x[i], batch.y[i], batch.width[i], batch.height[i]),
+            query.dx, query.dy, normal_x, normal_y);
+        if (time < earliest)
+            earliest = time;
+    }
+    return earliest;
+}
+
+/**
+ * @brief Earliest hit with a batch kernel.
+ */
+static float earliestBatch(const BenchQuery& query, const BoxBatch& batch, std::vector<float>& times, SimdLevel level)
+{
+    sweepBatchTimes(query.ball, query.dx, query.dy, batch, times.data(), level);
+    float earliest = 2.0f;
+    for (size_t i = 0; i < batch.count; i++)
+    {
+        if (times[i] < earliest)
+            earliest = times[i];
+    }
+    return earliest;
+}
+
+/**
+ * @brief Scratch buffers of the grid candidates of a query.
+ */
+struct GridScratch
+{
+    std::vector<uint32_t> ids;
+    BenchBoxes boxes;
+    std::vector<float> times;
+};
+
+/**
+ * @brief Earliest hit among the boxes the grid finds in the swept bounds of the query.
+ */
+static float earliestGrid(const BenchQuery& query, const SpatialGrid& grid, const BenchBoxes& boxes, GridScratch& scratch)
+{
+    const Box& ball = query.ball;
+    Box region(ball.m_pos_x + query.dx / 2.0f, ball.m_pos_y + query.dy / 2.0f,
+        ball.m_width + std::fabs(query.dx) + 1.0f, ball.m_height + std::fabs(query.dy) + 1.0f);
+    grid.query(region, scratch.ids);
+
+    BenchBoxes& c = scratch.boxes;
+    c.x.clear();
+    c.y.clear();
+    c.width.clear();
+    c.height.clear();
+    for (uint32_t id : scratch.ids)
+    {
+        c.x.push_back(boxes.x[id]);
+        c.y.push_back(boxes.y[id]);
+        c.width.push_back(boxes.width[id]);
+        c.height.push_back(boxes.height[id]);
+    }
+    c.active.assign(scratch.ids.size(), 1);
+    scratch.times.resize(scratch.ids.size());
+    return scratch.ids.empty() ? 2.0f : earliestBatch(query, c.getBatch(), scratch.times, getSimdLevel());
+}
+
+/**
+ * @brief Runs fn over all queries repeatedly for about 0.2 s.
+ * @return Nanoseconds per query.
+ */
+template <typename Fn>
+static double timeQueries(const std::vector<BenchQuery>& queries, Fn fn, float& checksum)
+{
+    using Clock = std::chrono::steady_clock;
+    size_t calls = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    do
+    {
+        for (const BenchQuery& query : queries)
+        {
+            checksum += fn(query);
+        }
+        calls += queries.size();
+        elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    } while (elapsed < 2e8);
+    return elapsed / calls;
+}
+
+int main()
+{
+    const size_t counts[] = { 10, 100, 10000 };
+    const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2 };
+    const SimdLevel best = getSimdLevel();
+    std::mt19937 rng(1);
+
+    std::cout << "Best instruction set: " << getSimdLevelName(best) << "\n\n";
+    std::cout << std::left << std::setw(10) << "boxes" << std::setw(12) << "kernel"
+        << std::right << std::setw(14) << "ns/query" << std::setw(12) << "ns/box" << std::setw(10) << "speedup" << "\n";
+
+    int mismatches = 0;
+    for (size_t count : counts)
+    {
+        BenchBoxes boxes = makeBoxes(count, rng);
+        BoxBatch batch = boxes.getBatch();
+        std::vector<BenchQuery> queries = makeQueries(count >= 10000 ? 64 : 1024, rng);
+        std::vector<float> times(count), reference(count);
+        float checksum = 0.0f;
+
+        double base = timeQueries(queries, [&](const BenchQuery& q) { return earliestPerBox(q, batch); }, checksum);
+        std::cout << std::left << std::setw(10) << count << std::setw(12) << "per-box" << std::right << std::fixed
+            << std::setprecision(1) << std::setw(14) << base << std::setprecision(2) << std::setw(12) << base / count
+            << std::setw(9) << 1.0 << "x\n";
+
+        for (SimdLevel level : levels)
+        {
+            if (level > best)
+                continue;
+
+            // Every kernel must match Box::sweep bit for bit, or replays would diverge across CPUs
+            for (const BenchQuery& query : queries)
+            {
+                sweepBatchTimes(query.ball, query.dx, query.dy, batch, reference.data(), SimdLevel::SCALAR);
+                sweepBatchTimes(query.ball, query.dx, query.dy, batch, times.data(), level);
+                if (std::memcmp(reference.data(), times.data(), count * sizeof(float)) != 0)
+                    mismatches++;
+            }
+
+            double ns = timeQueries(queries, [&](const BenchQuery& q) { return earliestBatch(q, batch, times, level); }, checksum);
+            std::cout << std::left << std::setw(10) << count << std::setw(12) << getSimdLevelName(level) << std::right
+                << std::setprecision(1) << std::setw(14) << ns << std::setprecision(2) << std::setw(12) << ns / count
+                << std::setw(9) << base / ns << "x\n";
+        }
+        // Grid broadphase followed by the best kernel on the candidates
+        SpatialGrid grid;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (boxes.active[i])
+                grid.insert(static_cast<uint32_t>(i), Box(boxes.x[i], boxes.y[i], boxes.width[i], boxes.height[i]));
+        }
+        GridScratch scratch;
+        for (const BenchQuery& query : queries)
+        {
+            if (earliestGrid(query, grid, boxes, scratch) != earliestPerBox(query, batch))
+                mismatches++;
+        }
+
+        double ns = timeQueries(queries, [&](const BenchQuery& q) { return earliestGrid(q, grid, boxes, scratch); }, checksum);
+        std::cout << std::left << std::setw(10) << count << std::setw(12) << "grid" << std::right
+            << std::setprecision(1) << std::setw(14) << ns << std::setprecision(2) << std::setw(12) << ns / count
+            << std::setw(9) << base / ns << "x\n";
+
+        std::cout << "(checksum " << checksum << ")\n\n";
+    }
+
+    if (mismatches > 0)
+    {
+        std::cout << mismatches << " queries differ from the scalar results\n";
+        return 1;
+    }
+    std::cout << "All kernels match the scalar results\n";
+    return 0;
+}
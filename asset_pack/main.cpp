@@ -0,0 +1,194 @@
+// asset_pack: packs the assets of the manifest into one archive the game maps at startup
+#include "assetarchive.h"
+#include "assetmanifest.h"
+#include "leveldef.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @struct PackOptions
+ * @brief Command line options of the packer.
+ */
+struct PackOptions
+{
+    std::string asset_dir = "assets";           ///< Directory holding the loose assets.
+    std::string archive_path = "assets.pak";    ///< Archive to write.
+    std::string verify_path;                    ///< Archive to list and verify instead of packing.
+    std::string check_levels_path;              ///< Level file to check instead of packing.
+};
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage()
+{
+    std::cout <<
+        "Usage: asset_pack [options]\n"
+        "  --dir DIR      Directory holding the loose assets (default assets)\n"
+        "  --out PATH     Archive to write (default assets.pak)\n"
+        "  --verify PATH  List an archive and check the hash of every asset\n"
+        "  --levels PATH  Check a level file and print its levels\n";
+}
+
+/**
+ * @brief Parses the command line into options.
+ * @return False if the arguments are invalid or help was requested.
+ */
+static bool parseOptions(int argc, char** argv, PackOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+            return false;
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "--dir")
+            options.asset_dir = value;
+        else if (arg == "--out")
+            options.archive_path = value;
+        else if (arg == "--verify")
+            options.verify_path = value;
+        else if (arg == "--levels")
+            options.check_levels_path = value;
+        else
+        {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Lists the assets of an archive and checks their hashes.
+ * @return Process exit code: 0 if every asset is intact.
+ */
+static int verifyArchive(const std::string& path)
+{
+    AssetArchive archive;
+    if (!archive.open(path))
+    {
+        std::cerr << "Cannot open archive " << path << "\n";
+        return 1;
+    }
+
+    size_t corrupt = 0;
+    for (uint32_t id = 0; id < archive.getCount(); id++)
+    {
+        bool intact = archive.verify(id);
+        if (!intact)
+            corrupt++;
+        std::cout << id << "  " << archive.getName(id) << "  " << archive.getData(id).size << " bytes"
+            << (intact ? "" : "  CORRUPT") << "\n";
+    }
+    std::cout << archive.getCount() << " assets, " << corrupt << " corrupt\n";
+    return corrupt == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Parses a level text file.
+ * @return False if the file cannot be read or is invalid; the error has been printed.
+ */
+static bool readLevels(const std::string& path, LevelSet& levels)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        std::cerr << "Cannot read " << path << "\n";
+        return false;
+    }
+
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::string error;
+    if (!levels.parse(text.data(), text.size(), error))
+    {
+        std::cerr << path << ": " << error << "\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks a level file and prints a summary of every level.
+ * @return Process exit code: 0 if the file is valid.
+ */
+static int checkLevels(const std::string& path)
+{
+    LevelSet levels;
+    if (!readLevels(path, levels))
+        return 1;
+
+    for (const LevelDef& level : levels.getLevels())
+    {
+        std::cout << "level " << level.number << "  " << level.obstacle_type.size() << " obstacles, "
+            << level.powerup_type.size() << " powerups, " << level.spawners.size() << " spawners\n";
+    }
+    std::cout << levels.getLevels().size() << " levels, " << levels.save().size() << " bytes compiled\n";
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    PackOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (!options.verify_path.empty())
+    {
+        return verifyArchive(options.verify_path);
+    }
+    if (!options.check_levels_path.empty())
+    {
+        return checkLevels(options.check_levels_path);
+    }
+
+    // Assets missing from the directory are left out; the game falls back to loose files for them
+    std::vector<AssetArchive::Source> sources;
+    for (size_t i = 0; i < ASSET_COUNT; i++)
+    {
+        AssetArchive::Source source;
+        source.name = ASSET_MANIFEST[i].name;
+        source.path = options.asset_dir + "/" + source.name;
+        if (!std::ifstream(source.path, std::ios::binary))
+        {
+            std::cerr << "Skipping missing asset " << source.path << "\n";
+            continue;
+        }
+        sources.push_back(source);
+    }
+
+    // The level file is compiled, so the game loads it without parsing text
+    std::string levels_path = options.asset_dir + "/" + LEVELS_TEXT_ASSET;
+    if (std::ifstream(levels_path, std::ios::binary))
+    {
+        AssetArchive::Source source;
+        LevelSet levels;
+        if (!readLevels(levels_path, levels))
+            return 1;
+        source.name = LEVELS_BINARY_ASSET;
+        source.data = levels.save();
+        sources.push_back(source);
+    }
+
+    std::string error;
+    if (!AssetArchive::pack(options.archive_path, sources, error))
+    {
+        std::cerr << "Packing failed: " << error << "\n";
+        return 1;
+    }
+
+    std::cout << "Packed " << sources.size() << " assets into " << options.archive_path << "\n";
+    return 0;
+}
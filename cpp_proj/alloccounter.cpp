@@ -0,0 +1,67 @@
+#include "alloccounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if PONG_COUNT_ALLOCATIONS
+static std::atomic<uint64_t> s_allocations(0);
+static std::atomic<uint64_t> s_frees(0);
+static std::atomic<uint64_t> s_bytes(0);
+static thread_local uint64_t t_allocations = 0;
+
+/**
+ * @brief Allocates and counts a block. Throws std::bad_alloc like the standard operator.
+ */
+static void* countedAlloc(size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    t_allocations++;
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    // malloc(0) may return nullptr, but operator new must return a unique pointer
+    void* block = std::malloc(size ? size : 1);
+    if (!block)
+        throw std::bad_alloc();
+    return block;
+}
+
+static void countedFree(void* block) noexcept
+{
+    if (!block)
+        return;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(block);
+}
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    try { return countedAlloc(size); }
+    catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    try { return countedAlloc(size); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* block) noexcept { countedFree(block); }
+void operator delete[](void* block) noexcept { countedFree(block); }
+void operator delete(void* block, size_t) noexcept { countedFree(block); }
+void operator delete[](void* block, size_t) noexcept { countedFree(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { countedFree(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { countedFree(block); }
+
+uint64_t AllocCounter::getAllocations() { return s_allocations.load(std::memory_order_relaxed); }
+uint64_t AllocCounter::getThreadAllocations() { return t_allocations; }
+uint64_t AllocCounter::getFrees() { return s_frees.load(std::memory_order_relaxed); }
+uint64_t AllocCounter::getBytes() { return s_bytes.load(std::memory_order_relaxed); }
+#else
+uint64_t AllocCounter::getAllocations() { return 0; }
+uint64_t AllocCounter::getThreadAllocations() { return 0; }
+uint64_t AllocCounter::getFrees() { return 0; }
+uint64_t AllocCounter::getBytes() { return 0; }
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Compile-time switch of the allocation counter: with PONG_COUNT_ALLOCATIONS=1 the global
+ * operator new and delete are replaced by versions that count every heap allocation of the
+ * program. With 0 the counts stay at zero and the standard operators are used.
+ */
+#ifndef PONG_COUNT_ALLOCATIONS
+#define PONG_COUNT_ALLOCATIONS 1
+#endif
+
+/**
+ * @class AllocCounter
+ * @brief Counts heap allocations made through operator new, so a scope can check that it did not
+ * touch the heap: read getThreadAllocations() before and after and compare.
+ *
+ * The process-wide counters are relaxed atomics; each thread also counts its own allocations, so
+ * work of other threads (the logger formatting its records, for one) does not show up in a frame.
+ * Only the game and pong_bench link the replacement operators; the other tools keep the standard ones.
+ */
+class AllocCounter
+{
+public:
+    /**
+     * @brief Number of allocations since the program started.
+     */
+    static uint64_t getAllocations();
+
+    /**
+     * @brief Number of allocations made by the calling thread since it started.
+     */
+    static uint64_t getThreadAllocations();
+
+    /**
+     * @brief Number of deallocations since the program started.
+     */
+    static uint64_t getFrees();
+
+    /**
+     * @brief Bytes requested by all allocations since the program started.
+     */
+    static uint64_t getBytes();
+
+    /**
+     * @brief Checks if the counting operators are compiled in.
+     */
+    static bool isEnabled() { return PONG_COUNT_ALLOCATIONS != 0; }
+};
@@ -0,0 +1,298 @@
+#include "assetarchive.h"
+#include <fstream>
+#include <cstring>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// File header: magic, format version, asset count and offset of the index
+static const char ARCHIVE_MAGIC[4] = { 'P', 'P', 'A', 'K' };
+static const uint32_t ARCHIVE_VERSION = 1;
+static const size_t HEADER_SIZE = sizeof(ARCHIVE_MAGIC) + 4 + 4 + 8;
+
+// Alignment of the data of every asset
+static const size_t DATA_ALIGNMENT = 16;
+
+/**
+ * @brief Appends a fixed-size little-endian integer.
+ */
+template <typename T>
+static void writeFixed(std::vector<uint8_t>& out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Reads a fixed-size little-endian integer from a mapping.
+ * @return False if the value would extend past the end.
+ */
+template <typename T>
+static bool readFixed(const uint8_t* data, size_t size, size_t& offset, T& value)
+{
+    if (size < offset || size - offset < sizeof(T))
+        return false;
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        value |= static_cast<T>(data[offset++]) << (8 * i);
+    }
+    return true;
+}
+
+const uint32_t AssetArchive::NO_ASSET;
+
+AssetArchive::~AssetArchive()
+{
+    close();
+}
+
+/**
+ * @brief Maps an archive into memory and reads its index.
+ *
+ * @param path Archive file.
+ * @return False if the file cannot be mapped or is not a valid archive.
+ */
+bool AssetArchive::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping)
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(file, &info) == 0 && info.st_size > 0)
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file); // The mapping keeps the file alive
+    if (view == MAP_FAILED)
+        return false;
+
+    m_data = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!readIndex())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Unmaps the archive and forgets its index.
+ */
+void AssetArchive::close()
+{
+    if (m_data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+        m_file = nullptr;
+        m_mapping = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_entries.clear();
+    m_ids.clear();
+}
+
+bool AssetArchive::readIndex()
+{
+    if (m_size < HEADER_SIZE || std::memcmp(m_data, ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0)
+        return false;
+
+    size_t offset = sizeof(ARCHIVE_MAGIC);
+    uint32_t version, count;
+    uint64_t index_offset;
+    if (!readFixed(m_data, m_size, offset, version) || version != ARCHIVE_VERSION ||
+        !readFixed(m_data, m_size, offset, count) ||
+        !readFixed(m_data, m_size, offset, index_offset) ||
+        index_offset > m_size)
+        return false;
+
+    offset = static_cast<size_t>(index_offset);
+    m_entries.resize(count);
+    for (uint32_t id = 0; id < count; id++)
+    {
+        Entry& entry = m_entries[id];
+        uint16_t name_length;
+        if (!readFixed(m_data, m_size, offset, name_length) || m_size - offset < name_length)
+            return false;
+        entry.name.assign(reinterpret_cast<const char*>(m_data + offset), name_length);
+        offset += name_length;
+
+        if (!readFixed(m_data, m_size, offset, entry.offset) ||
+            !readFixed(m_data, m_size, offset, entry.size) ||
+            !readFixed(m_data, m_size, offset, entry.hash) ||
+            entry.offset > index_offset || entry.size > index_offset - entry.offset)
+            return false;
+
+        m_ids.emplace(entry.name, id);
+    }
+    return true;
+}
+
+/**
+ * @brief Looks up an asset by name.
+ *
+ * @param name Name the asset was packed under.
+ * @return Its id, or NO_ASSET.
+ */
+uint32_t AssetArchive::find(const std::string& name) const
+{
+    auto it = m_ids.find(name);
+    return it != m_ids.end() ? it->second : NO_ASSET;
+}
+
+/**
+ * @brief Retrieves the bytes of an asset, pointing into the mapping.
+ *
+ * @param id Id of the asset.
+ * @return The span, empty for an invalid id.
+ */
+AssetSpan AssetArchive::getData(uint32_t id) const
+{
+    AssetSpan span;
+    if (id < m_entries.size())
+    {
+        span.data = m_data + m_entries[id].offset;
+        span.size = static_cast<size_t>(m_entries[id].size);
+    }
+    return span;
+}
+
+/**
+ * @brief Checks the bytes of an asset against its recorded hash. Reading the bytes also pages
+ * them in.
+ *
+ * @param id Id of the asset.
+ * @return True if the asset exists and is intact.
+ */
+bool AssetArchive::verify(uint32_t id) const
+{
+    AssetSpan span = getData(id);
+    return !span.empty() && hashData(span.data, span.size) == m_entries[id].hash;
+}
+
+/**
+ * @brief Computes the FNV-1a hash of asset data.
+ */
+uint64_t AssetArchive::hashData(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes an archive holding the given files. The id of each asset is its position in
+ * sources.
+ *
+ * @param path Archive to write.
+ * @param sources Files or in-memory data to pack, with the names to store them under.
+ * @param error Receives a description of the failure.
+ * @return False if a file could not be read or the archive could not be written.
+ */
+bool AssetArchive::pack(const std::string& path, const std::vector<Source>& sources, std::string& error)
+{
+    std::vector<uint8_t> data(HEADER_SIZE);
+    std::vector<uint8_t> index;
+
+    for (const Source& source : sources)
+    {
+        std::ifstream in;
+        if (!source.path.empty())
+        {
+            in.open(source.path, std::ios::binary);
+            if (!in)
+            {
+                error = "cannot read " + source.path;
+                return false;
+            }
+        }
+        if (source.name.size() > UINT16_MAX)
+        {
+            error = "name too long: " + source.name;
+            return false;
+        }
+
+        data.resize((data.size() + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT);
+        uint64_t offset = data.size();
+        if (source.path.empty())
+            data.insert(data.end(), source.data.begin(), source.data.end());
+        else
+            data.insert(data.end(), std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        uint64_t size = data.size() - offset;
+
+        writeFixed(index, static_cast<uint16_t>(source.name.size()));
+        index.insert(index.end(), source.name.begin(), source.name.end());
+        writeFixed(index, offset);
+        writeFixed(index, size);
+        writeFixed(index, hashData(data.data() + offset, static_cast<size_t>(size)));
+    }
+
+    std::vector<uint8_t> header(ARCHIVE_MAGIC, ARCHIVE_MAGIC + sizeof(ARCHIVE_MAGIC));
+    writeFixed(header, ARCHIVE_VERSION);
+    writeFixed(header, static_cast<uint32_t>(sources.size()));
+    writeFixed(header, static_cast<uint64_t>(data.size()));
+    std::memcpy(data.data(), header.data(), HEADER_SIZE);
+    data.insert(data.end(), index.begin(), index.end());
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!out)
+    {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
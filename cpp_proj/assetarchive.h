@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct AssetSpan
+ * @brief Bytes of an asset inside a mapped archive. Valid while the archive stays open.
+ */
+struct AssetSpan
+{
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    bool empty() const { return data == nullptr; }
+};
+
+/**
+ * @class AssetArchive
+ * @brief Single file holding many assets, read through a memory mapping.
+ *
+ * The file starts with a header, followed by the asset data (each asset 16-byte aligned) and an
+ * index giving the name, offset, size and FNV-1a hash of every asset. open() maps the file and
+ * parses the index once; afterwards assets are served as spans into the mapping, by name or by
+ * their position in the index, without copying. pack() writes an archive from loose files.
+ */
+class AssetArchive
+{
+public:
+    static const uint32_t NO_ASSET = UINT32_MAX;    ///< Id returned by find() for unknown names.
+
+    /**
+     * @struct Source
+     * @brief A loose file to pack, and the name it is stored under.
+     */
+    struct Source
+    {
+        std::string name;
+        std::string path;
+        std::vector<uint8_t> data;  ///< Packed instead of the file when path is empty.
+    };
+
+    AssetArchive() {}
+    ~AssetArchive();
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    /**
+     * @brief Maps an archive and reads its index, closing any archive opened before.
+     * @return False if the file cannot be mapped or is not a valid archive.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the archive. Spans handed out before become invalid.
+     */
+    void close();
+
+    /**
+     * @brief Checks if an archive is open.
+     */
+    bool isOpen() const { return m_data != nullptr; }
+
+    /**
+     * @brief Returns the number of assets in the archive.
+     */
+    size_t getCount() const { return m_entries.size(); }
+
+    /**
+     * @brief Looks up an asset by name.
+     * @return Its id (index position), or NO_ASSET.
+     */
+    uint32_t find(const std::string& name) const;
+
+    /**
+     * @brief Retrieves the bytes of an asset.
+     * @return The span, empty for an invalid id.
+     */
+    AssetSpan getData(uint32_t id) const;
+
+    /**
+     * @brief Retrieves the bytes of an asset by name.
+     * @return The span, empty if the archive has no such asset.
+     */
+    AssetSpan getData(const std::string& name) const { return getData(find(name)); }
+
+    /**
+     * @brief Retrieves the name of an asset.
+     */
+    const std::string& getName(uint32_t id) const { return m_entries[id].name; }
+
+    /**
+     * @brief Checks the bytes of an asset against the hash recorded when it was packed.
+     */
+    bool verify(uint32_t id) const;
+
+    /**
+     * @brief Computes the FNV-1a hash the archive records for asset data.
+     */
+    static uint64_t hashData(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Writes an archive holding the given files, in order, so the id of each asset is its
+     * position in sources.
+     * @param path Archive to write.
+     * @param sources Files to pack.
+     * @param error Receives a description of the failure.
+     * @return False if a file could not be read or the archive could not be written.
+     */
+    static bool pack(const std::string& path, const std::vector<Source>& sources, std::string& error);
+
+private:
+    /**
+     * @struct Entry
+     * @brief Index entry of an asset.
+     */
+    struct Entry
+    {
+        std::string name;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t hash;
+    };
+
+    const uint8_t* m_data = nullptr;    // Start of the mapping
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;             // File and mapping handles
+    void* m_mapping = nullptr;
+#endif
+
+    std::vector<Entry> m_entries;                       // Indexed by id
+    std::unordered_map<std::string, uint32_t> m_ids;    // Ids by name
+
+    /**
+     * @brief Parses the header and index of the mapped file.
+     */
+    bool readIndex();
+};
@@ -0,0 +1,29 @@
+#include "assetmanifest.h"
+
+const AssetInfo ASSET_MANIFEST[] =
+{
+    // Textures
+    { "background.png", AssetType::TEXTURE },
+    { "increase_size.png", AssetType::TEXTURE },
+    { "decrease_size.png", AssetType::TEXTURE },
+    { "speed_up.png", AssetType::TEXTURE },
+    { "slow_down.png", AssetType::TEXTURE },
+
+    // Fonts
+    { "ARIAL.TTF", AssetType::FONT },
+
+    // Sound effects
+    { "paddle_hit.wav", AssetType::SOUND },
+    { "powerup.mp3", AssetType::SOUND },
+
+    // Music
+    { "title_screen.mp3", AssetType::MUSIC },
+    { "ready_screen.mp3", AssetType::MUSIC },
+    { "level_1.mp3", AssetType::MUSIC },
+    { "level_2.mp3", AssetType::MUSIC },
+    { "level_3.mp3", AssetType::MUSIC },
+    { "level_4.mp3", AssetType::MUSIC },
+    { "game_over.mp3", AssetType::MUSIC },
+};
+
+const size_t ASSET_COUNT = sizeof(ASSET_MANIFEST) / sizeof(ASSET_MANIFEST[0]);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum AssetType
+ * @brief How an asset is decoded once its file is read.
+ */
+enum class AssetType : uint8_t
+{
+    TEXTURE,    ///< PNG, decoded by graphics::preloadBitmaps.
+    FONT,       ///< TrueType font, loaded by graphics::setFont.
+    SOUND,      ///< Sound effect, decoded into SGG's sample cache.
+    MUSIC       ///< Music track, streamed by SGG while it plays.
+};
+
+/**
+ * @struct AssetInfo
+ * @brief An entry of the asset manifest.
+ */
+struct AssetInfo
+{
+    const char* name;   ///< File name in the asset directory.
+    AssetType type;
+};
+
+/**
+ * @brief Every asset the game uses, loaded at startup by AssetRegistry::preload().
+ */
+extern const AssetInfo ASSET_MANIFEST[];
+
+/**
+ * @brief Number of entries in ASSET_MANIFEST.
+ */
+extern const size_t ASSET_COUNT;
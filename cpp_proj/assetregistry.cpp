@@ -0,0 +1,157 @@
+#include "assetregistry.h"
+#include "gamestate.h"
+#include "threadpool.h"
+#include "logger.h"
+#include "sgg/graphics.h"
+#include <chrono>
+#include <fstream>
+
+/**
+ * @brief Retrieves the singleton instance.
+ *
+ * @return The registry.
+ */
+AssetRegistry& AssetRegistry::getInstance()
+{
+    static AssetRegistry instance;
+    return instance;
+}
+
+AssetRegistry::AssetRegistry()
+    : m_texture_paths(1) // NO_TEXTURE maps to the empty path
+{
+}
+
+/**
+ * @brief Retrieves the handle of a texture, resolving its full path on first use.
+ *
+ * @param asset File name in the asset directory, e.g. "background.png".
+ * @return The handle, or NO_TEXTURE for an empty name.
+ */
+TextureHandle AssetRegistry::getTexture(const std::string& asset)
+{
+    if (asset.empty())
+        return NO_TEXTURE;
+
+    auto it = m_textures.find(asset);
+    if (it != m_textures.end())
+        return it->second;
+
+    TextureHandle handle = static_cast<TextureHandle>(m_texture_paths.size());
+    m_texture_paths.push_back(GameState::getInstance()->getFullAssetPath(asset));
+    m_textures.emplace(asset, handle);
+    return handle;
+}
+
+/**
+ * @brief Loads every asset of the manifest.
+ *
+ * The asset archive is mapped if there is one. The files are read in parallel on a thread pool,
+ * which brings them into the OS cache and measures them; assets that only ship in the archive are
+ * read from the mapping instead. SGG decodes on the thread that owns the window, so the decoding then runs here:
+ * graphics::preloadBitmaps decodes every texture of the asset directory in one call, fonts are
+ * loaded with setFont, and sound effects are played once at zero volume to enter SGG's sample
+ * cache. Music is streamed while it plays, so reading it is all that can be done ahead.
+ *
+ * @return True if every asset was found.
+ */
+bool AssetRegistry::preload()
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    std::string directory = GameState::getInstance()->getAssetDir();
+
+    if (m_archive.open(ASSET_ARCHIVE))
+        LOG_INFO("Mapped asset archive {} ({} assets).", ASSET_ARCHIVE, m_archive.getCount());
+
+    m_report.assign(ASSET_COUNT, AssetLoad());
+    {
+        ThreadPool pool;
+        pool.parallelFor(ASSET_COUNT, [&](size_t i)
+        {
+            AssetLoad& load = m_report[i];
+            load.asset = &ASSET_MANIFEST[i];
+
+            Clock::time_point begin = Clock::now();
+            std::ifstream file(directory + load.asset->name, std::ios::binary);
+            if (file)
+            {
+                std::vector<char> buffer(64 * 1024);
+                while (file.read(buffer.data(), buffer.size()) || file.gcount() > 0)
+                {
+                    load.bytes += static_cast<size_t>(file.gcount());
+                }
+                load.found = true;
+            }
+            else
+            {
+                // Only in the archive: checking the hash pages the asset in
+                uint32_t id = m_archive.find(load.asset->name);
+                load.found = m_archive.verify(id);
+                load.bytes = m_archive.getData(id).size;
+            }
+            load.read_time = std::chrono::duration<float, std::milli>(Clock::now() - begin).count();
+        });
+    }
+
+    // Textures are decoded together; their time is shared evenly in the report
+    Clock::time_point begin = Clock::now();
+    size_t bitmaps = graphics::preloadBitmaps(directory).size();
+    float bitmap_time = std::chrono::duration<float, std::milli>(Clock::now() - begin).count();
+
+    size_t textures = 0;
+    for (const AssetLoad& load : m_report)
+    {
+        if (load.asset->type == AssetType::TEXTURE)
+            textures++;
+    }
+
+    bool complete = true;
+    for (AssetLoad& load : m_report)
+    {
+        const AssetInfo& asset = *load.asset;
+        if (!load.found)
+        {
+            LOG_WARNING("Asset {} not found.", asset.name);
+            complete = false;
+            continue;
+        }
+
+        begin = Clock::now();
+        switch (asset.type)
+        {
+        case AssetType::TEXTURE:
+            getTexture(asset.name);
+            load.decode_time = bitmap_time / static_cast<float>(textures);
+            break;
+        case AssetType::FONT:
+            graphics::setFont(directory + asset.name);
+            break;
+        case AssetType::SOUND:
+            graphics::playSound(directory + asset.name, 0.0f, false);
+            break;
+        case AssetType::MUSIC:
+            break;
+        }
+        if (asset.type != AssetType::TEXTURE)
+            load.decode_time = std::chrono::duration<float, std::milli>(Clock::now() - begin).count();
+
+        LOG_INFO("Loaded {} ({} bytes): read {} ms, decode {} ms.", asset.name, load.bytes, load.read_time,
+            load.decode_time);
+    }
+
+    float total = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    LOG_INFO("Preloaded {} assets ({} bitmaps) in {} ms.", ASSET_COUNT, bitmaps, total);
+    return complete;
+}
+
+/**
+ * @brief Retrieves the bytes of an asset from the mapped archive, without copying.
+ *
+ * @param asset File name in the asset directory.
+ * @return The span, empty if no archive is mapped or it does not hold the asset.
+ */
+AssetSpan AssetRegistry::getData(const std::string& asset) const
+{
+    return m_archive.getData(asset);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "assetarchive.h"
+#include "assetmanifest.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Integer handle of a texture registered in the AssetRegistry.
+ */
+typedef uint32_t TextureHandle;
+
+/**
+ * @brief Handle meaning "no texture".
+ */
+const TextureHandle NO_TEXTURE = 0;
+
+/**
+ * @brief Archive of packed assets, next to the executable. Built by the asset_pack tool.
+ */
+const char* const ASSET_ARCHIVE = "assets.pak";
+
+/**
+ * @class AssetRegistry
+ * @brief Resolves asset names to full paths once and hands out integer handles for them, so draw
+ * code refers to textures without building path strings every frame.
+ *
+ * preload() loads everything in ASSET_MANIFEST before the game loop starts, so no asset is read
+ * or decoded on the first frame that uses it. It also maps ASSET_ARCHIVE when present; SGG loads
+ * textures, fonts and audio by file name only, so those still come from the loose files, while
+ * data the game parses itself is served from the mapping by getData().
+ */
+class AssetRegistry
+{
+public:
+    /**
+     * @struct AssetLoad
+     * @brief How long an asset of the manifest took to load.
+     */
+    struct AssetLoad
+    {
+        const AssetInfo* asset = nullptr;
+        size_t bytes = 0;           ///< File size.
+        float read_time = 0.0f;     ///< Time to read the file on a worker, in ms.
+        float decode_time = 0.0f;   ///< Time to decode it on the main thread, in ms.
+        bool found = false;
+    };
+
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static AssetRegistry& getInstance();
+
+    /**
+     * @brief Reads every manifest asset in parallel, then decodes them on the calling thread and
+     * registers the textures. Call once, after the window exists and before the message loop.
+     * @return True if every asset was found.
+     */
+    bool preload();
+
+    /**
+     * @brief Retrieves the load times of the manifest assets, in manifest order.
+     */
+    const std::vector<AssetLoad>& getLoadReport() const { return m_report; }
+
+    /**
+     * @brief Retrieves the bytes of an asset from the mapped archive, without copying.
+     * @return The span, empty if no archive is mapped or it does not hold the asset.
+     */
+    AssetSpan getData(const std::string& asset) const;
+
+    /**
+     * @brief Retrieves the handle of a texture, resolving its path on first use.
+     * @param asset File name in the asset directory, e.g. "background.png".
+     * @return The handle, or NO_TEXTURE for an empty name.
+     */
+    TextureHandle getTexture(const std::string& asset);
+
+    /**
+     * @brief Retrieves the full path of a texture.
+     * @return The path, or an empty string for NO_TEXTURE.
+     */
+    const std::string& getTexturePath(TextureHandle texture) const { return m_texture_paths[texture]; }
+
+private:
+    AssetRegistry();
+    AssetRegistry(const AssetRegistry&) = delete;
+    AssetRegistry& operator=(const AssetRegistry&) = delete;
+
+    std::vector<std::string> m_texture_paths;                   // Indexed by handle
+    std::unordered_map<std::string, TextureHandle> m_textures;  // Handles by asset name
+    std::vector<AssetLoad> m_report;                            // Filled by preload()
+    AssetArchive m_archive;                                     // Mapped by preload()
+};
@@ -0,0 +1,126 @@
+#include "audiobank.h"
+#include "gamestate.h"
+#include "sgg/graphics.h"
+#include <utility>
+
+namespace
+{
+    /**
+     * @struct SoundInfo
+     * @brief File and playback settings of a sound effect.
+     */
+    struct SoundInfo
+    {
+        const char* asset;
+        float volume;
+        float length;       // Time a voice stays busy, in ms
+        float retrigger;    // Minimum time between two starts of the sound, in ms
+    };
+
+    // Indexed by SoundId
+    const SoundInfo SOUNDS[static_cast<size_t>(SoundId::COUNT)] =
+    {
+        { "paddle_hit.wav", 0.6f, 150.0f, 20.0f },
+        { "powerup.mp3", 0.6f, 600.0f, 50.0f },
+    };
+}
+
+/**
+ * @brief Retrieves the singleton instance.
+ *
+ * @return The audio bank.
+ */
+AudioBank& AudioBank::getInstance()
+{
+    static AudioBank instance;
+    return instance;
+}
+
+/**
+ * @brief Resolves the path of every sound effect and fills the stocks of path strings. The samples
+ * themselves were decoded by AssetRegistry::preload(). Does nothing if already initialised.
+ */
+void AudioBank::init()
+{
+    if (m_loaded)
+        return;
+
+    for (size_t i = 0; i < static_cast<size_t>(SoundId::COUNT); i++)
+    {
+        m_paths[i] = GameState::getInstance()->getFullAssetPath(SOUNDS[i].asset);
+        m_stocks[i].reserve(STOCK_SIZE);
+    }
+    m_loaded = true;
+    restock();
+}
+
+/**
+ * @brief Builds the path strings the next plays will use, up to STOCK_SIZE per effect.
+ *
+ * Each play moves a string out of its stock, so the copy SGG receives costs no allocation. A level
+ * plays far fewer effects than a stock holds; one that ran out falls back to copying the path,
+ * counted in Stats::copied.
+ */
+void AudioBank::restock()
+{
+    if (!m_loaded)
+        return;
+
+    for (size_t i = 0; i < static_cast<size_t>(SoundId::COUNT); i++)
+    {
+        while (m_stocks[i].size() < STOCK_SIZE)
+            m_stocks[i].push_back(m_paths[i]);
+    }
+}
+
+/**
+ * @brief Plays a sound effect on a free voice. The play is dropped if every voice is busy, or if
+ * the same sound is still in its retrigger window.
+ *
+ * @param sound The effect to play.
+ */
+void AudioBank::play(SoundId sound)
+{
+    size_t index = static_cast<size_t>(sound);
+    if (!m_loaded || index >= static_cast<size_t>(SoundId::COUNT))
+        return;
+
+    const SoundInfo& info = SOUNDS[index];
+    float now = graphics::getGlobalTime();
+
+    Voice* target = nullptr;
+    for (Voice& voice : m_voices)
+    {
+        if (voice.sound != SoundId::COUNT && now >= voice.end)
+            voice.sound = SoundId::COUNT;
+
+        if (voice.sound == sound && now - voice.start < info.retrigger)
+        {
+            m_stats.dropped++;
+            return;
+        }
+        if (voice.sound == SoundId::COUNT && !target)
+            target = &voice;
+    }
+
+    if (!target)
+    {
+        m_stats.busy++;
+        return;
+    }
+
+    target->sound = sound;
+    target->start = now;
+    target->end = now + info.length;
+    m_stats.played++;
+
+    std::vector<std::string>& stock = m_stocks[index];
+    if (stock.empty())
+    {
+        m_stats.copied++;
+        graphics::playSound(m_paths[index], info.volume, false);
+        return;
+    }
+    graphics::playSound(std::move(stock.back()), info.volume, false);
+    stock.pop_back();
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @enum SoundId
+ * @brief Integer identifiers of the sound effects loaded by the AudioBank.
+ */
+enum class SoundId : uint8_t
+{
+    PADDLE_HIT,     ///< Ball hits a paddle or an obstacle.
+    POWERUP,        ///< Ball collects a powerup.
+    COUNT
+};
+
+/**
+ * @class AudioBank
+ * @brief Plays the sound effects by SoundId through a fixed voice pool.
+ *
+ * SGG keeps a sample in memory once it has played it, and AssetRegistry::preload() warms every
+ * effect with a silent play at startup; init() only resolves each path once, so no hit reads the
+ * disk. SGG takes the path by value, so a play that passed the resolved path would copy it to the
+ * heap. Instead each effect keeps a stock of path strings built ahead of time, and a play moves
+ * one into SGG. restock() refills the stocks while no level is played.
+ *
+ * SGG cannot stop a single sample, so a voice is only known to be free once its sound has had
+ * time to finish. A play that finds every voice busy is dropped, which caps the effects mixed at
+ * once, and a sound retriggered within a few milliseconds of its last start is dropped instead of
+ * doubling up.
+ */
+class AudioBank
+{
+public:
+    static const size_t MAX_VOICES = 8;     ///< Effects that may be mixed at once.
+
+    /**
+     * @struct Stats
+     * @brief Counts of the voice pool since init().
+     */
+    struct Stats
+    {
+        size_t played = 0;      ///< Effects started.
+        size_t busy = 0;        ///< Effects dropped because every voice was busy.
+        size_t dropped = 0;     ///< Retriggers dropped because the same sound had just started.
+        size_t copied = 0;      ///< Effects played with a copied path because their stock ran out.
+    };
+
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static AudioBank& getInstance();
+
+    /**
+     * @brief Resolves the path of every sound effect. Called once by GameState::init.
+     */
+    void init();
+
+    /**
+     * @brief Builds the path strings the next plays will use, up to a full stock per effect. May
+     * allocate, so it is called between levels.
+     */
+    void restock();
+
+    /**
+     * @brief Plays a sound effect on a free voice, if there is one.
+     * @param sound The effect to play.
+     */
+    void play(SoundId sound);
+
+    /**
+     * @brief Retrieves the counts of the voice pool.
+     */
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    AudioBank() {}
+    AudioBank(const AudioBank&) = delete;
+    AudioBank& operator=(const AudioBank&) = delete;
+
+    /**
+     * @struct Voice
+     * @brief An effect in flight.
+     */
+    struct Voice
+    {
+        SoundId sound = SoundId::COUNT;     // COUNT when free
+        float start = 0.0f;                 // Global time it started, in ms
+        float end = 0.0f;                   // Global time it is over, in ms
+    };
+
+    static const size_t STOCK_SIZE = 256;   ///< Plays of an effect covered by one restock().
+
+    std::string m_paths[static_cast<size_t>(SoundId::COUNT)];   // Full paths, resolved by init()
+    std::vector<std::string> m_stocks[static_cast<size_t>(SoundId::COUNT)];  // Paths moved into SGG
+    Voice m_voices[MAX_VOICES];
+    Stats m_stats;
+    bool m_loaded = false;
+};
@@ -1,62 +1,29 @@
 #pragma once
-#include "GameObject.h"
-#include <random>
-#include <vector>
-#include "timer.h"
-#include "powerup.h"
+#include "gameobject.h"
+#include "brushcache.h"
 
 /**
  * @class Ball
- * @brief Represents the ball in the Pong game.
+ * @brief Represents the ball in the Pong game. Its movement is computed by the Simulation;
+ * this object holds the mirrored state used for drawing.
  */
 class Ball : public GameObject
 {
 private:
-    Timer m_reset_timer;      // Timer for delay after scoring.
-    float m_target_speed_x;   // Target speed on the x-axis after delay.
-    float m_target_speed_y;   // Target speed on the y-axis after delay.
     float m_speed;            // Constant base speed of the ball.
     float m_speed_x;          // Current speed on the x-axis.
     float m_speed_y;          // Current speed on the y-axis.
-	float m_base_width;	      // Base width of the ball.
-	float m_base_height;	  // Base height of the ball.
+    bool m_is_ramping_up = false;     // Whether the ball is accelerating after a serve.
+    bool m_is_powerup_active = false; // Whether a powerup effect is applied to the ball.
 
-    // Struct holding active powerup effects
-    struct ActivePowerup {
-        Powerup::Type type;
-        Timer effect_timer;
-    };
-    std::vector<ActivePowerup> m_active_powerups;
-
-    bool m_is_powerup_active = false;
+    BrushHandle m_brush;            // White ball.
+    BrushHandle m_ramp_brush;       // Red disk while ramping up.
+    BrushHandle m_powerup_brush;    // Yellow overlay while a powerup is active.
 
 public:
-    Ball(GameState* gs, const std::string& name,
-        float speed, float width, float height);
-
-    void init() override;
-    void update(float dt) override;
-    void draw() override;
-
-    /**
-     * @brief Resets the ball to the center with a new random direction.
-     */
-    void reset();
+    Ball(GameState* gs, const std::string& name, float width, float height);
 
-    /**
-     * @brief Applies a powerup effect to the ball immediately.
-     */
-    void applyPowerup(Powerup::Type type);
-
-    /**
-     * @brief Updates active powerup effects.
-     */
-    void updatePowerups();
-
-    /**
-     * @brief Clears all active powerups from the ball.
-     */
-    void clearActivePowerups();
+    void draw(DrawList& list) override;
 
     /**
      * @brief Getter for the ball's current speed on the x-axis.
@@ -92,11 +59,21 @@ public:
      * @brief Checks if the ball is currently ramping up its speed.
      * @return True if ramping up, False otherwise.
      */
-    bool isRampingUp() { return m_reset_timer.isRunning(); }
+    bool isRampingUp() const { return m_is_ramping_up; }
+
+    /**
+     * @brief Sets whether the ball is ramping up its speed.
+     */
+    void setRampingUp(bool ramping_up) { m_is_ramping_up = ramping_up; }
 
     /**
      * @brief Checks if the ball has an active powerup
      * @return True if there is an active powerup, False otherwise.
      */
     bool isActivePowerup() const { return m_is_powerup_active; }
+
+    /**
+     * @brief Sets whether the ball has an active powerup.
+     */
+    void setActivePowerup(bool active) { m_is_powerup_active = active; }
 };
@@ -50,6 +50,87 @@ struct Box
             return std::min<float>(0.0f, other.m_pos_x - (other.m_width / 2.0f) - m_pos_x - (m_width / 2.0f));
     }
 
+    /** Computes the time of impact of this Box moving by (dx, dy) against a static target box (other).
+    *
+    *   The test is done on the Minkowski sum of both boxes, so a fast box cannot pass through a thin
+    *   one between two discrete positions. Touching boxes count as colliding only when this Box moves
+    *   towards the other one.
+    *
+    *   \param other is the static Box to test against.
+    *   \param dx is the movement of this Box on the x axis.
+    *   \param dy is the movement of this Box on the y axis.
+    *   \param normal_x receives the x component of the contact normal (-1, 0 or 1), pointing towards this Box.
+    *   \param normal_y receives the y component of the contact normal (-1, 0 or 1), pointing towards this Box.
+    *   \return the fraction of the movement in [0, 1] at which the boxes first touch, or a value greater
+    *   than 1 if they do not touch during the movement. If the boxes already overlap, 0 is returned and
+    *   the normal points along the axis of least penetration.
+    */
+    float sweep(const Box& other, float dx, float dy, float& normal_x, float& normal_y) const
+    {
+        const float no_hit = 2.0f;
+        float rel_x = m_pos_x - other.m_pos_x;
+        float rel_y = m_pos_y - other.m_pos_y;
+        float half_w = (m_width + other.m_width) / 2.0f;
+        float half_h = (m_height + other.m_height) / 2.0f;
+        normal_x = 0.0f;
+        normal_y = 0.0f;
+
+        // Already overlapping: push out along the axis of least penetration
+        float pen_x = half_w - fabs(rel_x);
+        float pen_y = half_h - fabs(rel_y);
+        if (pen_x > 0.0f && pen_y > 0.0f)
+        {
+            if (pen_x <= pen_y)
+                normal_x = (rel_x != 0.0f) ? (rel_x > 0.0f ? 1.0f : -1.0f) : (dx > 0.0f ? -1.0f : 1.0f);
+            else
+                normal_y = (rel_y != 0.0f) ? (rel_y > 0.0f ? 1.0f : -1.0f) : (dy > 0.0f ? -1.0f : 1.0f);
+            return 0.0f;
+        }
+
+        // Entry and exit times of each axis' slab
+        float enter_x, exit_x, enter_y, exit_y;
+        if (dx == 0.0f)
+        {
+            if (fabs(rel_x) >= half_w)
+                return no_hit;
+            enter_x = -INFINITY;
+            exit_x = INFINITY;
+        }
+        else
+        {
+            float t1 = (-half_w - rel_x) / dx;
+            float t2 = (half_w - rel_x) / dx;
+            enter_x = std::min(t1, t2);
+            exit_x = std::max(t1, t2);
+        }
+
+        if (dy == 0.0f)
+        {
+            if (fabs(rel_y) >= half_h)
+                return no_hit;
+            enter_y = -INFINITY;
+            exit_y = INFINITY;
+        }
+        else
+        {
+            float t1 = (-half_h - rel_y) / dy;
+            float t2 = (half_h - rel_y) / dy;
+            enter_y = std::min(t1, t2);
+            exit_y = std::max(t1, t2);
+        }
+
+        float enter = std::max(enter_x, enter_y);
+        float exit = std::min(exit_x, exit_y);
+        if (enter >= exit || enter < 0.0f || enter > 1.0f)
+            return no_hit;
+
+        if (enter_x > enter_y)
+            normal_x = (dx > 0.0f) ? -1.0f : 1.0f;
+        else
+            normal_y = (dy > 0.0f) ? -1.0f : 1.0f;
+        return enter;
+    }
+
     /** Default ctor
     */
     Box() {}
@@ -0,0 +1,54 @@
+#include "brushcache.h"
+#include <cstring>
+
+/**
+ * @brief Compares every attribute of two styles.
+ */
+bool BrushStyle::operator==(const BrushStyle& other) const
+{
+    return texture == other.texture &&
+        std::memcmp(fill_color, other.fill_color, sizeof(fill_color)) == 0 &&
+        fill_opacity == other.fill_opacity &&
+        std::memcmp(outline_color, other.outline_color, sizeof(outline_color)) == 0 &&
+        outline_opacity == other.outline_opacity &&
+        outline_width == other.outline_width;
+}
+
+/**
+ * @brief Retrieves the singleton instance.
+ *
+ * @return The cache.
+ */
+BrushCache& BrushCache::getInstance()
+{
+    static BrushCache instance;
+    return instance;
+}
+
+/**
+ * @brief Retrieves the handle of a brush, creating the brush on first use. Meant for load time:
+ * the lookup is a linear search over the few brushes of the game.
+ *
+ * @param style Attributes of the brush.
+ * @return The handle.
+ */
+BrushHandle BrushCache::getHandle(const BrushStyle& style)
+{
+    for (size_t i = 0; i < m_styles.size(); i++)
+    {
+        if (m_styles[i] == style)
+            return static_cast<BrushHandle>(i);
+    }
+
+    graphics::Brush brush;
+    std::memcpy(brush.fill_color, style.fill_color, sizeof(brush.fill_color));
+    brush.fill_opacity = style.fill_opacity;
+    std::memcpy(brush.outline_color, style.outline_color, sizeof(brush.outline_color));
+    brush.outline_opacity = style.outline_opacity;
+    brush.outline_width = style.outline_width;
+    brush.texture = AssetRegistry::getInstance().getTexturePath(style.texture);
+
+    m_styles.push_back(style);
+    m_brushes.push_back(brush);
+    return static_cast<BrushHandle>(m_styles.size() - 1);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "assetregistry.h"
+#include "sgg/graphics.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Integer handle of a brush in the BrushCache.
+ */
+typedef uint32_t BrushHandle;
+
+/**
+ * @struct BrushStyle
+ * @brief The brush attributes the game uses, with the texture as a handle. Defaults match
+ * graphics::Brush.
+ */
+struct BrushStyle
+{
+    TextureHandle texture = NO_TEXTURE;
+    float fill_color[3] = { 1.0f, 1.0f, 1.0f };
+    float fill_opacity = 1.0f;
+    float outline_color[3] = { 1.0f, 1.0f, 1.0f };
+    float outline_opacity = 1.0f;
+    float outline_width = 1.0f;
+
+    BrushStyle() {}
+    BrushStyle(float r, float g, float b, float opacity = 1.0f)
+    {
+        fill_color[0] = r;
+        fill_color[1] = g;
+        fill_color[2] = b;
+        fill_opacity = opacity;
+    }
+
+    bool operator==(const BrushStyle& other) const;
+};
+
+/**
+ * @class BrushCache
+ * @brief Builds each distinct brush once and hands out integer handles for it. Draw code resolves
+ * its brushes at load time and records draws by handle, with no per-frame string work.
+ *
+ * Handles stay valid for the lifetime of the program.
+ */
+class BrushCache
+{
+public:
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static BrushCache& getInstance();
+
+    /**
+     * @brief Retrieves the handle of a brush, creating the brush on first use.
+     */
+    BrushHandle getHandle(const BrushStyle& style);
+
+    /**
+     * @brief Retrieves the SGG brush of a handle.
+     */
+    const graphics::Brush& getBrush(BrushHandle brush) const { return m_brushes[brush]; }
+
+    /**
+     * @brief Retrieves the texture of a brush.
+     */
+    TextureHandle getTexture(BrushHandle brush) const { return m_styles[brush].texture; }
+
+private:
+    BrushCache() {}
+    BrushCache(const BrushCache&) = delete;
+    BrushCache& operator=(const BrushCache&) = delete;
+
+    std::vector<BrushStyle> m_styles;           // Indexed by handle
+    std::vector<graphics::Brush> m_brushes;     // Indexed by handle
+};
@@ -7,4 +7,10 @@ const float CANVAS_HEIGHT = 900.0f;
 
 // Alternatively, define in pixels if needed
 const int WINDOW_WIDTH = 900;
-const int WINDOW_HEIGHT = 900;
\ No newline at end of file
+const int WINDOW_HEIGHT = 900;
+
+// Fixed simulation rate of the gameplay engine, in ticks per second
+const float SIM_TICK_RATE = 240.0f;
+
+// Default cell size of the uniform broadphase grid over the canvas, in game units
+const float GRID_CELL_SIZE = 100.0f;
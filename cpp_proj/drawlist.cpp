@@ -0,0 +1,208 @@
+#include "drawlist.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstring>
+
+// Buffer sizes reserved up front, above what a frame of the game records
+static const size_t RESERVED_COMMANDS = 256;
+static const size_t RESERVED_TEXT = 1024;
+static const size_t RESERVED_LINE = 128;
+
+/**
+ * @brief Reserves the buffers of both frames, so the first frames of a level do not grow them.
+ */
+DrawList::DrawList()
+{
+    for (Frame& frame : m_frames)
+    {
+        frame.commands.reserve(RESERVED_COMMANDS);
+        frame.order.reserve(RESERVED_COMMANDS);
+        frame.text.reserve(RESERVED_TEXT);
+    }
+    m_text.reserve(RESERVED_LINE);
+}
+
+/**
+ * @brief Empties the frame, keeping the capacity of its buffers.
+ */
+void DrawList::Frame::clear()
+{
+    commands.clear();
+    order.clear();
+    text.clear();
+    stats = Stats();
+}
+
+/**
+ * @brief Starts recording a new frame.
+ */
+void DrawList::begin()
+{
+    m_recording->clear();
+}
+
+/**
+ * @brief Sorts the recorded frame and makes it the one submit() draws.
+ *
+ * Within a layer commands are ordered by font, texture and brush; commands with the same state
+ * keep their recording order.
+ */
+void DrawList::end()
+{
+    Frame& frame = *m_recording;
+
+    frame.order.resize(frame.commands.size());
+    for (size_t i = 0; i < frame.order.size(); i++)
+    {
+        frame.order[i] = static_cast<uint32_t>(i);
+    }
+
+    const std::vector<Command>& commands = frame.commands;
+    const BrushCache& brushes = BrushCache::getInstance();
+    const FontManager& fonts = FontManager::getInstance();
+    std::sort(frame.order.begin(), frame.order.end(), [&](uint32_t a, uint32_t b)
+    {
+        const Command& ca = commands[a];
+        const Command& cb = commands[b];
+        if (ca.layer != cb.layer)
+            return ca.layer < cb.layer;
+        if (ca.font != cb.font)
+        {
+            // Group text by font file first: sizes of the same font need no switch
+            if (ca.font == NO_FONT || cb.font == NO_FONT)
+                return ca.font < cb.font;
+            if (fonts.getFile(ca.font) != fonts.getFile(cb.font))
+                return fonts.getFile(ca.font) < fonts.getFile(cb.font);
+            return ca.font < cb.font;
+        }
+        TextureHandle ta = brushes.getTexture(ca.brush);
+        TextureHandle tb = brushes.getTexture(cb.brush);
+        if (ta != tb)
+            return ta < tb;
+        if (ca.brush != cb.brush)
+            return ca.brush < cb.brush;
+        return a < b;
+    });
+
+    frame.stats.commands = commands.size();
+    uint32_t previous = UINT32_MAX;
+    for (uint32_t index : frame.order)
+    {
+        if (commands[index].brush != previous)
+            frame.stats.brush_changes++;
+        previous = commands[index].brush;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::swap(m_recording, m_submitted);
+}
+
+/**
+ * @brief Draws the last ended frame in sorted order.
+ */
+void DrawList::submit() const
+{
+    PROFILE_ZONE("DrawList::submit");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Frame& frame = *m_submitted;
+    const BrushCache& brushes = BrushCache::getInstance();
+    const FontManager& fonts = FontManager::getInstance();
+
+    graphics::resetPose();
+    for (uint32_t index : frame.order)
+    {
+        const Command& command = frame.commands[index];
+        const graphics::Brush& brush = brushes.getBrush(command.brush);
+        switch (command.type)
+        {
+        case CommandType::RECT:
+            graphics::drawRect(command.x, command.y, command.width, command.height, brush);
+            break;
+        case CommandType::DISK:
+            graphics::drawDisk(command.x, command.y, command.width, brush);
+            break;
+        case CommandType::TEXT:
+            if (m_active_font == NO_FONT || fonts.getFile(command.font) != fonts.getFile(m_active_font))
+                graphics::setFont(fonts.getPath(command.font));
+            m_active_font = command.font;
+            m_text.assign(frame.text, command.text_offset, command.text_length);
+            graphics::drawText(command.x, command.y, fonts.getSize(command.font), m_text, brush);
+            break;
+        }
+    }
+}
+
+void DrawList::addCommand(CommandType type, DrawLayer layer, float x, float y, float width, float height,
+    BrushHandle brush)
+{
+    Command command;
+    command.type = type;
+    command.layer = layer;
+    command.font = NO_FONT;
+    command.brush = brush;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.text_offset = 0;
+    command.text_length = 0;
+    m_recording->commands.push_back(command);
+}
+
+/**
+ * @brief Records a rectangle.
+ */
+void DrawList::drawRect(DrawLayer layer, float center_x, float center_y, float width, float height,
+    BrushHandle brush)
+{
+    addCommand(CommandType::RECT, layer, center_x, center_y, width, height, brush);
+}
+
+/**
+ * @brief Records a disk.
+ */
+void DrawList::drawDisk(DrawLayer layer, float center_x, float center_y, float radius, BrushHandle brush)
+{
+    addCommand(CommandType::DISK, layer, center_x, center_y, radius, radius, brush);
+}
+
+void DrawList::addText(DrawLayer layer, float x, float y, FontHandle font, const char* text, size_t length,
+    BrushHandle brush)
+{
+    addCommand(CommandType::TEXT, layer, x, y, 0.0f, 0.0f, brush);
+
+    Command& command = m_recording->commands.back();
+    command.font = font;
+    command.text_offset = static_cast<uint32_t>(m_recording->text.size());
+    command.text_length = static_cast<uint32_t>(length);
+    m_recording->text.append(text, length);
+}
+
+/**
+ * @brief Records a line of text in a font style. The text is copied into the frame.
+ */
+void DrawList::drawText(DrawLayer layer, float pos_x, float pos_y, FontHandle font, const std::string& text,
+    BrushHandle brush)
+{
+    addText(layer, pos_x, pos_y, font, text.data(), text.size(), brush);
+}
+
+/**
+ * @brief Records a line of text in a font style, without building a std::string.
+ */
+void DrawList::drawText(DrawLayer layer, float pos_x, float pos_y, FontHandle font, const char* text, BrushHandle brush)
+{
+    addText(layer, pos_x, pos_y, font, text, std::strlen(text), brush);
+}
+
+/**
+ * @brief Retrieves the counts of the last ended frame.
+ *
+ * @return The counts.
+ */
+DrawList::Stats DrawList::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_submitted->stats;
+}
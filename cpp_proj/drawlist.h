@@ -0,0 +1,116 @@
+#pragma once
+
+#include "brushcache.h"
+#include "fontmanager.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @enum DrawLayer
+ * @brief Layers of a frame, drawn back to front. Commands are only reordered within a layer.
+ */
+enum class DrawLayer : uint8_t
+{
+    BACKGROUND,     ///< Full-screen backgrounds.
+    WORLD,          ///< Paddles, ball, obstacles and powerups.
+    OVERLAY,        ///< Indicators drawn over the world objects.
+    HUD             ///< Text.
+};
+
+/**
+ * @class DrawList
+ * @brief Command buffer for the draw calls of a frame.
+ *
+ * Draw code records rectangles, disks and text instead of calling SGG directly. Brushes are
+ * referenced by their BrushCache handle, and end() sorts the commands of each layer by font,
+ * texture and brush, so submit() switches state as rarely as possible. Text is drawn in a
+ * FontManager style, and submit() only calls setFont when the font file changes. All buffers are reused
+ * from frame to frame, so recording does not allocate once they have grown.
+ *
+ * Recording and submitting use separate frames: the game records between begin() and end() (on
+ * the update callback), and submit() draws the last ended frame (on the draw callback), possibly
+ * from another thread.
+ */
+class DrawList
+{
+public:
+    /**
+     * @struct Stats
+     * @brief Counts of the last ended frame.
+     */
+    struct Stats
+    {
+        size_t commands = 0;        ///< Recorded draw commands.
+        size_t brush_changes = 0;   ///< Brush switches while submitting, in sorted order.
+    };
+
+    /**
+     * @brief Reserves the buffers of both frames for a typical frame.
+     */
+    DrawList();
+
+    /**
+     * @brief Starts recording a new frame.
+     */
+    void begin();
+
+    /**
+     * @brief Sorts the recorded frame and makes it the one submit() draws.
+     */
+    void end();
+
+    /**
+     * @brief Draws the last ended frame.
+     */
+    void submit() const;
+
+    void drawRect(DrawLayer layer, float center_x, float center_y, float width, float height, BrushHandle brush);
+    void drawDisk(DrawLayer layer, float center_x, float center_y, float radius, BrushHandle brush);
+    void drawText(DrawLayer layer, float pos_x, float pos_y, FontHandle font, const std::string& text, BrushHandle brush);
+    void drawText(DrawLayer layer, float pos_x, float pos_y, FontHandle font, const char* text, BrushHandle brush);
+
+    /**
+     * @brief Retrieves the counts of the last ended frame.
+     */
+    Stats getStats() const;
+
+private:
+    enum class CommandType : uint8_t { RECT, DISK, TEXT };
+
+    struct Command
+    {
+        CommandType type;
+        DrawLayer layer;
+        FontHandle font;        // Font style of text, NO_FONT for shapes
+        BrushHandle brush;
+        float x, y, width, height;
+        uint32_t text_offset;   // Text in Frame::text
+        uint32_t text_length;
+    };
+
+    /**
+     * @struct Frame
+     * @brief The commands of one frame and the data they refer to.
+     */
+    struct Frame
+    {
+        std::vector<Command> commands;
+        std::vector<uint32_t> order;            // Command indices in submission order
+        std::string text;
+        Stats stats;
+
+        void clear();
+    };
+
+    Frame m_frames[2];
+    Frame* m_recording = &m_frames[0];
+    Frame* m_submitted = &m_frames[1];
+    mutable std::string m_text;                 // Text of the command being submitted
+    mutable FontHandle m_active_font = NO_FONT; // Font style last set in SGG
+    mutable std::mutex m_mutex;                 // Guards the swap of the frames against submit()
+
+    void addCommand(CommandType type, DrawLayer layer, float x, float y, float width, float height, BrushHandle brush);
+    void addText(DrawLayer layer, float x, float y, FontHandle font, const char* text, size_t length, BrushHandle brush);
+};
@@ -0,0 +1,346 @@
+#include "entitystore.h"
+#include "spatialgrid.h"
+
+// Generations wrap around within the bits above the slot number
+static const uint32_t GENERATION_MASK = (1u << (32 - ENTITY_SLOT_BITS)) - 1;
+
+/**
+ * @brief Assigns a handle to an entity appended at the end of the store, reusing a free slot if
+ * there is one.
+ *
+ * @return The handle of the entity.
+ */
+EntityHandle EntitySlots::add()
+{
+    uint32_t slot;
+    if (!free_slots.empty())
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(index.size());
+        index.push_back(0);
+        generation.push_back(0);
+    }
+
+    index[slot] = static_cast<uint32_t>(handle.size());
+    EntityHandle entity = slot | (generation[slot] << ENTITY_SLOT_BITS);
+    handle.push_back(entity);
+    return entity;
+}
+
+/**
+ * @brief Frees the handle of the entity at an index and moves the last handle into its place.
+ *
+ * @param entity_index Index of the removed entity.
+ */
+void EntitySlots::swapRemove(size_t entity_index)
+{
+    uint32_t slot = getEntitySlot(handle[entity_index]);
+    generation[slot] = (generation[slot] + 1) & GENERATION_MASK;
+    free_slots.push_back(slot);
+
+    EntityHandle last = handle.back();
+    handle[entity_index] = last;
+    index[getEntitySlot(last)] = static_cast<uint32_t>(entity_index);
+    handle.pop_back();
+}
+
+/**
+ * @brief Retrieves the index of the entity a handle refers to.
+ *
+ * @param entity Handle of the entity.
+ * @return The index, or -1 if the handle is stale or invalid.
+ */
+int EntitySlots::find(EntityHandle entity) const
+{
+    uint32_t slot = getEntitySlot(entity);
+    if (slot >= index.size() || index[slot] >= handle.size() || handle[index[slot]] != entity)
+        return -1;
+    return static_cast<int>(index[slot]);
+}
+
+/**
+ * @brief Frees every handle. Slots keep their generation, so handles of the previous entities
+ * stay stale.
+ */
+void EntitySlots::clear()
+{
+    handle.clear();
+    free_slots.clear();
+    for (uint32_t slot = static_cast<uint32_t>(index.size()); slot > 0; slot--)
+    {
+        generation[slot - 1] = (generation[slot - 1] + 1) & GENERATION_MASK;
+        free_slots.push_back(slot - 1);
+    }
+}
+
+/**
+ * @brief Makes room for a number of handles.
+ *
+ * @param count Number of entities.
+ */
+void EntitySlots::reserve(size_t count)
+{
+    handle.reserve(count);
+    index.reserve(count);
+    generation.reserve(count);
+    free_slots.reserve(count);
+}
+
+/**
+ * @brief Adds an active obstacle at the end of every array.
+ *
+ * @param obstacle_type Breakable or Unbreakable.
+ * @param pos_x Center x coordinate.
+ * @param pos_y Center y coordinate.
+ * @param obstacle_width Width of the obstacle.
+ * @param obstacle_height Height of the obstacle.
+ * @param obstacle_hit_points Hits a breakable obstacle takes before it breaks.
+ * @param obstacle_speed Vertical speed in units per ms; the obstacle starts moving down.
+ * @return The handle of the new obstacle.
+ */
+EntityHandle ObstacleStore::add(Obstacle::Type obstacle_type, float pos_x, float pos_y, float obstacle_width,
+    float obstacle_height, int obstacle_hit_points, float obstacle_speed)
+{
+    x.push_back(pos_x);
+    y.push_back(pos_y);
+    width.push_back(obstacle_width);
+    height.push_back(obstacle_height);
+    speed.push_back(obstacle_speed);
+    direction.push_back(1.0f);
+    hit_points.push_back(obstacle_hit_points);
+    type.push_back(obstacle_type);
+    active.push_back(1);
+    return slots.add();
+}
+
+/**
+ * @brief Deactivates an obstacle and counts it for the next compaction.
+ *
+ * @param index Index of the obstacle.
+ */
+void ObstacleStore::remove(size_t index)
+{
+    active[index] = 0;
+    counts.pending++;
+}
+
+/**
+ * @brief Removes an obstacle by moving the last obstacle into its place. Only the handle of the
+ * removed obstacle becomes stale.
+ *
+ * @param index Index of the obstacle.
+ */
+void ObstacleStore::swapRemove(size_t index)
+{
+    if (!active[index])
+        counts.pending--;
+    counts.removed++;
+
+    x[index] = x.back();
+    y[index] = y.back();
+    width[index] = width.back();
+    height[index] = height.back();
+    speed[index] = speed.back();
+    direction[index] = direction.back();
+    hit_points[index] = hit_points.back();
+    type[index] = type.back();
+    active[index] = active.back();
+    slots.swapRemove(index);
+
+    x.pop_back();
+    y.pop_back();
+    width.pop_back();
+    height.pop_back();
+    speed.pop_back();
+    direction.pop_back();
+    hit_points.pop_back();
+    type.pop_back();
+    active.pop_back();
+}
+
+/**
+ * @brief Removes all obstacles. The arrays keep their capacity for the next level.
+ */
+void ObstacleStore::clear()
+{
+    x.clear();
+    y.clear();
+    width.clear();
+    height.clear();
+    speed.clear();
+    direction.clear();
+    hit_points.clear();
+    type.clear();
+    active.clear();
+    slots.clear();
+    counts = EntityCounts();
+}
+
+/**
+ * @brief Makes room for a number of obstacles in every array.
+ *
+ * @param count Number of obstacles.
+ */
+void ObstacleStore::reserve(size_t count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    width.reserve(count);
+    height.reserve(count);
+    speed.reserve(count);
+    direction.reserve(count);
+    hit_points.reserve(count);
+    type.reserve(count);
+    active.reserve(count);
+    slots.reserve(count);
+}
+
+/**
+ * @brief Adds an active powerup at the end of every array.
+ *
+ * @param powerup_type The effect of the powerup.
+ * @param pos_x Center x coordinate.
+ * @param pos_y Center y coordinate.
+ * @param powerup_width Width of the powerup.
+ * @param powerup_height Height of the powerup.
+ * @return The handle of the new powerup.
+ */
+EntityHandle PowerupStore::add(Powerup::Type powerup_type, float pos_x, float pos_y, float powerup_width, float powerup_height)
+{
+    x.push_back(pos_x);
+    y.push_back(pos_y);
+    width.push_back(powerup_width);
+    height.push_back(powerup_height);
+    type.push_back(powerup_type);
+    active.push_back(1);
+    return slots.add();
+}
+
+/**
+ * @brief Deactivates a powerup and counts it for the next compaction.
+ *
+ * @param index Index of the powerup.
+ */
+void PowerupStore::remove(size_t index)
+{
+    active[index] = 0;
+    counts.pending++;
+}
+
+/**
+ * @brief Removes a powerup by moving the last powerup into its place. Only the handle of the
+ * removed powerup becomes stale.
+ *
+ * @param index Index of the powerup.
+ */
+void PowerupStore::swapRemove(size_t index)
+{
+    if (!active[index])
+        counts.pending--;
+    counts.removed++;
+
+    x[index] = x.back();
+    y[index] = y.back();
+    width[index] = width.back();
+    height[index] = height.back();
+    type[index] = type.back();
+    active[index] = active.back();
+    slots.swapRemove(index);
+
+    x.pop_back();
+    y.pop_back();
+    width.pop_back();
+    height.pop_back();
+    type.pop_back();
+    active.pop_back();
+}
+
+/**
+ * @brief Removes all powerups. The arrays keep their capacity for the next level.
+ */
+void PowerupStore::clear()
+{
+    x.clear();
+    y.clear();
+    width.clear();
+    height.clear();
+    type.clear();
+    active.clear();
+    slots.clear();
+    counts = EntityCounts();
+}
+
+/**
+ * @brief Makes room for a number of powerups in every array.
+ *
+ * @param count Number of powerups.
+ */
+void PowerupStore::reserve(size_t count)
+{
+    x.reserve(count);
+    y.reserve(count);
+    width.reserve(count);
+    height.reserve(count);
+    type.reserve(count);
+    active.reserve(count);
+    slots.reserve(count);
+}
+
+/**
+ * @brief Removes the deactivated objects of a store, moving the last object into the place of
+ * each. The grid entry of a moved object follows it to its new index.
+ *
+ * @param store Obstacle or powerup store.
+ * @param grid Grid of the store's active objects, keyed by index.
+ */
+template <typename Store>
+static void compactObjects(Store& store, SpatialGrid& grid)
+{
+    if (store.counts.pending == 0)
+        return;
+
+    for (size_t i = 0; i < store.size() && store.counts.pending > 0;)
+    {
+        if (store.active[i])
+        {
+            i++;
+            continue;
+        }
+
+        // Deactivated objects already left the grid; the last object takes over index i. It may
+        // have been deactivated this tick too, in which case it stays out of the grid and the next
+        // pass removes it from index i.
+        uint32_t last = static_cast<uint32_t>(store.size() - 1);
+        store.swapRemove(i);
+        grid.remove(last);
+        if (i != last && store.active[i])
+            grid.insert(static_cast<uint32_t>(i), Box(store.x[i], store.y[i], store.width[i], store.height[i]));
+    }
+    store.counts.compactions++;
+}
+
+/**
+ * @brief Removes the obstacles deactivated since the last compaction.
+ *
+ * @param store The obstacles.
+ * @param grid Grid of the active obstacles, keyed by index.
+ */
+void compactStore(ObstacleStore& store, SpatialGrid& grid)
+{
+    compactObjects(store, grid);
+}
+
+/**
+ * @brief Removes the powerups deactivated since the last compaction.
+ *
+ * @param store The powerups.
+ * @param grid Grid of the active powerups, keyed by index.
+ */
+void compactStore(PowerupStore& store, SpatialGrid& grid)
+{
+    compactObjects(store, grid);
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "obstacle.h"
+#include "powerup.h"
+
+class SpatialGrid;
+
+/**
+ * @brief Handle of an obstacle or powerup in its store: a slot number in the low ENTITY_SLOT_BITS
+ * bits and the generation of the slot above them. Handles stay valid while compaction moves their
+ * entity to another index, and stop resolving once the entity is removed.
+ */
+using EntityHandle = uint32_t;
+
+const uint32_t ENTITY_SLOT_BITS = 20;
+const EntityHandle NO_ENTITY = UINT32_MAX;
+
+/**
+ * @brief Retrieves the slot number of a handle, unique among the live entities of a store.
+ */
+inline uint32_t getEntitySlot(EntityHandle handle) { return handle & ((1u << ENTITY_SLOT_BITS) - 1); }
+
+/**
+ * @struct EntitySlots
+ * @brief Handle table of a store, mapping handles to the current index of their entity.
+ *
+ * Each slot records the index of its entity and a generation. Removing an entity bumps the
+ * generation of its slot, so its old handles no longer resolve, and puts the slot on a free list
+ * for the next entity.
+ */
+struct EntitySlots
+{
+    std::vector<EntityHandle> handle;       ///< Handle of the entity at each index.
+    std::vector<uint32_t> index;            ///< Index of the entity of each slot.
+    std::vector<uint32_t> generation;       ///< Current generation of each slot.
+    std::vector<uint32_t> free_slots;       ///< Slots without an entity.
+
+    /**
+     * @brief Assigns a handle to an entity appended at the end of the store.
+     */
+    EntityHandle add();
+
+    /**
+     * @brief Frees the handle of the entity at an index, and moves the handle of the last entity
+     * to that index, as the store does with the entity itself.
+     */
+    void swapRemove(size_t entity_index);
+
+    /**
+     * @brief Retrieves the index of the entity a handle refers to.
+     * @return The index, or -1 if the entity was removed.
+     */
+    int find(EntityHandle entity) const;
+
+    void clear();
+    void reserve(size_t count);
+};
+
+/**
+ * @struct EntityCounts
+ * @brief Removal counts of a store, for telemetry.
+ */
+struct EntityCounts
+{
+    size_t pending = 0;                     ///< Entities deactivated since the last compaction.
+    size_t removed = 0;                     ///< Entities removed by compaction since the store was cleared.
+    size_t compactions = 0;                 ///< Compactions that removed at least one entity.
+};
+
+/**
+ * @struct ObstacleStore
+ * @brief Structure-of-arrays storage of all obstacles of a level.
+ *
+ * Every property lives in its own packed array, indexed the same way, so the movement and
+ * collision passes stream through exactly the fields they need. A broken obstacle is only
+ * deactivated; the next compaction removes it by moving the last obstacle into its place, so the
+ * arrays hold no dead obstacles between ticks. Handles keep referring to the same obstacle across
+ * these moves.
+ */
+struct ObstacleStore
+{
+    std::vector<float> x;               ///< Center x coordinates.
+    std::vector<float> y;               ///< Center y coordinates.
+    std::vector<float> width;
+    std::vector<float> height;
+    std::vector<float> speed;           ///< Vertical speed in units per ms (0 for stationary obstacles).
+    std::vector<float> direction;       ///< 1 for down, -1 for up.
+    std::vector<int> hit_points;        ///< Remaining hits for breakable obstacles.
+    std::vector<Obstacle::Type> type;
+    std::vector<uint8_t> active;        ///< 1 while the obstacle is on the field.
+    EntitySlots slots;                  ///< Handles of the obstacles.
+    EntityCounts counts;
+
+    /**
+     * @brief Adds an active obstacle.
+     * @return The handle of the new obstacle.
+     */
+    EntityHandle add(Obstacle::Type obstacle_type, float pos_x, float pos_y, float obstacle_width,
+        float obstacle_height, int obstacle_hit_points, float obstacle_speed);
+
+    /**
+     * @brief Deactivates an obstacle. It stays at its index until the next compaction.
+     */
+    void remove(size_t index);
+
+    /**
+     * @brief Removes an obstacle at once, moving the last obstacle to its index.
+     */
+    void swapRemove(size_t index);
+
+    /**
+     * @brief Retrieves the index of an obstacle.
+     * @return The index, or -1 if the obstacle was removed.
+     */
+    int find(EntityHandle obstacle) const { return slots.find(obstacle); }
+
+    /**
+     * @brief Removes all obstacles, invalidating their handles.
+     */
+    void clear();
+
+    /**
+     * @brief Makes room for a number of obstacles, so adding them does not allocate.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Number of obstacles, including those deactivated since the last compaction.
+     */
+    size_t size() const { return x.size(); }
+};
+
+/**
+ * @struct PowerupStore
+ * @brief Structure-of-arrays storage of all powerups of a level. Collected powerups are
+ * deactivated and removed by the next compaction, like broken obstacles.
+ */
+struct PowerupStore
+{
+    std::vector<float> x;               ///< Center x coordinates.
+    std::vector<float> y;               ///< Center y coordinates.
+    std::vector<float> width;
+    std::vector<float> height;
+    std::vector<Powerup::Type> type;
+    std::vector<uint8_t> active;        ///< 1 while the powerup waits to be collected.
+    EntitySlots slots;                  ///< Handles of the powerups.
+    EntityCounts counts;
+
+    /**
+     * @brief Adds an active powerup.
+     * @return The handle of the new powerup.
+     */
+    EntityHandle add(Powerup::Type powerup_type, float pos_x, float pos_y, float powerup_width, float powerup_height);
+
+    /**
+     * @brief Deactivates a powerup. It stays at its index until the next compaction.
+     */
+    void remove(size_t index);
+
+    /**
+     * @brief Removes a powerup at once, moving the last powerup to its index.
+     */
+    void swapRemove(size_t index);
+
+    /**
+     * @brief Retrieves the index of a powerup.
+     * @return The index, or -1 if the powerup was removed.
+     */
+    int find(EntityHandle powerup) const { return slots.find(powerup); }
+
+    /**
+     * @brief Removes all powerups, invalidating their handles.
+     */
+    void clear();
+
+    /**
+     * @brief Makes room for a number of powerups, so adding them does not allocate.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Number of powerups, including those collected since the last compaction.
+     */
+    size_t size() const { return x.size(); }
+};
+
+/**
+ * @brief Removes the obstacles deactivated since the last compaction, moving the last obstacle into
+ * the place of each. Deactivated obstacles must already have left the grid; the grid entry of a
+ * moved obstacle follows it to its new index.
+ *
+ * @param store The obstacles.
+ * @param grid Grid of the active obstacles, keyed by store index.
+ */
+void compactStore(ObstacleStore& store, SpatialGrid& grid);
+
+/**
+ * @brief Removes the powerups deactivated since the last compaction, like the obstacle version.
+ */
+void compactStore(PowerupStore& store, SpatialGrid& grid);
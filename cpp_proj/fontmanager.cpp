@@ -0,0 +1,60 @@
+#include "fontmanager.h"
+#include "gamestate.h"
+#include "logger.h"
+#include "sgg/graphics.h"
+
+/**
+ * @brief Retrieves the singleton instance.
+ *
+ * @return The font manager.
+ */
+FontManager& FontManager::getInstance()
+{
+    static FontManager instance;
+    return instance;
+}
+
+/**
+ * @brief Registers the GameFont styles, in the order of the enum, and loads their fonts.
+ * Does nothing if already initialised.
+ */
+void FontManager::init()
+{
+    if (!m_styles.empty())
+        return;
+
+    addFont("ARIAL.TTF", 60.0f);    // GameFont::TITLE
+    addFont("ARIAL.TTF", 50.0f);    // GameFont::HEADING
+    addFont("ARIAL.TTF", 30.0f);    // GameFont::BODY
+    addFont("ARIAL.TTF", 20.0f);    // GameFont::HUD
+}
+
+/**
+ * @brief Registers a font style. The path is resolved once, and the font file is loaded when the
+ * first style using it is registered.
+ *
+ * @param asset Font file in the asset directory.
+ * @param size Font size of the style.
+ * @return The handle of the style.
+ */
+FontHandle FontManager::addFont(const std::string& asset, float size)
+{
+    std::string path = GameState::getInstance()->getFullAssetPath(asset);
+
+    size_t file = 0;
+    while (file < m_files.size() && m_files[file] != path)
+        file++;
+    if (file == m_files.size())
+    {
+        // SGG keeps every font it has loaded, so later switches do not read the file again
+        if (!graphics::setFont(path))
+            LOG_WARNING("Failed to load font {}.", path);
+        m_files.push_back(path);
+    }
+
+    Style style;
+    style.file = file;
+    style.size = size;
+    m_styles.push_back(style);
+    return static_cast<FontHandle>(m_styles.size() - 1);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Integer handle of a font style (file and size) registered in the FontManager.
+ */
+typedef int32_t FontHandle;
+
+/**
+ * @brief Handle meaning "keep the font SGG currently uses".
+ */
+const FontHandle NO_FONT = -1;
+
+/**
+ * @enum GameFont
+ * @brief The font styles of the game, registered by FontManager::init() in this order.
+ */
+enum class GameFont : FontHandle
+{
+    TITLE,      ///< Menu title.
+    HEADING,    ///< Large messages ("Ready?", "Game Over", the winner).
+    BODY,       ///< Menu entries and game over details.
+    HUD         ///< Scores and timer during gameplay.
+};
+
+/**
+ * @class FontManager
+ * @brief Loads the game's fonts once and hands out handles for font styles, so draw code picks a
+ * font and size without building paths or touching the filesystem every frame.
+ *
+ * A style is a font file and a size. Styles sharing a file share the font loaded by SGG.
+ */
+class FontManager
+{
+public:
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static FontManager& getInstance();
+
+    /**
+     * @brief Registers the GameFont styles and loads their fonts. Called once by GameState::init,
+     * after the window exists.
+     */
+    void init();
+
+    /**
+     * @brief Registers a font style, resolving the path of the font file once.
+     * @param asset Font file in the asset directory.
+     * @param size Font size of the style.
+     * @return The handle of the style.
+     */
+    FontHandle addFont(const std::string& asset, float size);
+
+    /**
+     * @brief Retrieves the handle of a GameFont style.
+     */
+    static FontHandle getFont(GameFont font) { return static_cast<FontHandle>(font); }
+
+    /**
+     * @brief Retrieves the full path of the font file of a style.
+     */
+    const std::string& getPath(FontHandle font) const { return m_files[m_styles[font].file]; }
+
+    /**
+     * @brief Retrieves the size of a style.
+     */
+    float getSize(FontHandle font) const { return m_styles[font].size; }
+
+    /**
+     * @brief Retrieves the index of the font file of a style. Styles with the same index use the
+     * same loaded font.
+     */
+    size_t getFile(FontHandle font) const { return m_styles[font].file; }
+
+private:
+    FontManager() {}
+    FontManager(const FontManager&) = delete;
+    FontManager& operator=(const FontManager&) = delete;
+
+    /**
+     * @struct Style
+     * @brief A font file and size.
+     */
+    struct Style
+    {
+        size_t file;    // Index in m_files
+        float size;
+    };
+
+    std::vector<std::string> m_files;   // Full paths of the loaded fonts
+    std::vector<Style> m_styles;        // Indexed by handle
+};
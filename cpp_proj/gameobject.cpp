@@ -1,5 +1,5 @@
-#include "GameObject.h"
-#include "GameState.h"
+#include "gameobject.h"
+#include "gamestate.h"
 
 // Initialize static member
 int GameObject::m_next_id = 1;
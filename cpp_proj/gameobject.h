@@ -1,8 +1,9 @@
 #pragma once
 #include <string>
 
-// Forward declaration to avoid circular dependencies
+// Forward declarations to avoid circular dependencies
 class GameState;
+class DrawList;
 
 /**
  * @class GameObject
@@ -47,9 +48,10 @@ public:
     virtual void init() {}
 
     /**
-     * @brief Draws the object on the screen.
+     * @brief Records the draw commands of the object.
+     * @param list Draw list of the frame.
      */
-    virtual void draw() {}
+    virtual void draw(DrawList& list) {}
 
     /**
      * @brief Checks if the object is active.
@@ -1,8 +1,16 @@
-﻿#include "GameState.h"
+﻿#include "gamestate.h"
 #include "sgg/graphics.h"
-#include <iostream>
+#include "logger.h"
+#include "profiler.h"
+#include "assetregistry.h"
+#include "fontmanager.h"
+#include "audiobank.h"
+#include "musicmanager.h"
+#include "alloccounter.h"
 #include <chrono>
 #include <thread>
+#include <fstream>
+#include <iterator>
 
 // Initialize the static member to nullptr
 GameState* GameState::m_unique_instance = nullptr;
@@ -43,7 +51,7 @@ GameState* GameState::getInstance()
     if (m_unique_instance == nullptr)
     {
         m_unique_instance = new GameState();
-        std::cout << "GameState instance created.\n";
+        LOG_DEBUG("GameState instance created.");
     }
     return m_unique_instance;
 }
@@ -60,7 +68,7 @@ void GameState::releaseInstance()
     {
         delete m_unique_instance;
         m_unique_instance = nullptr;
-        std::cout << "GameState instance released.\n";
+        LOG_DEBUG("GameState instance released.");
     }
 }
 
@@ -91,6 +99,43 @@ std::string GameState::getAssetDir()
     return m_asset_path;
 }
 
+/**
+ * @brief Reads the level definitions.
+ *
+ * A loose level text file wins, so designers see their edits without rebuilding anything; a
+ * shipped game reads the compiled levels from the asset archive instead. If neither is available
+ * or valid, the built-in levels are used.
+ */
+void GameState::loadLevels()
+{
+    std::string error;
+    std::ifstream file(getFullAssetPath(LEVELS_TEXT_ASSET), std::ios::binary);
+    if (file)
+    {
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (m_levels.parse(text.data(), text.size(), error))
+        {
+            LOG_INFO("Loaded {} levels from {}.", m_levels.getLevels().size(), LEVELS_TEXT_ASSET);
+            return;
+        }
+        LOG_ERROR("Invalid level file {}: {}", LEVELS_TEXT_ASSET, error);
+    }
+
+    AssetSpan compiled = AssetRegistry::getInstance().getData(LEVELS_BINARY_ASSET);
+    if (!compiled.empty())
+    {
+        if (m_levels.load(compiled.data, compiled.size, error))
+        {
+            LOG_INFO("Loaded {} levels from {}.", m_levels.getLevels().size(), ASSET_ARCHIVE);
+            return;
+        }
+        LOG_ERROR("Invalid compiled levels in {}: {}", ASSET_ARCHIVE, error);
+    }
+
+    m_levels = LevelSet::getDefault();
+    LOG_WARNING("Using the built-in levels.");
+}
+
 /**
  * @brief Initializes the game state, including levels and sounds.
  *
@@ -100,54 +145,132 @@ std::string GameState::getAssetDir()
  */
 void GameState::init()
 {
+    // Read and decode every asset up front, so no frame waits for the disk
+    AssetRegistry::getInstance().preload();
+    loadLevels();
+
+    // Register the font styles; menus and HUDs only pick styles from here on
+    FontManager::getInstance().init();
+
+    // Sound effects and music are played by id
+    AudioBank::getInstance().init();
+    MusicManager::getInstance().init();
+
     // Initialize Level
     level = std::make_unique<Level>();
     level->init(1, true); // Start with Level 1 and display the main menu
 
-    std::cout << "GameState initialized. Level 1 is set.\n";
+    // Record the recent frames; F12 writes them out (see update)
+    Profiler::getInstance().setEnabled(true);
+
+    LOG_INFO("GameState initialized. Level 1 is set.");
 }
 
 /**
- * @brief Updates all active game objects.
+ * @brief Updates all active game objects and records the draw commands of the frame.
  *
  * Handles the game logic by updating the current level and managing timing to ensure smooth
  * gameplay. This method is typically called once per frame with the elapsed time since the last update.
+ * The level then records its draw commands, which draw() submits.
  *
  * @param dt Delta time since the last update in seconds.
  */
 void GameState::update(float dt)
 {
+    PROFILE_FRAME();
+    PROFILE_ZONE("GameState::update");
+
     // Skip an update if a long delay is detected to prevent simulation issues
     if (dt > 500) // ms
     {
-        std::cout << "Skipped update due to excessive delta time: " << dt << " ms.\n";
+        LOG_WARNING("Skipped update due to excessive delta time: {} ms.", dt);
         return;
     }
 
     if (!level)
     {
-        std::cout << "No active level to update.\n";
+        LOG_WARNING("No active level to update.");
         return;
     }
 
-    // Update the current level
+    // Follow the music toggle, then update the current level and record what it looks like now
+    bool was_playing = level->isPlaying();
+    uint64_t allocations = AllocCounter::getThreadAllocations();
+
+    MusicManager::getInstance().update();
     level->update(dt);
+
+    m_draw_list.begin();
+    level->draw(m_draw_list);
+    m_draw_list.end();
+
+    countFrameAllocations(was_playing, AllocCounter::getThreadAllocations() - allocations);
+
+    // F12: export the recent frames for chrome://tracing
+    bool profile_key = graphics::getKeyState(graphics::SCANCODE_F12);
+    if (profile_key && !m_profile_key_down)
+    {
+        const char* path = "profile.json";
+        if (Profiler::getInstance().exportChromeTrace(path))
+            LOG_INFO("Profile of the last {} frames written to {}.", Profiler::getInstance().getFrameCount(), path);
+        else
+            LOG_WARNING("Failed to write the profile to {}.", path);
+    }
+    m_profile_key_down = profile_key;
 }
 
 /**
- * @brief Draws all game objects and the level background.
+ * @brief Adds the heap allocations of a frame to the gameplay count of the current level.
  *
- * Delegates the rendering process to the current level, which handles drawing all active
- * game objects, such as players, the ball, obstacles, powerups, and background elements.
+ * Only frames that start and end in gameplay count, as loading a level or opening a menu may
+ * allocate. When gameplay stops the count is logged, which shows whether a level, Sudden Death
+ * included, ran without any heap traffic.
+ *
+ * @param was_playing True if the level was in gameplay when the frame started.
+ * @param allocations Heap allocations made during the frame.
+ */
+void GameState::countFrameAllocations(bool was_playing, uint64_t allocations)
+{
+    if (!AllocCounter::isEnabled())
+        return;
+
+    if (was_playing && level->isPlaying())
+    {
+        m_play_frames++;
+        m_play_allocations += allocations;
+        m_total_play_allocations += allocations;
+        return;
+    }
+
+    if (m_play_frames > 0)
+    {
+        if (m_play_allocations > 0)
+            LOG_WARNING("Level {}: {} heap allocations in {} gameplay frames.", m_play_level, m_play_allocations, m_play_frames);
+        else
+            LOG_INFO("Level {}: no heap allocations in {} gameplay frames.", m_play_level, m_play_frames);
+    }
+    m_play_frames = 0;
+    m_play_allocations = 0;
+    m_play_level = level->getLevelNumber();
+}
+
+/**
+ * @brief Draws the frame recorded by the last update.
+ *
+ * Submits the draw commands the current level recorded, which cover all active game objects,
+ * such as players, the ball, obstacles, powerups, and background elements. The commands arrive
+ * sorted by texture and brush, so SGG switches state as rarely as possible.
  */
 void GameState::draw() const
 {
+    PROFILE_ZONE("GameState::draw");
+
     if (level)
     {
-        level->draw();
+        m_draw_list.submit();
     }
     else
     {
-        std::cout << "No active level to draw.\n";
+        LOG_WARNING("No active level to draw.");
     }
 }
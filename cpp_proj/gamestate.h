@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
-#include "Level.h"
+#include "level.h"
 #include "config.h"
 #include "menu.h"
+#include "drawlist.h"
+#include "leveldef.h"
 
 /**
  * @class GameState
@@ -16,12 +18,40 @@ private:
     // Singleton instance
     static GameState* m_unique_instance;
 
-    // Asset directory path
-    std::string m_asset_path = "assets\\";
+    // Asset directory path; forward slashes work on Windows and Linux alike
+    std::string m_asset_path = "assets/";
+
+    // Level definitions, read by loadLevels()
+    LevelSet m_levels;
 
     // Unique pointer to the current Level and menu
     std::unique_ptr<Level> level;
 
+    // Draw commands recorded by update() and submitted by draw()
+    DrawList m_draw_list;
+
+    // Previous state of the profile export key (F12)
+    bool m_profile_key_down = false;
+
+    // Heap allocations of the gameplay frames of the current level, counted by update()
+    uint64_t m_play_frames = 0;
+    uint64_t m_play_allocations = 0;
+    int m_play_level = 0;
+    uint64_t m_total_play_allocations = 0;  // Over every level played
+
+    /**
+     * @brief Reads the level definitions, falling back to the built-in levels.
+     */
+    void loadLevels();
+
+    /**
+     * @brief Adds the heap allocations of a frame to the gameplay count, and reports the count
+     * when gameplay stops.
+     * @param was_playing True if the level was in gameplay when the frame started.
+     * @param allocations Heap allocations made during the frame.
+     */
+    void countFrameAllocations(bool was_playing, uint64_t allocations);
+
     /**
      * @brief Private constructor to prevent external instantiation.
      */
@@ -70,6 +100,17 @@ public:
      */
     std::string getAssetDir();
 
+    /**
+     * @brief Retrieves the heap allocations of all gameplay frames so far. Always 0 when the
+     * allocation counter is compiled out.
+     */
+    uint64_t getGameplayAllocations() const { return m_total_play_allocations; }
+
+    /**
+     * @brief Retrieves the level definitions read at startup.
+     */
+    const LevelSet& getLevels() const { return m_levels; }
+
 	/**
 	* @brief Retrieves the current level.
 	* @return Pointer to the current Level.
@@ -106,13 +147,13 @@ public:
     void init();
 
     /**
-     * @brief Updates all active game objects.
+     * @brief Updates all active game objects and records the draw commands of the frame.
      * @param dt Delta time since the last update.
      */
     void update(float dt);
 
     /**
-     * @brief Draws all game objects and the level background.
+     * @brief Draws the frame recorded by the last update.
      */
     void draw() const;
 
@@ -0,0 +1,67 @@
+#include "hud.h"
+#include "drawlist.h"
+#include <cstdio>
+
+/**
+ * @brief Adds a line of text.
+ *
+ * @param x Left edge of the text.
+ * @param y Baseline of the text.
+ * @param font Font style.
+ * @param brush Brush of the text.
+ * @param text Initial text, a format without values.
+ * @return The index of the line, for setText().
+ */
+size_t Hud::addText(float x, float y, FontHandle font, BrushHandle brush, const char* text)
+{
+    Line line;
+    line.x = x;
+    line.y = y;
+    line.font = font;
+    line.brush = brush;
+    line.visible = true;
+    line.format = nullptr;
+    m_lines.push_back(line);
+
+    size_t index = m_lines.size() - 1;
+    setText(index, text);
+    return index;
+}
+
+/**
+ * @brief Sets the text of a line from a printf format with up to two integers. The line is only
+ * reformatted if the format or a value differs from the last call; formats are compared by
+ * address, so they should be string literals.
+ *
+ * @param index Index of the line.
+ * @param format printf format using at most two int values.
+ * @param a First value.
+ * @param b Second value.
+ * @return True if the text was reformatted.
+ */
+bool Hud::setText(size_t index, const char* format, int a, int b)
+{
+    Line& line = m_lines[index];
+    if (line.format == format && line.values[0] == a && line.values[1] == b)
+        return false;
+
+    line.format = format;
+    line.values[0] = a;
+    line.values[1] = b;
+    std::snprintf(line.text, TEXT_SIZE, format, a, b);
+    return true;
+}
+
+/**
+ * @brief Records the visible lines into a draw list, on the HUD layer.
+ *
+ * @param list Draw list of the frame.
+ */
+void Hud::draw(DrawList& list) const
+{
+    for (const Line& line : m_lines)
+    {
+        if (line.visible)
+            list.drawText(DrawLayer::HUD, line.x, line.y, line.font, line.text, line.brush);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "brushcache.h"
+#include "fontmanager.h"
+#include <cstddef>
+#include <vector>
+
+class DrawList;
+
+/**
+ * @class Hud
+ * @brief Text overlay of a screen: a set of text lines kept formatted in fixed buffers.
+ *
+ * Each line remembers the format and the values it was last formatted with, and setText()
+ * reformats it only when they change. Drawing records the buffers as they are, so a HUD whose
+ * values did not change costs no formatting and no allocation.
+ */
+class Hud
+{
+public:
+    static const size_t TEXT_SIZE = 64;     ///< Capacity of a line, including the terminator.
+
+    /**
+     * @brief Adds a line of text.
+     * @param x Left edge of the text.
+     * @param y Baseline of the text.
+     * @param font Font style.
+     * @param brush Brush of the text.
+     * @param text Initial text, a format without values.
+     * @return The index of the line, for setText().
+     */
+    size_t addText(float x, float y, FontHandle font, BrushHandle brush, const char* text = "");
+
+    /**
+     * @brief Sets the text of a line from a printf format with up to two integers. The line is only
+     * reformatted if the format or a value differs from the last call.
+     * @return True if the text was reformatted.
+     */
+    bool setText(size_t index, const char* format, int a = 0, int b = 0);
+
+    /**
+     * @brief Sets the brush of a line.
+     */
+    void setBrush(size_t index, BrushHandle brush) { m_lines[index].brush = brush; }
+
+    /**
+     * @brief Shows or hides a line.
+     */
+    void setVisible(size_t index, bool visible) { m_lines[index].visible = visible; }
+
+    /**
+     * @brief Removes all lines.
+     */
+    void clear() { m_lines.clear(); }
+
+    /**
+     * @brief Records the visible lines into a draw list.
+     */
+    void draw(DrawList& list) const;
+
+private:
+    /**
+     * @struct Line
+     * @brief A line of text with the inputs it was formatted from.
+     */
+    struct Line
+    {
+        float x, y;
+        FontHandle font;
+        BrushHandle brush;
+        bool visible;
+        const char* format;     // Format of the current text (string literal)
+        int values[2];          // Values of the current text
+        char text[TEXT_SIZE];
+    };
+
+    std::vector<Line> m_lines;
+};
@@ -1,146 +1,84 @@
-﻿#include "Level.h"
-#include "GameState.h"
+﻿#include "level.h"
+#include "gamestate.h"
 #include "sgg/graphics.h"
-#include <iostream>
-#include <cmath>
-#include <random>
+#include "logger.h"
+#include "drawlist.h"
+#include "profiler.h"
+#include "audiobank.h"
+#include "musicmanager.h"
 
 /**
  * @brief Destructor for the Level class.
  *
- * Responsible for cleaning up resources used by the Level. Since unique pointers are utilized
- * for managing game objects, memory deallocation is handled automatically.
+ * Responsible for cleaning up resources used by the Level. The players and the ball live in
+ * object pools and the menu in a unique pointer, so they are released automatically.
  */
 Level::~Level()
 {
-    // Unique pointers automatically handle memory deallocation.
+    // The pools and unique pointers release the game objects.
 }
 
 /**
  * @brief Initializes the level by setting up all necessary game objects and configurations.
  *
- * This method configures the level based on the provided level number. It initializes spawning variables,
- * sets up background music and sound effects, and prepares the game menu if required.
+ * This method configures the level based on the provided level number. It loads the level into the
+ * simulation, prepares the game menu if required, and crossfades to the music of the new state.
  *
- * @param level_number The level number to initialize (1-4).
+ * @param level_number The level number to initialize.
  * @param show_menu A boolean flag indicating whether to display the menu upon initialization.
  */
 void Level::init(int level_number, bool show_menu)
 {
-    // Stop any currently playing music before reinitializing
-    if (m_background_music) { m_background_music->stop(); }
-
     // Set the current level number
     m_level_number = level_number;
-    //m_level_number = 4;
-    // Debug: Sudden death mode initialization
-
-    // Initialize powerup spawning variables
-    m_elapsed_time = 0.0f;
-    m_next_powerup_spawn_time = 5.0f; // Start spawning after 5 seconds
-    m_powerups_spawned = 0;
-
-    // Initialize obstacle spawning variables (Sudden Death)
-	m_next_obstacle_spawn_time_level4 = 7.5f;
-
-    // Initialize speed multiplier
-    m_speed_multiplier = 1.0f;
-
-    // Define powerup spawn positions based on level
-    if (level_number == 2)
-    {
-        m_powerup_spawn_positions = { {300.0f, 300.0f}, {600.0f, 300.0f}, {400.0f, 500.0f}, {500.0f, 200.0f} };
-        m_total_powerups_to_spawn = 4; // Total powerups for Level 2
-    }
-    else if (level_number == 3)
-    {
-        m_powerup_spawn_positions = { {500.0f, 500.0f}, {700.0f, 200.0f}, {200.0f, 600.0f}, {400.0f, 400.0f} };
-        m_total_powerups_to_spawn = 4; // Total powerups for Level 3
-    }
-    else
-    {
-        // Reset spawn counters (Spawned Obstacles counter for Level 4)
-        m_unbreakable_obstacles_spawned_level4 = 0;
-        m_breakable_obstacles_spawned_level4 = 0;
-        m_powerups_spawned_level4 = 0;
-
-        // Reset player score in sudden death (First to 10 wins)
-        m_player1_score = 0;
-        m_player2_score = 0;
-    }
-
-    // Reset the level timer to 30 seconds
-    m_level_timer = 300.0f;
-
-    // Clear existing obstacles and powerups
-    m_obstacles.clear();
-    m_powerups.clear();
 
     // Setup game objects specific to the current level
     setupLevelObjects(m_level_number);
 
-    // Setup the background brush
-    m_bg_brush.texture = GameState::getInstance()->getFullAssetPath("background.png");
-    m_bg_brush.fill_opacity = 0.17f;
-    m_bg_brush.outline_opacity = 0.0f;
-
-    // If show_menu is true, play the menu music.
-    if (show_menu)
-    {
-        if (m_level_number == 1)
-        {
-            m_level_state = LevelState::MAIN_MENU;
-            m_background_music = std::make_unique<Music>(
-                GameState::getInstance(), "MainMenuMusic", "title_screen.mp3", 0.7f, true, false);
-        }
-        else
-        {
-            m_level_state = LevelState::PAUSE_MENU;
-            m_background_music = std::make_unique<Music>(
-                GameState::getInstance(), "PauseMenuMusic", "ready_screen.mp3", 0.7f, true, false);
-        }
-        if (m_background_music)
-        {
-            m_background_music->play();
-        }
-    }
-    else
-    {
-        // When show_menu is false, we are entering active gameplay.
-        m_level_state = LevelState::ACTIVE;
-        if (m_background_music)
-        {
-            m_background_music->stop();
-        }
-        if (m_level_number == 1)
-        {
-            m_background_music = std::make_unique<Music>(
-                GameState::getInstance(), "Level1Music", "level_1.mp3", 0.7f, true, false);
-        }
-        else if (m_level_number == 2)
-        {
-            m_background_music = std::make_unique<Music>(
-                GameState::getInstance(), "Level2Music", "level_2.mp3", 0.7f, true, false);
-        }
-        else if (m_level_number == 3)
-        {
-            m_background_music = std::make_unique<Music>(
-                GameState::getInstance(), "Level3Music", "level_3.mp3", 0.7f, true, false);
-        }
-        else
-        {
-            m_background_music = std::make_unique<Music>(
-                GameState::getInstance(), "SuddenDeathMusic", "level_4.mp3", 0.7f, true, false);
-        }
-        if (m_background_music)
-        {
-            m_background_music->play();
-        }
-    }
-
-    // Initialize Sound Effects
-    m_paddle_hit_sound = std::make_unique<Music>(GameState::getInstance(), "PaddleHit", "paddle_hit.wav", 0.6f, false, true);
-    m_powerup_sound = std::make_unique<Music>(GameState::getInstance(), "PowerupSound", "powerup.mp3", 0.6f, false, true);
+    // Setup the background and text brushes
+    BrushCache& brushes = BrushCache::getInstance();
+    BrushStyle bg;
+    bg.texture = AssetRegistry::getInstance().getTexture("background.png");
+    bg.fill_opacity = 0.17f;
+    bg.outline_opacity = 0.0f;
+    m_bg_brush = brushes.getHandle(bg);
+
+    BrushStyle text(1.0f, 1.0f, 1.0f); // White color
+    text.outline_opacity = 0.0f;
+    m_text_brush = brushes.getHandle(text);
+
+    text.fill_color[0] = 0.0f; // Blue color for Player1
+    text.fill_color[1] = 0.0f;
+    text.fill_color[2] = 1.0f;
+    m_p1_brush = brushes.getHandle(text);
+
+    text.fill_color[0] = 1.0f; // Red color for Player2
+    text.fill_color[1] = 0.0f;
+    text.fill_color[2] = 0.0f;
+    m_p2_brush = brushes.getHandle(text);
+
+    // Fonts were loaded once by GameState::init
+    const FontHandle heading_font = FontManager::getFont(GameFont::HEADING);
+    const FontHandle body_font = FontManager::getFont(GameFont::BODY);
+    const FontHandle hud_font = FontManager::getFont(GameFont::HUD);
+
+    // Gameplay HUD: P1 score on the left, level and time in the center, P2 score on the right
+    m_hud.clear();
+    m_hud_p1 = m_hud.addText(20.0f, 30.0f, hud_font, m_text_brush);
+    m_hud_center = m_hud.addText(CANVAS_WIDTH / 2.0f - 100.0f, 30.0f, hud_font, m_text_brush);
+    m_hud_p2 = m_hud.addText(CANVAS_WIDTH - 115.0f, 30.0f, hud_font, m_text_brush);
+
+    // Game over screen, centered below each other
+    m_game_over_hud.clear();
+    m_hud_winner = m_game_over_hud.addText(CANVAS_WIDTH / 2.0f - 140.0f, CANVAS_HEIGHT / 2.0f - 50.0f, heading_font, m_text_brush);
+    m_hud_sudden_death = m_game_over_hud.addText(CANVAS_WIDTH / 2.0f - 100.0f, CANVAS_HEIGHT / 2.0f - 10.0f, body_font,
+        m_text_brush, "(In Sudden Death)");
+    m_hud_final_score = m_game_over_hud.addText(CANVAS_WIDTH / 2.0f - 148.0f, CANVAS_HEIGHT / 2.0f + 30.0f, body_font, m_text_brush);
+    m_game_over_hud.addText(CANVAS_WIDTH / 2.0f - 168.0f, CANVAS_HEIGHT / 2.0f + 70.0f, body_font, m_text_brush,
+        "Press R to Replay the Game");
+
+    // Rebuild the sound paths the last level moved into SGG
+    AudioBank::getInstance().restock();
 
     if (show_menu)
     {
@@ -151,815 +89,138 @@ void Level::init(int level_number, bool show_menu)
         m_menu = std::make_unique<Menu>(current_menu_type);
         m_level_state = (current_menu_type == MenuType::MAIN_MENU) ? LevelState::MAIN_MENU : LevelState::PAUSE_MENU;
 
-        std::cout << "Level " << m_level_number << " initialized with "
-            << ((current_menu_type == MenuType::MAIN_MENU) ? "Main Menu." : "Pause Menu.") << "\n";
+        LOG_INFO("Level {} initialized with {}", m_level_number,
+            (current_menu_type == MenuType::MAIN_MENU) ? "Main Menu." : "Pause Menu.");
     }
     else
     {
         m_level_state = LevelState::ACTIVE;
-        std::cout << "Level " << m_level_number << " initialized and active.\n";
+        LOG_INFO("Level {} initialized and active.", m_level_number);
     }
+    playStateMusic();
 
-    std::cout << "Level " << m_level_number << " initialized.\n";
+    LOG_INFO("Level {} initialized.", m_level_number);
 }
 
 /**
  * @brief Sets up the game objects specific to a given level (1-4).
  *
- * This method initializes players, the ball, obstacles, and powerups based on the current level number.
+ * This method loads the level into the simulation and creates the display objects for the players,
+ * the ball, and the level's initial obstacles.
  *
  * @param level_number The level number to set up.
  */
 void Level::setupLevelObjects(int level_number)
 {
-    // Initialize Players iwth assigned movement keys and paddle dimensions
-    m_player1 = std::make_unique<Player>(
-        GameState::getInstance(), "Player1", 50.0f, CANVAS_HEIGHT / 2.0f,
-        graphics::SCANCODE_W, graphics::SCANCODE_S, 10.0f, 70.0f
+    // Reset the simulation: paddles, ball, obstacles and spawn schedules
+    m_sim.setLevels(GameState::getInstance()->getLevels());
+    m_sim.reserveFrameEvents(); // Gameplay frames must not grow the event list
+    m_sim.loadLevel(level_number);
+    m_recorder.recordLevelLoad(level_number);
+    m_level_number = m_sim.getLevelNumber(); // An unknown number loads the first level
+
+    // Drop the objects of the previous level; their slots are reused below
+    m_player_pool.clear();
+    m_ball_pool.clear();
+
+    // Initialize Players with assigned movement keys and paddle dimensions
+    const SimPaddle& paddle1 = m_sim.getPaddle(1);
+    m_player1 = m_player_pool.create(
+        GameState::getInstance(), "Player1", paddle1.x, paddle1.y,
+        graphics::SCANCODE_W, graphics::SCANCODE_S, paddle1.width, paddle1.height
     );
     m_player1->init();
 
-    m_player2 = std::make_unique<Player>(
-        GameState::getInstance(), "Player2", CANVAS_WIDTH - 50.0f, CANVAS_HEIGHT / 2.0f,
-        graphics::SCANCODE_UP, graphics::SCANCODE_DOWN, 10.0f, 70.0f
+    const SimPaddle& paddle2 = m_sim.getPaddle(2);
+    m_player2 = m_player_pool.create(
+        GameState::getInstance(), "Player2", paddle2.x, paddle2.y,
+        graphics::SCANCODE_UP, graphics::SCANCODE_DOWN, paddle2.width, paddle2.height
     );
     m_player2->init();
 
-    // Initialize Ball with specified speed and dimensions
-    m_ball = std::make_unique<Ball>(
-        GameState::getInstance(), "Ball", 0.7f, 15.0f, 15.0f
+    // Initialize Ball
+    const SimBall& ball = m_sim.getBall();
+    m_ball = m_ball_pool.create(
+        GameState::getInstance(), "Ball", ball.base_width, ball.base_height
     );
     m_ball->init();
 
-    // Initialize Obstacles and Powerups based on the level number
-    if (level_number == 1)
-    {
-        // Level 1: Classic Pong (no obstacles or powerups)
-        std::cout << "Level 1: Classic Pong. No obstacles or powerups.\n";
-    }
-    else if (level_number == 2)
-    {
-        // Level 2: Add 2 stationary breakable obstacles + 2 powerups
-        std::cout << "Level 2: Adding 2 breakable obstacles and 2 powerups.\n";
-
-        // Add Breakable Obstacles
-        auto obstacle1 = std::make_unique<Obstacle>(
-            GameState::getInstance(), "BreakableObstacle1", Obstacle::Type::Breakable,
-            450.0f, 700.0f, 10.0f, 100.0f, 2, 0.0f
-        );
-        obstacle1->init();
-        m_obstacles.push_back(std::move(obstacle1));
+    // Mirror the initial paddle and ball state
+    syncObjects();
 
-        auto obstacle2 = std::make_unique<Obstacle>(
-            GameState::getInstance(), "BreakableObstacle2", Obstacle::Type::Breakable,
-            450.0f, 250.0f, 10.0f, 100.0f, 2, 0.0f
-        );
-        obstacle2->init();
-        m_obstacles.push_back(std::move(obstacle2));
-    }
-    else if (level_number == 3)
+    if (m_sim.getLevelDef().sudden_death)
     {
-        // Level 3: Add 2 stationary breakable obstacles, 2 moving unbreakable obstacle + 3 powerups
-        std::cout << "Level 3: Adding 2 breakable obstacles, 2 unbreakable moving obstacle, and 3 powerups.\n";
-
-        // Add Breakable Obstacles
-        auto obstacle1 = std::make_unique<Obstacle>(
-            GameState::getInstance(), "BreakableObstacle3", Obstacle::Type::Breakable,
-            400.0f, 700.0f, 10.0f, 100.0f, 2, 0.0f
-        );
-        obstacle1->init();
-        m_obstacles.push_back(std::move(obstacle1));
-
-        auto obstacle2 = std::make_unique<Obstacle>(
-            GameState::getInstance(), "BreakableObstacle4", Obstacle::Type::Breakable,
-            500.0f, 250.0f, 10.0f, 100.0f, 2, 0.0f
-        );
-        obstacle2->init();
-        m_obstacles.push_back(std::move(obstacle2));
-
-        // Add Unbreakable Moving Obstacle
-        auto obstacle3 = std::make_unique<Obstacle>(
-            GameState::getInstance(), "UnbreakableObstacle1", Obstacle::Type::Unbreakable,
-            350.0f, 300.0f, 10.0f, 100.0f, 0, 0.5f
-        );
-        obstacle3->init();
-        m_obstacles.push_back(std::move(obstacle3));
-
-        auto obstacle4 = std::make_unique<Obstacle>(
-            GameState::getInstance(), "UnbreakableObstacle2", Obstacle::Type::Unbreakable,
-            550.0f, 700.0f, 10.0f, 100.0f, 0, 0.5f
-        );
-        obstacle4->init();
-        m_obstacles.push_back(std::move(obstacle4));
+        LOG_INFO("Level {}: Sudden Death mode initialized.", level_number);
     }
-    else if (level_number == 4)
+    else
     {
-        // Level 4: Sudden Death
-        std::cout << "Level 4: Sudden Death mode initialized.\n";
-
-        m_elapsed_time = 0.0f;
-
-        // Reset spawn counters
-        m_unbreakable_obstacles_spawned_level4 = 0;
-        m_breakable_obstacles_spawned_level4 = 0;
-        m_powerups_spawned_level4 = 0;
-
-        // Increase ball speed by 40%
-        if (m_ball)
-        {
-            m_ball->setSpeed(m_ball->getSpeed() * 1.4f);
-            std::cout << "Ball speed increased for Sudden Death.\n";
-        }
-
-        // Initialize spawning timers for obstacles and powerups
-        
-        // Schedule first unbreakable obstacle spawn after 2 seconds
-        m_next_obstacle_spawn_time_level4 = m_elapsed_time + 2.0f;
-        // Schedule first breakable obstacle spawn after 4 seconds
-        m_next_breakable_obstacle_spawn_time_level4 = m_elapsed_time + 4.0f;
-        // Schedule first powerup spawn after 3 seconds
-        m_next_powerup_spawn_time_level4 = m_elapsed_time + 3.0f;
-
-        std::cout << "Initialized spawning timers for Sudden Death.\n";
+        LOG_INFO("Level {}: {} obstacles.", level_number, m_sim.getObstacles().size());
     }
 }
 
 /**
- * @brief Updates all objects in the level, checks for collisions, and handles timer logic.
+ * @brief Updates the level: handles menus, advances the simulation during gameplay, and handles
+ * level progression.
  *
- * This method manages the game loop by updating the level timer, spawning powerups and obstacles,
- * updating players, the ball, obstacles, and powerups, handling collisions, and checking for level
- * progression or game over conditions.
+ * During active gameplay the paddle input is sampled once per frame and the simulation consumes
+ * the frame time in fixed ticks, so the game rules do not depend on the frame rate.
  *
- * @param dt Time elapsed since the last update in seconds.
+ * @param dt Time elapsed since the last update in milliseconds.
  */
 void Level::update(float dt)
 {
+    PROFILE_ZONE("Level::update");
+
     switch (m_level_state) {
     case LevelState::MAIN_MENU:
         // Update the Main Menu
 		m_menu->update();
 
         if (m_menu->isPlayClicked()) {
-            // Stop the main menu music before transitioning
-			if (m_background_music) { m_background_music->stop(); }
-
-            // Start level if play is clicked
+            // Start level if play is clicked, crossfading from the main menu music
             m_level_state = LevelState::ACTIVE;
+            m_computer_player1 = m_menu->isComputerPlayer(1);
+            m_computer_player2 = m_menu->isComputerPlayer(2);
+            startMatch();
+            playStateMusic();
 
-            // Initialize and play level-specific music
-            if (m_level_number == 1)
-                m_background_music = std::make_unique<Music>(
-                    GameState::getInstance(), "Level1Music", "level_1.mp3", 0.7f, true, false);
-
-            if (m_background_music) { m_background_music->play(); }
-
-			std::cout << "Starting Level " << m_level_number << ".\n";
+			LOG_INFO("Starting Level {}.", m_level_number);
         }
 
         if (m_menu->isExitClicked())
         {
             // Handle game exit, by destroying window and terminating the program
-            std::cout << "Exit pressed. Closing game.\n";
+            LOG_INFO("Exit pressed. Closing game.");
             graphics::destroyWindow();
             exit(0);
         }
         break;
 
     case LevelState::ACTIVE:
-        // 1. Update Level Timer
-        if (m_level_number != 4) // Exclude Sudden Death from Level Timer countdown
-        {
-            m_level_timer -= dt / 100.0f;
-            if (m_level_timer < 0.0f)
-            {
-                m_level_timer = 0.0f;
-            }
-        }
-
-        // Update elapsed time
-        m_elapsed_time += dt / 1000; // Assuming dt is in milliseconds; adjust if necessary
-
-        // 2. Powerup and Obstacle Spawning Logic for Levels 2 and 3
-        if (m_level_number == 2 || m_level_number == 3) {
-            if (m_total_powerups_to_spawn > 0 && m_powerups_spawned < m_total_powerups_to_spawn)
-            {
-                if (m_elapsed_time >= m_next_powerup_spawn_time)
-                {
-                    // Spawn a powerup at the next spawn position
-                    if (m_powerups_spawned < m_powerup_spawn_positions.size())
-                    {
-                        float px = m_powerup_spawn_positions[m_powerups_spawned].first;
-                        float py = m_powerup_spawn_positions[m_powerups_spawned].second;
-
-                        // Determine powerup type based on level and spawn count
-                        Powerup::Type type;
-                        if (m_level_number == 2)
-                        {
-                            type = (m_powerups_spawned % 2 == 0) ? Powerup::Type::SPEED_UP : Powerup::Type::SLOW_DOWN;
-                        }
-                        else if (m_level_number == 3)
-                        {
-                            switch (m_powerups_spawned)
-                            {
-                            case 0: type = Powerup::Type::INCREASE_SIZE; break;
-                            case 1: type = Powerup::Type::DECREASE_SIZE; break;
-                            case 2: type = Powerup::Type::SPEED_UP; break;
-                            case 3: type = Powerup::Type::SLOW_DOWN; break;
-                            default: type = Powerup::Type::SPEED_UP; break;
-                            }
-                        }
-
-                        // Create and initialize the Powerup object
-                        auto powerup = std::make_unique<Powerup>(
-                            GameState::getInstance(), "Powerup" + std::to_string(m_powerups_spawned + 1),
-                            type, px, py
-                        );
-                        powerup->init();
-                        m_powerups.push_back(std::move(powerup));
-
-                        m_powerups_spawned++;
-
-                        // Schedule the next powerup spawn time (e.g., add a random interval between 2-5 seconds)
-                        std::random_device rd;
-                        std::mt19937 gen(rd());
-                        std::uniform_real_distribution<float> dist_interval(2.0f, 5.0f);
-                        float interval = dist_interval(gen);
-                        m_next_powerup_spawn_time += interval;
-
-                        std::cout << "Spawned Powerup" << m_powerups_spawned << " at (" << px << ", " << py << ").\n";
-                    }
-                    else
-                    {
-                        // All predefined spawn positions have been used
-                        std::cout << "All powerup spawn positions have been used.\n";
-                        // Optionally, reset m_powerups_spawned or handle accordingly
-                    }
-                }
-            }
-        }
-
-        // 3. Powerup and Obstacle Spawning Logic for Level 4
-        if (m_level_number == 4) {
-            // Sudden Death: Spawn Unbreakable Obstacles
-            if (m_unbreakable_obstacles_spawned_level4 < MAX_UNBREAKABLE_OBSTACLES &&
-                m_obstacles_spawned_level4 < MAX_UNBREAKABLE_OBSTACLES &&
-                m_elapsed_time >= m_next_obstacle_spawn_time_level4)
-            {
-                // Generate random position within boundaries
-                float ox = getRandomFloat(m_obstacle_spawn_min_x, m_obstacle_spawn_max_x);
-                float oy = getRandomFloat(m_obstacle_spawn_min_y, m_obstacle_spawn_max_y);
-
-                // Spawn an unbreakable obstacle
-                auto obstacle = std::make_unique<Obstacle>(
-                    GameState::getInstance(), "UnbreakableObstacle_SuddenDeath_" + std::to_string(m_unbreakable_obstacles_spawned_level4 + 1),
-                    Obstacle::Type::Unbreakable,
-                    ox, oy, 10.0f, 100.0f, 0, 0.5f
-                );
-                obstacle->init();
-                m_obstacles.push_back(std::move(obstacle));
-
-                m_obstacles_spawned_level4++;
-                m_unbreakable_obstacles_spawned_level4++;
-
-                // Schedule the next obstacle spawn time (e.g., add a random interval between 2-5 seconds)
-                float interval = getRandomFloat(2.0f, 5.0f);
-                m_next_obstacle_spawn_time_level4 = m_elapsed_time + interval;
-
-                std::cout << "Spawned Unbreakable Obstacle " << m_unbreakable_obstacles_spawned_level4
-                    << " at (" << ox << ", " << oy << ").\n";
-            }
-
-            // Sudden Death: Spawn Breakable Obstacles
-            if (m_breakable_obstacles_spawned_level4 < MAX_BREAKABLE_OBSTACLES &&
-                m_elapsed_time >= m_next_breakable_obstacle_spawn_time_level4)
-            {
-                // Generate random position within boundaries
-                float bx = getRandomFloat(m_obstacle_spawn_min_x, m_obstacle_spawn_max_x);
-                float by = getRandomFloat(m_obstacle_spawn_min_y, m_obstacle_spawn_max_y);
-
-                // Spawn a breakable obstacle
-                auto obstacle = std::make_unique<Obstacle>(
-                    GameState::getInstance(), "BreakableObstacle_SuddenDeath_" + std::to_string(m_breakable_obstacles_spawned_level4 + 1),
-                    Obstacle::Type::Breakable,
-                    bx, by, 10.0f, 100.0f, 2, 0.0f // Assuming 2 hit points
-                );
-                obstacle->init();
-                m_obstacles.push_back(std::move(obstacle));
-
-                m_obstacles_spawned_level4++;
-                m_breakable_obstacles_spawned_level4++;
-
-                // Schedule the next breakable obstacle spawn time (e.g., add a random interval between 2-5 seconds)
-                float interval = getRandomFloat(2.0f, 5.0f);
-                m_next_breakable_obstacle_spawn_time_level4 = m_elapsed_time + interval;
-
-                std::cout << "Spawned Breakable Obstacle " << m_breakable_obstacles_spawned_level4
-                    << " at (" << bx << ", " << by << ").\n";
-            }
-
-            // Sudden Death: Spawn Powerups
-            if (m_powerups_spawned_level4 < MAX_POWERUPS &&
-                m_elapsed_time >= m_next_powerup_spawn_time_level4)
-            {
-                // Generate random position within boundaries
-                float px = getRandomFloat(m_powerup_spawn_min_x, m_powerup_spawn_max_x);
-                float py = getRandomFloat(m_powerup_spawn_min_y, m_powerup_spawn_max_y);
-
-                // Determine powerup type based on spawn count, excluding SPEED_UP if needed
-                Powerup::Type type;
-                switch (m_powerups_spawned_level4 % 4) // Cycle through 4 types
-                {
-                case 0: type = Powerup::Type::SLOW_DOWN; break;
-                case 1: type = Powerup::Type::INCREASE_SIZE; break;
-                case 2: type = Powerup::Type::DECREASE_SIZE; break;
-                case 3: type = Powerup::Type::SLOW_DOWN; break;
-                default: type = Powerup::Type::SLOW_DOWN; break;
-                }
-
-                // Optional: Check distance from existing powerups and obstacles before spawning
-                bool can_spawn = true;
-                const float MIN_DISTANCE = 100.0f; // Minimum distance between powerups and obstacles
-
-                for (const auto& obstacle : m_obstacles)
-                {
-                    if (obstacle->isActive())
-                    {
-                        float distance = std::sqrt(std::pow(px - obstacle->getX(), 2) + std::pow(py - obstacle->getY(), 2));
-                        if (distance < MIN_DISTANCE)
-                        {
-                            can_spawn = false;
-                            break;
-                        }
-                    }
-                }
-
-                for (const auto& powerup : m_powerups)
-                {
-                    if (powerup->isActive())
-                    {
-                        float distance = std::sqrt(std::pow(px - powerup->getX(), 2) + std::pow(py - powerup->getY(), 2));
-                        if (distance < MIN_DISTANCE)
-                        {
-                            can_spawn = false;
-                            break;
-                        }
-                    }
-                }
-
-                if (can_spawn)
-                {
-                    // Create and initialize the Powerup object
-                    auto powerup = std::make_unique<Powerup>(
-                        GameState::getInstance(), "Powerup_SuddenDeath_" + std::to_string(m_powerups_spawned_level4 + 1),
-                        type, px, py
-                    );
-                    powerup->init();
-                    m_powerups.push_back(std::move(powerup));
-
-                    m_powerups_spawned_level4++;
-
-                    // Schedule the next powerup spawn time (e.g., add a random interval between 2-5 seconds)
-                    float interval = getRandomFloat(2.0f, 5.0f);
-                    m_next_powerup_spawn_time_level4 = m_elapsed_time + interval;
-
-                    std::cout << "Spawned Powerup " << m_powerups_spawned_level4 << " of type " << static_cast<int>(type)
-                        << " at (" << px << ", " << py << ").\n";
-                }
-                else
-                {
-                    // Skip spawning if the location is too close to existing objects
-                    std::cout << "Powerup spawn at (" << px << ", " << py << ") skipped due to proximity.\n";
-                }
-            }
-        }
-
-        
-
-        // 4. Update Players, Ball, Obstacles, and Powerups
-        if (m_player1 && m_player1->isActive()) m_player1->update(dt);
-        if (m_player2 && m_player2->isActive()) m_player2->update(dt);
-        if (m_ball && m_ball->isActive()) m_ball->update(dt);
-
-        for (auto& obstacle : m_obstacles)
-        {
-            if (obstacle->isActive())
-                obstacle->update(dt);
-        }
-
-        for (auto& powerup : m_powerups)
-        {
-            if (powerup->isActive())
-                powerup->update(dt);
-        }
-
-        // 5. Boundary Collision Detection and Response for Scoring
-        if (m_ball && m_ball->isActive())
-        {
-            float bx = m_ball->getX();
-            float by = m_ball->getY();
-            float halfW = m_ball->getWidth() / 2.0f;
-            float halfH = m_ball->getHeight() / 2.0f;
-
-            // Check for collision with right boundary (Player 1 scores)
-            if (bx + halfW >= CANVAS_WIDTH)
-            {
-                // Increment Player1's score
-                m_player1_score++;
-                std::cout << "Scores - Player1: " << m_player1_score << ", Player2: " << m_player2_score << std::endl;
-                m_ball->reset();
-
-                // Clear active powerups on the ball
-                if (m_ball)
-                {
-                    m_ball->clearActivePowerups();
-                }
-
-                // Reset speed multiplier to default
-                m_speed_multiplier = 1.0f;
-
-                // Reset last player to hit the ball
-                m_last_player_to_hit = 0;
-
-                std::cout << "Powerups cleared and speed multiplier reset after Player1 scoring.\n";
-            }
-            // Check for collision with left boundary (Player 2 scores)
-            else if (bx - halfW <= 0.0f)
-            {
-                // Increment Player2's score
-                m_player2_score++;
-                std::cout << "Scores - Player1: " << m_player1_score << ", Player2: " << m_player2_score << std::endl;
-                m_ball->reset();
-
-                // Clear active powerups on the ball
-                if (m_ball)
-                {
-                    m_ball->clearActivePowerups(); // Ensure this method exists in the Ball class
-                }
-
-                // Reset speed multiplier to default
-                m_speed_multiplier = 1.0f;
-
-                // Reset last player to hit the ball
-                m_last_player_to_hit = 0;
-
-                std::cout << "Powerups cleared and speed multiplier reset after Player2 scoring.\n";
-            }
-
-            // 6. Boundary Collision Detection and Response for Walls
-
-            // Check for collision with top boundary
-            if (by + halfH >= CANVAS_HEIGHT)
-            {
-                m_ball->setY(CANVAS_HEIGHT - halfH);
-                m_ball->setSpeed_y(-fabs(m_ball->getSpeed_y())); // Ensure speed_y is negative
-                std::cout << "Ball collided with top boundary. New speed_y: " << m_ball->getSpeed_y() << std::endl;
-            }
-
-            // Check for collision with bottom boundary
-            else if (by - halfH <= 0.0f)
-            {
-                m_ball->setY(halfH);
-                m_ball->setSpeed_y(fabs(m_ball->getSpeed_y())); // Ensure speed_y is positive
-                std::cout << "Ball collided with bottom boundary. New speed_y: " << m_ball->getSpeed_y() << std::endl;
-            }
-        }
-
-        // 7. Collision Detection with Player Paddles
-        if (m_ball && m_ball->isActive())
+    {
+        // 1. Sample paddle input and advance the simulation in fixed ticks
+        SimInput input;
+        input.player1 = m_computer_player1 ? m_ai1.getInput(m_sim, 1, dt) : m_player1->readInput();
+        input.player2 = m_computer_player2 ? m_ai2.getInput(m_sim, 2, dt) : m_player2->readInput();
         {
-            if (!m_ball->isActivePowerup()) {
-                m_speed_multiplier = 1.0f; // Reset speed multiplier if no active powerup present
-            }
-
-            // Create a Box representing the ball's current position and size
-            Box ballBox(m_ball->getX(), m_ball->getY(), m_ball->getWidth(), m_ball->getHeight());
-
-            // Collision with Player 1 Paddle (Left Paddle)
-            if (m_player1 && m_player1->isActive())
-            {
-                Box paddle1Box(m_player1->getX(), m_player1->getY(), m_player1->getWidth(), m_player1->getHeight());
-
-                if (ballBox.intersect(paddle1Box))
-                {
-                    // Reflect the ball's horizontal speed
-                    m_ball->setSpeed_x(fabs(m_ball->getSpeed_x())); // Ensure speed_x is positive
-
-                    // Adjust ball's position to prevent sticking
-                    m_ball->setX(paddle1Box.m_pos_x + paddle1Box.m_width / 2.0f + m_ball->getWidth() / 2.0f + 1.0f);
-
-                    std::cout << "Ball collided with Player 1 paddle. New speed_x: " << m_ball->getSpeed_x() << std::endl;
-
-                    std::cout << "Ball speed_y adjusted by Player 1 paddle movement: New speed_y = " << m_ball->getSpeed_y() << std::endl;
-
-                    // Normalize the Ball's Velocity to Maintain Current Speed with Powerup
-                    float current_speed = std::sqrt(m_ball->getSpeed_x() * m_ball->getSpeed_x() +
-                        m_ball->getSpeed_y() * m_ball->getSpeed_y());
-                    if (current_speed > 0.0f)
-                    {
-                        float new_speed = m_ball->getSpeed() * m_speed_multiplier;
-                        m_ball->setSpeed_x((m_ball->getSpeed_x() / current_speed) * new_speed);
-                        m_ball->setSpeed_y((m_ball->getSpeed_y() / current_speed) * new_speed);
-                        std::cout << "Ball velocity normalized after Player 1 paddle collision: speed_x = "
-                            << m_ball->getSpeed_x() << ", speed_y = " << m_ball->getSpeed_y() << std::endl;
-                    }
-
-                    // Set the last player to hit the ball
-                    m_last_player_to_hit = 1;
-
-                    // Play collision sound
-                    if (m_paddle_hit_sound)
-                    {
-                        m_paddle_hit_sound->play();
-                    }
-                }
-            }
-
-            // Collision with Player 2 Paddle (Right Paddle)
-            if (m_player2 && m_player2->isActive())
-            {
-                Box paddle2Box(m_player2->getX(), m_player2->getY(), m_player2->getWidth(), m_player2->getHeight());
-
-                if (ballBox.intersect(paddle2Box))
-                {
-                    // Reflect the ball's horizontal speed
-                    m_ball->setSpeed_x(-fabs(m_ball->getSpeed_x())); // Ensure speed_x is negative
-
-                    // Adjust ball's position to prevent sticking
-                    m_ball->setX(paddle2Box.m_pos_x - paddle2Box.m_width / 2.0f - m_ball->getWidth() / 2.0f - 1.0f);
-
-                    std::cout << "Ball collided with Player 2 paddle. New speed_x: " << m_ball->getSpeed_x() << std::endl;
-
-                    std::cout << "Ball speed_y adjusted by Player 2 paddle movement: New speed_y = " << m_ball->getSpeed_y() << std::endl;
-
-                    // Normalize the Ball's Velocity to Maintain Current Speed with Powerup
-                    float current_speed = std::sqrt(m_ball->getSpeed_x() * m_ball->getSpeed_x() +
-                        m_ball->getSpeed_y() * m_ball->getSpeed_y());
-                    if (current_speed > 0.0f)
-                    {
-                        float new_speed = m_ball->getSpeed() * m_speed_multiplier;
-                        m_ball->setSpeed_x((m_ball->getSpeed_x() / current_speed) * new_speed);
-                        m_ball->setSpeed_y((m_ball->getSpeed_y() / current_speed) * new_speed);
-                        std::cout << "Ball velocity normalized after Player 2 paddle collision: speed_x = "
-                            << m_ball->getSpeed_x() << ", speed_y = " << m_ball->getSpeed_y() << std::endl;
-                    }
-
-                    // Set the last player to hit the ball
-                    m_last_player_to_hit = 2;
-
-                    // Play collision sound
-                    if (m_paddle_hit_sound)
-                    {
-                        m_paddle_hit_sound->play();
-                    }
-                }
-            }
+            PROFILE_ZONE("Simulation::advance");
+            m_recorder.record(input, m_sim.advance(dt, input));
         }
 
-        // 8. Collision Detection with Obstacles
-        if (m_ball && m_ball->isActive() && !m_ball->isRampingUp())
+        // 2. Mirror the simulation state and react to its events
         {
-            // Create a Box representing the ball's current position and size
-            Box ballBox(m_ball->getX(), m_ball->getY(), m_ball->getWidth(), m_ball->getHeight());
-
-            for (auto& obstacle : m_obstacles)
-            {
-                if (obstacle->isActive())
-                {
-                    // Create a Box for the obstacle
-                    Box obstacleBox(obstacle->getX(), obstacle->getY(), obstacle->getWidth(), obstacle->getHeight());
-
-                    // Check for collision
-                    if (ballBox.intersect(obstacleBox))
-                    {
-                        if (obstacle->isBreakable())
-                        {
-                            // Determine the side of collision
-                            if (m_ball->getX() < obstacle->getX())
-                            {
-                                // Ball is to the left of the obstacle
-                                m_ball->setSpeed_x(-fabs(m_ball->getSpeed_x())); // Ensure negative speed_x
-                                m_ball->setX(obstacleBox.m_pos_x - obstacleBox.m_width / 2.0f - m_ball->getWidth() / 2.0f - 1.0f); // Prevent sticking
-                                std::cout << "Ball speed updated: speed_x = " << m_ball->getSpeed_x()
-                                    << ", speed_y = " << m_ball->getSpeed_y() << std::endl;
-                            }
-                            else
-                            {
-                                // Ball is to the right of the obstacle
-                                m_ball->setSpeed_x(fabs(m_ball->getSpeed_x())); // Ensure positive speed_x
-                                m_ball->setX(obstacleBox.m_pos_x + obstacleBox.m_width / 2.0f + m_ball->getWidth() / 2.0f + 1.0f); // Prevent sticking
-                                std::cout << "Ball speed updated: speed_x = " << m_ball->getSpeed_x()
-                                    << ", speed_y = " << m_ball->getSpeed_y() << std::endl;
-                            }
-
-                            std::cout << "Ball collided with breakable obstacle '" << obstacle->getName()
-                                << "'. New speed_x: " << m_ball->getSpeed_x() << std::endl;
-
-                            // Adjust Ball's Vertical Speed Based on Obstacle's Movement
-                            m_ball->setSpeed_y(m_ball->getSpeed_y() + obstacle->getSpeed() * obstacle->getDirection());
-
-                            std::cout << "Ball speed_y adjusted by obstacle movement: New speed_y = "
-                                << m_ball->getSpeed_y() << std::endl;
-
-                            // Normalize the Ball's Velocity to Maintain Current Speed with Speed Multiplier
-                            float current_speed = std::sqrt(m_ball->getSpeed_x() * m_ball->getSpeed_x() +
-                                m_ball->getSpeed_y() * m_ball->getSpeed_y());
-                            if (current_speed > 0.0f)
-                            {
-                                float new_speed = m_ball->getSpeed() * m_speed_multiplier;
-                                m_ball->setSpeed_x((m_ball->getSpeed_x() / current_speed) * new_speed);
-                                m_ball->setSpeed_y((m_ball->getSpeed_y() / current_speed) * new_speed);
-                                std::cout << "Ball velocity normalized with speed multiplier after breakable obstacle collision: speed_x = "
-                                    << m_ball->getSpeed_x() << ", speed_y = " << m_ball->getSpeed_y() << std::endl;
-                            }
-
-                            // Handle the hit on the obstacle
-                            obstacle->handleHit();
-
-                            // Handle Scoring When Breaking Breakable Obstacles
-                            if (obstacle->isBreakable() && obstacle->getHitPoints() == 0)
-                            {
-                                if (m_last_player_to_hit == 1)
-                                {
-                                    // Player 1 broke the obstacle
-                                    m_player1_score++;
-                                    std::cout << "Player 1 broke obstacle '" << obstacle->getName()
-                                        << "'. Score: " << m_player1_score << std::endl;
-                                }
-                                else if (m_last_player_to_hit == 2)
-                                {
-                                    // Player 2 broke the obstacle
-                                    m_player2_score++;
-                                    std::cout << "Player 2 broke obstacle '" << obstacle->getName()
-                                        << "'. Score: " << m_player2_score << std::endl;
-                                }
-                                else
-                                {
-                                    // If no player has hit the ball yet, default to assigning score to both or skip
-                                    std::cout << "Obstacle '" << obstacle->getName() << "' broken with no player interaction.\n";
-                                }
-                            }
-
-                            // Play collision sound
-                            if (m_paddle_hit_sound)
-                            {
-                                m_paddle_hit_sound->play();
-                            }
-
-                            // Since the ball has collided with a breakable obstacle, no need to check other obstacles for this frame
-                            break;
-                        }
-                        else
-                        {
-                            // Use horizontal collision logic (as in the breakable branch) for unbreakable obstacles.
-                            if (m_ball->getX() < obstacle->getX())
-                            {
-                                // Ball is to the left of the obstacle
-                                m_ball->setSpeed_x(-fabs(m_ball->getSpeed_x())); // Ensure negative speed_x
-                                m_ball->setX(obstacleBox.m_pos_x - obstacleBox.m_width / 2.0f - m_ball->getWidth() / 2.0f - 1.0f); // Prevent sticking
-                                std::cout << "Ball collided with unbreakable obstacle '" << obstacle->getName()
-                                    << "'. New speed_x: " << m_ball->getSpeed_x() << std::endl;
-                            }
-                            else
-                            {
-                                // Ball is to the right of the obstacle
-                                m_ball->setSpeed_x(fabs(m_ball->getSpeed_x())); // Ensure positive speed_x
-                                m_ball->setX(obstacleBox.m_pos_x + obstacleBox.m_width / 2.0f + m_ball->getWidth() / 2.0f + 1.0f); // Prevent sticking
-                                std::cout << "Ball collided with unbreakable obstacle '" << obstacle->getName()
-                                    << "'. New speed_x: " << m_ball->getSpeed_x() << std::endl;
-                            }
-
-                            std::cout << "Ball collided with unbreakable obstacle '" << obstacle->getName() << "'.\n";
-
-                            // Adjust Ball's Vertical Speed Based on Obstacle's Movement
-                            m_ball->setSpeed_y(m_ball->getSpeed_y() + obstacle->getSpeed() * obstacle->getDirection());
-                            std::cout << "Ball speed_y adjusted by obstacle movement: New speed_y = "
-                                << m_ball->getSpeed_y() << std::endl;
-
-                            // Normalize the Ball's Velocity to maintain current speed with speed multiplier
-                            float current_speed = std::sqrt(m_ball->getSpeed_x() * m_ball->getSpeed_x() +
-                                m_ball->getSpeed_y() * m_ball->getSpeed_y());
-                            if (current_speed > 0.0f)
-                            {
-                                float new_speed = m_ball->getSpeed() * m_speed_multiplier;
-                                m_ball->setSpeed_x((m_ball->getSpeed_x() / current_speed) * new_speed);
-                                m_ball->setSpeed_y((m_ball->getSpeed_y() / current_speed) * new_speed);
-                                std::cout << "Ball velocity normalized after unbreakable obstacle collision: speed_x = "
-                                    << m_ball->getSpeed_x() << ", speed_y = " << m_ball->getSpeed_y() << std::endl;
-                            }
-
-                            // Play collision sound
-                            if (m_paddle_hit_sound)
-                            {
-                                m_paddle_hit_sound->play();
-                            }
-
-                            // Since the ball has collided with an obstacle, exit the loop for this frame
-                            break;
-                        }
-                    }
-                }
-            }
+            PROFILE_ZONE("Level::syncObjects");
+            syncObjects();
         }
-
-        // 9. Collision Detection with Powerups
-        if (m_ball && m_ball->isActive() && !m_ball->isRampingUp() && !m_ball->isActivePowerup())
         {
-            // Create a Box representing the ball's current position and size
-            Box ballBox(m_ball->getX(), m_ball->getY(), m_ball->getWidth(), m_ball->getHeight());
-
-            // Iterate through powerups to check collision with the ball
-            for (auto& powerup : m_powerups)
-            {
-                if (powerup && powerup->isActive())
-                {
-                    Box powerupBox(powerup->getX(), powerup->getY(), powerup->getWidth(), powerup->getHeight());
-                    if (ballBox.intersect(powerupBox))
-                    {
-                        m_ball->applyPowerup(powerup->getType());
-
-                        // Adjust the speed multiplier based on the powerup type
-                        if (powerup->getType() == Powerup::Type::SPEED_UP)
-                        {
-                            m_speed_multiplier *= 1.5f;
-                            std::cout << "Speed Up Powerup Activated. Speed Multiplier: " << m_speed_multiplier << std::endl;
-                        }
-                        else if (powerup->getType() == Powerup::Type::SLOW_DOWN)
-                        {
-                            m_speed_multiplier *= 0.6f;
-                            std::cout << "Slow Down Powerup Activated. Speed Multiplier: " << m_speed_multiplier << std::endl;
-                        }
-
-                        // Play the powerup activation sound
-                        if (m_powerup_sound)
-                        {
-                            m_powerup_sound->play();
-                        }
-
-                        std::cout << "Ball collided with powerup '"
-                            << powerup->getName() << "'. Applying effect.\n";
-
-                        // Mark powerup as inactive
-                        powerup->setActive(false);
-                    }
-                }
-            }
+            PROFILE_ZONE("Level::handleSimulationEvents");
+            handleSimulationEvents();
         }
 
-        // 10. Check if it's time to progress to the next level
+        // 3. Check if it's time to progress to the next level
         checkLevelProgression();
-
-        // Handle Sudden Death Winning Conditions
-        if (m_level_number == 4 && m_level_state == LevelState::ACTIVE)
-        {
-            if (m_player1_score >= 10)
-            {
-                // Player 1 wins Sudden Death
-                m_winner = 1;
-                m_level_state = LevelState::GAME_OVER;
-
-                if (m_background_music) {
-                    m_background_music->stop();
-                }
-                m_background_music = std::make_unique<Music>(
-                    GameState::getInstance(),
-                    "GameOverMusic",
-                    "game_over.mp3",
-                    0.7f,
-                    false,
-                    false
-                );
-                if (m_background_music) {
-                    m_background_music->play();
-                }
-
-                std::cout << "Player 1 wins Sudden Death with score " << m_player1_score << "!\n";
-            }
-            else if (m_player2_score >= 10)
-            {
-                // Player 2 wins Sudden Death
-                m_winner = 2;
-                m_level_state = LevelState::GAME_OVER;
-
-                if (m_background_music) {
-                    m_background_music->stop();
-                }
-                m_background_music = std::make_unique<Music>(
-                    GameState::getInstance(),
-                    "GameOverMusic",
-                    "game_over.mp3",
-                    0.7f,
-                    false,
-                    false
-                );
-                if (m_background_music) {
-                    m_background_music->play();
-                }
-
-                std::cout << "Player 2 wins Sudden Death with score " << m_player2_score << "!\n";
-            }
-        }
         break;
+    }
 
         case LevelState::PAUSE_MENU:
             // Update the pause menu
@@ -967,16 +228,18 @@ void Level::update(float dt)
 
             if (m_menu->isReadyPressed())
             {
-                if (m_level_number <= 4)
+                // nextLevel() took the next level from the simulation; the level set decides if it exists
+                if (m_sim.getLevels().find(m_level_number) != nullptr)
                 {
                     init(m_level_number, false); // Initialize the next level
                     m_level_state = LevelState::ACTIVE;
-                    std::cout << "Starting Level " << m_level_number << ".\n";
+                    LOG_INFO("Starting Level {}.", m_level_number);
                 }
                 else
                 {
                     m_level_state = LevelState::GAME_OVER;
-                    std::cout << "All levels completed. Game Over.\n";
+                    playStateMusic();
+                    LOG_INFO("All levels completed. Game Over.");
                 }
                 m_menu->resetFlags();
             }
@@ -984,7 +247,8 @@ void Level::update(float dt)
             // Handle exit from Pause Menu
             if (m_menu->isExitClicked())
             {
-                std::cout << "Exit pressed. Closing game.\n";
+                finishRecording();
+                LOG_INFO("Exit pressed. Closing game.");
                 graphics::destroyWindow();
                 exit(0);
             }
@@ -997,7 +261,7 @@ void Level::update(float dt)
             if (!m_menu || m_menu->getMenuType() != MenuType::GAME_OVER_MENU)
             {
                 m_menu = std::make_unique<Menu>(MenuType::GAME_OVER_MENU);
-                std::cout << "Game Over Menu initialized.\n";
+                LOG_INFO("Game Over Menu initialized.");
             }
 
             // Update the Game Over Menu
@@ -1007,20 +271,18 @@ void Level::update(float dt)
             if (m_menu->isPlayClicked())
             {
                 // Reset Player Scores and Winner
-                m_player1_score = 0;
-                m_player2_score = 0;
-                m_winner = 0;
+                m_sim.resetScores();
 
                 // Initialize Main Menu
                 init(1, true); // Reset to Level 1 with Main Menu
                 m_level_state = LevelState::MAIN_MENU;
-                std::cout << "Returning to Main Menu.\n";
+                LOG_INFO("Returning to Main Menu.");
             }
 
             // Handle Input: Press E to Exit Game
             if (m_menu->isExitClicked())
             {
-                std::cout << "Exit pressed. Closing game.\n";
+                LOG_INFO("Exit pressed. Closing game.");
                 graphics::destroyWindow();
                 exit(0); // Terminate the program
             }
@@ -1036,22 +298,27 @@ void Level::update(float dt)
  *
  * This method renders the background, players, ball, obstacles, powerups, and level information such as
  * scores and timers based on the current level state.
+ *
+ * @param list Draw list of the frame.
  */
-void Level::draw() const
+void Level::draw(DrawList& list) const
 {
+    PROFILE_ZONE("Level::draw");
+
     switch (m_level_state) {
     case LevelState::MAIN_MENU:
     case LevelState::PAUSE_MENU:
         // Draw the Pause Menu
         if (m_menu)
         {
-            m_menu->draw();
+            m_menu->draw(list);
         }
         break;
 
     case LevelState::ACTIVE: {
         // Draw the background
-        graphics::drawRect(
+        list.drawRect(
+            DrawLayer::BACKGROUND,
             CANVAS_WIDTH / 2.0f,
             CANVAS_HEIGHT / 2.0f,
             CANVAS_WIDTH,
@@ -1060,83 +327,32 @@ void Level::draw() const
         );
 
         // Draw Players
-        if (m_player1 && m_player1->isActive()) m_player1->draw();
-        if (m_player2 && m_player2->isActive()) m_player2->draw();
+        if (m_player1 && m_player1->isActive()) m_player1->draw(list);
+        if (m_player2 && m_player2->isActive()) m_player2->draw(list);
 
         // Draw Ball
-        if (m_ball && m_ball->isActive()) m_ball->draw();
+        if (m_ball && m_ball->isActive()) m_ball->draw(list);
 
-        // Draw Obstacles
-        for (const auto& obstacle : m_obstacles)
-        {
-            if (obstacle->isActive())
-                obstacle->draw();
-        }
-
-        // Draw Powerups
-        for (const auto& powerup : m_powerups)
-        {
-            if (powerup->isActive())
-                powerup->draw();
-        }
-
-        // Draw Level Information (e.g., Timer and Lives)
-        graphics::Brush text_br;
-        text_br.fill_opacity = 1.0f;
-        text_br.outline_opacity = 0.0f;
-        text_br.fill_color[0] = 1.0f; // White color
-        text_br.fill_color[1] = 1.0f;
-        text_br.fill_color[2] = 1.0f;
-
-        // 1. Draw P1 Score on the Left
-        std::string p1_info = "P1 Score: " + std::to_string(m_player1_score);
-        graphics::drawText(
-            20.0f,                               // X position (left margin)
-            30.0f,                               // Y position
-            20.0f,                               // Font size
-            p1_info,                             // Text to display
-            text_br                              // Brush settings
-        );
+        // Draw Obstacles and Powerups straight from the simulation's stores
+        Obstacle::drawAll(m_sim.getObstacles(), list);
+        Powerup::drawAll(m_sim.getPowerups(), list);
 
-        // 2. Draw Level and Time in the Center
-        if (m_level_number == 4) {
-            std::string center_info = "Level " + std::to_string(m_level_number) +
-                "   |   Time left: N/A";
-            graphics::drawText(
-                CANVAS_WIDTH / 2.0f - 100.0f,        // X position (centered horizontally)
-                30.0f,                               // Y position
-                20.0f,                               // Font size
-                center_info,                         // Text to display
-                text_br                              // Brush settings
-            );
-        }
-        else {
-            std::string center_info = "Level " + std::to_string(m_level_number) +
-                "   |   Time left: " + std::to_string(static_cast<int>(m_level_timer / 10));
-            graphics::drawText(
-                CANVAS_WIDTH / 2.0f - 100.0f,        // X position (centered horizontally)
-                30.0f,                               // Y position
-                20.0f,                               // Font size
-                center_info,                         // Text to display
-                text_br                              // Brush settings
-            );
-        }
-        
-        // 3. Draw P2 Score on the Right
-        std::string p2_info = "P2 Score: " + std::to_string(m_player2_score);
-        graphics::drawText(
-            CANVAS_WIDTH - 115.0f,               // X position (right margin)
-            30.0f,                               // Y position
-            20.0f,                               // Font size
-            p2_info,                             // Text to display
-            text_br                              // Brush settings
-        );
+        // Draw Level Information (scores and timer); lines are only reformatted when a value changes
+        PROFILE_ZONE("Level::draw HUD");
+        m_hud.setText(m_hud_p1, "P1 Score: %d", m_sim.getScore(1));
+        if (m_sim.getLevelDef().time_limit <= 0.0f)
+            m_hud.setText(m_hud_center, "Level %d   |   Time left: N/A", m_level_number);
+        else
+            m_hud.setText(m_hud_center, "Level %d   |   Time left: %d", m_level_number, static_cast<int>(m_sim.getLevelTimer() / 10));
+        m_hud.setText(m_hud_p2, "P2 Score: %d", m_sim.getScore(2));
+        m_hud.draw(list);
         break;
     }
 
     case LevelState::GAME_OVER: {
         // 1. Draw the Background Rectangle Covering the Entire Canvas
-        graphics::drawRect(
+        list.drawRect(
+            DrawLayer::BACKGROUND,
             CANVAS_WIDTH / 2.0f,    // X position (centered horizontally)
             CANVAS_HEIGHT / 2.0f,   // Y position (centered vertically)
             CANVAS_WIDTH,            // Width of the rectangle
@@ -1144,198 +360,249 @@ void Level::draw() const
             m_bg_brush               // Brush with texture and opacity
         );
 
-        // 2. Draw Game Over Screen with Winner Information
-        graphics::Brush br;
-        br.outline_opacity = 0.0f; // No outline
-
-        std::string winner_text;
-        std::string sudden_death_text;
-
-        if (m_winner == 1)
+        // 2. Draw Game Over Screen with the winner in their color
+        BrushHandle br = m_text_brush;
+        if (m_sim.getWinner() == 1)
         {
-            br.fill_color[0] = 0.0f; // Blue color for Player1
-            br.fill_color[1] = 0.0f;
-            br.fill_color[2] = 1.0f;
-            winner_text = "Player 1 Wins!";
-
-            // Check if the win was through Sudden Death
-            if (m_level_number == 4)
-            {
-                sudden_death_text = "(In Sudden Death)";
-            }
+            br = m_p1_brush;
+            m_game_over_hud.setText(m_hud_winner, "Player 1 Wins!");
         }
-        else if (m_winner == 2)
+        else if (m_sim.getWinner() == 2)
         {
-            br.fill_color[0] = 1.0f; // Red color for Player2
-            br.fill_color[1] = 0.0f;
-            br.fill_color[2] = 0.0f;
-            winner_text = "Player 2 Wins!";
-
-            // Check if the win was through Sudden Death
-            if (m_level_number == 4)
-            {
-                sudden_death_text = "(In Sudden Death)";
-            }
+            br = m_p2_brush;
+            m_game_over_hud.setText(m_hud_winner, "Player 2 Wins!");
         }
         else
         {
-            br.fill_color[0] = 1.0f; // Default color
-            br.fill_color[1] = 1.0f;
-            br.fill_color[2] = 1.0f;
-            winner_text = "Game Over";
-            // No Sudden Death text needed
+            m_game_over_hud.setText(m_hud_winner, "Game Over");
         }
+        m_game_over_hud.setBrush(m_hud_winner, br);
 
-        // Draw the Winner Text at the Center of the Screen
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 140.0f, // X position (adjusted for centering)
-            CANVAS_HEIGHT / 2.0f - 50.0f, // Y position (placed higher on the screen)
-            50.0f,                         // Font size for the winner text
-            winner_text,                   // Text to display
-            br                             // Brush settings for the text
-        );
-
-        // 3. Draw "In Sudden Death!" Text
-        if (!sudden_death_text.empty())
-        {
-            graphics::drawText(
-                CANVAS_WIDTH / 2.0f - 100.0f,  // X position (adjusted for centering)
-                CANVAS_HEIGHT / 2.0f - 10.0f, // Y position (placed below the winner text)
-                30.0f,                         // Font size for Sudden Death text
-                sudden_death_text,             // Text to display
-                br                             // Brush settings for the text
-            );
-        }
-
-        // 4. Display Final Scores Below the Winner Text
-        std::string final_score = "Final Scores - P1: " + std::to_string(m_player1_score) +
-            " | P2: " + std::to_string(m_player2_score);
-        graphics::Brush score_br;
-        score_br.fill_color[0] = 1.0f;
-        score_br.fill_color[1] = 1.0f;
-        score_br.fill_color[2] = 1.0f;
-        score_br.outline_opacity = 0.0f;
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 148.0f, // X position (centered horizontally)
-            CANVAS_HEIGHT / 2.0f + 30.0f,  // Y position (placed below the winner text)
-            30.0f,                         // Font size for the final scores
-            final_score,                   // Text to display
-            score_br                       // Brush settings for the text
-        );
-
-        // 5. Add Replay Instruction Below Final Scores
-        std::string replay_info = "Press R to Replay the Game";
-        graphics::Brush replay_br;
-        replay_br.fill_color[0] = 1.0f; // White color
-        replay_br.fill_color[1] = 1.0f;
-        replay_br.fill_color[2] = 1.0f;
-        replay_br.outline_opacity = 0.0f;
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 168.0f, // X position (centered horizontally)
-            CANVAS_HEIGHT / 2.0f + 70.0f, // Y position (placed below final scores)
-            30.0f,                        // Font size
-            replay_info,                  // Text to display
-            replay_br                     // Brush settings
-        );
+        // 3. "(In Sudden Death)" below the winner if the match was won in Sudden Death
+        m_game_over_hud.setBrush(m_hud_sudden_death, br);
+        m_game_over_hud.setVisible(m_hud_sudden_death, m_sim.getWinner() != 0 && m_sim.getLevelDef().sudden_death);
 
+        // 4. Final scores below, followed by the replay instruction
+        m_game_over_hud.setText(m_hud_final_score, "Final Scores - P1: %d | P2: %d", m_sim.getScore(1), m_sim.getScore(2));
+        m_game_over_hud.draw(list);
         break;
     }
-        
     }
-    
 }
 
 /**
- * @brief Checks if it's time to advance to the next level based on the timer.
+ * @brief Checks if it's time to advance to the next level.
  *
- * Monitors the level timer and triggers progression to the next level when the time expires.
+ * The simulation reports the level as over when the level timer expires or the match has a winner.
  */
 void Level::checkLevelProgression()
 {
-    // If time is up, proceed to next level
-    if (m_level_timer <= 0.0f)
+    if (m_sim.isLevelOver())
     {
         nextLevel();
     }
 }
 
 /**
- * @brief Moves to the next level or transitions to Sudden Death based on current progress.
+ * @brief Crossfades to the music of the current state. Gameplay plays the track named by the
+ * level's definition. Asking for the track that already plays keeps it playing.
+ */
+void Level::playStateMusic()
+{
+    MusicId track = MusicId::COUNT;
+    switch (m_level_state)
+    {
+    case LevelState::MAIN_MENU:
+        track = MusicId::TITLE_SCREEN;
+        break;
+    case LevelState::ACTIVE:
+        track = MusicManager::findTrack(m_sim.getLevelDef().music);
+        break;
+    case LevelState::PAUSE_MENU:
+        track = MusicId::READY_SCREEN;
+        break;
+    case LevelState::GAME_OVER:
+        track = MusicId::GAME_OVER;
+        break;
+    }
+    MusicManager::getInstance().play(track);
+}
+
+/**
+ * @brief Moves to the next level, to Sudden Death, or to the Game Over screen.
  *
- * Advances the game to the subsequent level if applicable. After completing level 3,
- * checks player scores to determine if Sudden Death should be initiated or if a player has won.
+ * The simulation decides the outcome of the level; this method handles the presentation:
+ * menus and music.
  */
 void Level::nextLevel()
 {
-    if (m_level_number < 3)
+    const ObstacleStore& obstacles = m_sim.getObstacles();
+    const PowerupStore& powerups = m_sim.getPowerups();
+    LOG_INFO("Level {} ended: {} obstacles and {} powerups removed in {} compactions, {} and {} left.", m_level_number,
+        obstacles.counts.removed, powerups.counts.removed, obstacles.counts.compactions + powerups.counts.compactions,
+        obstacles.size(), powerups.size());
+
+    int next_level = m_sim.resolveLevelEnd();
+
+    // The match ends with a winner, or starts over from the Main Menu
+    if (next_level == 0 || next_level == 1)
     {
-        // Advance to the next level and initialize it with the menu
-        m_level_number++;
-        init(m_level_number, true); // Show Pause Menu for Level 2 and 3
-        std::cout << "Advancing to Level " << m_level_number << ".\n";
+        finishRecording();
     }
-    else if (m_level_number == 3)
-    {
-        // After completing level 3, evaluate scores to determine the winner or start Sudden Death
-        if (m_player1_score > m_player2_score)
-        {
-            // Player 1 wins the game
-            m_winner = 1;
-            m_level_state = LevelState::GAME_OVER;
 
-            // Stop any currently playing music and switch to the game over soundtrack immediately
-            if (m_background_music)
-            {
-                m_background_music->stop();
-            }
-            m_background_music = std::make_unique<Music>(GameState::getInstance(), "GameOverMusic", "game_over.mp3", 0.7f, false, false);
-            if (m_background_music)
-            {
-                m_background_music->play();
-            }
+    if (next_level == 0)
+    {
+        // The match has a winner
+        m_level_state = LevelState::GAME_OVER;
 
-            std::cout << "Player 1 wins with score " << m_player1_score
-                << " to " << m_player2_score << ".\n";
-        }
-        else if (m_player2_score > m_player1_score)
-        {
-            // Player 2 wins the game
-            m_winner = 2;
-            m_level_state = LevelState::GAME_OVER;
+        // Crossfade to the game over soundtrack
+        playStateMusic();
 
-            // Stop any currently playing music and switch to the game over soundtrack immediately
-            if (m_background_music)
-            {
-                m_background_music->stop();
-            }
-            m_background_music = std::make_unique<Music>(GameState::getInstance(), "GameOverMusic", "game_over.mp3", 0.7f, false, false);
-            if (m_background_music)
-            {
-                m_background_music->play();
-            }
+        int winner = m_sim.getWinner();
+        LOG_INFO("Player {} wins with score {} to {}.", winner, m_sim.getScore(winner), m_sim.getScore(winner == 1 ? 2 : 1));
+    }
+    else
+    {
+        // Advance and show the Pause Menu (or the Main Menu when starting over)
+        m_level_number = next_level;
+        init(m_level_number, true);
 
-            std::cout << "Player 2 wins with score " << m_player2_score
-                << " to " << m_player1_score << ".\n";
-        }
+        if (m_sim.getLevelDef().sudden_death)
+            LOG_INFO("Scores tied. Advancing to Level {}: Sudden Death.", m_level_number);
         else
-        {
-            // Scores are equal, start sudden death
-            m_level_number = 4;
-            init(m_level_number, true); // Show Pause Menu or Ready Menu for Sudden Death
-            std::cout << "Scores tied. Advancing to Level 4: Sudden Death.\n";
-        }
+            LOG_INFO("Advancing to Level {}.", m_level_number);
+    }
+}
+
+/**
+ * @brief Starts a new match with a fresh seed and starts recording its replay.
+ *
+ * Level 1 is reloaded after reseeding, so the whole match follows from the recorded seed.
+ */
+void Level::startMatch()
+{
+    uint32_t seed = std::random_device{}();
+    m_sim.seed(seed);
+    m_recorder.begin(seed, m_sim.getConfig(), m_sim.getLevels());
+
+    setupLevelObjects(1);
+}
+
+/**
+ * @brief Ends the replay recording of the current match, if any, and saves it next to the game.
+ */
+void Level::finishRecording()
+{
+    if (!m_recorder.isRecording())
+        return;
+
+    const Replay& replay = m_recorder.finish(m_sim.getStateHash());
+    std::string path = "match_" + std::to_string(replay.seed) + ".pongrec";
+    if (saveReplay(path, replay))
+    {
+        LOG_INFO("Replay saved to {} ({} ticks, {} input bytes).", path, replay.tick_count, replay.inputs.size());
     }
     else
     {
-        // After Level 4: Reset the game by displaying the Main Menu
+        LOG_WARNING("Failed to save replay {}.", path);
+    }
+}
 
-        // Reset the level number to 1 to prepare for a new game
-        m_level_number = 1;
+/**
+ * @brief Copies the paddle and ball state of the simulation to their display objects.
+ *
+ * Obstacles and powerups have no display objects; they are drawn straight from the
+ * simulation's stores.
+ */
+void Level::syncObjects()
+{
+    // Players
+    m_player1->setY(m_sim.getPaddle(1).y);
+    m_player2->setY(m_sim.getPaddle(2).y);
+
+    // Ball
+    const SimBall& ball = m_sim.getBall();
+    m_ball->setX(ball.x);
+    m_ball->setY(ball.y);
+    m_ball->setWidth(ball.width);
+    m_ball->setHeight(ball.height);
+    m_ball->setSpeed(ball.speed);
+    m_ball->setSpeed_x(ball.speed_x);
+    m_ball->setSpeed_y(ball.speed_y);
+    m_ball->setRampingUp(ball.ramping_up);
+    m_ball->setActivePowerup(ball.powerup_active);
+}
 
-        // Initialize Level 1 with the Main Menu
-        init(m_level_number, true); // Show Main Menu for Level 1
+#if PONG_LOG_LEVEL <= 1
+/**
+ * @brief Retrieves the log name of an obstacle type. Logged with the slot of the handle + 1 after
+ * it, so no string is built while playing.
+ */
+static const char* getObstacleName(const ObstacleStore& obstacles, EntityHandle handle)
+{
+    // Only breakable obstacles are removed, so a handle that no longer resolves was one
+    int index = obstacles.find(handle);
+    bool breakable = index < 0 || obstacles.type[index] == Obstacle::Type::Breakable;
+    return breakable ? "BreakableObstacle" : "UnbreakableObstacle";
+}
+#endif
 
-        std::cout << "Sudden Death completed. Returning to Main Menu.\n";
+/**
+ * @brief Plays sounds and logs the gameplay events raised by the last simulation advance.
+ */
+void Level::handleSimulationEvents()
+{
+    for (const SimEvent& event : m_sim.getEvents())
+    {
+        switch (event.type)
+        {
+        case SimEventType::PADDLE_HIT:
+            LOG_DEBUG("Ball collided with Player {} paddle.", event.player);
+            AudioBank::getInstance().play(SoundId::PADDLE_HIT);
+            m_ai1.reaim();
+            m_ai2.reaim();
+            break;
+
+        case SimEventType::OBSTACLE_HIT:
+            LOG_DEBUG("Ball collided with obstacle '{}{}'.", getObstacleName(m_sim.getObstacles(), event.handle),
+                getEntitySlot(event.handle) + 1);
+            AudioBank::getInstance().play(SoundId::PADDLE_HIT);
+            break;
+
+        case SimEventType::OBSTACLE_BROKEN:
+            if (event.player != 0)
+                LOG_DEBUG("Player {} broke obstacle '{}{}'. Score: {}", event.player,
+                    getObstacleName(m_sim.getObstacles(), event.handle), getEntitySlot(event.handle) + 1, m_sim.getScore(event.player));
+            else
+                LOG_DEBUG("Obstacle '{}{}' broken with no player interaction.",
+                    getObstacleName(m_sim.getObstacles(), event.handle), getEntitySlot(event.handle) + 1);
+            break;
+
+        case SimEventType::OBSTACLE_SPAWNED:
+            LOG_DEBUG("Spawned obstacle '{}{}'.", getObstacleName(m_sim.getObstacles(), event.handle), getEntitySlot(event.handle) + 1);
+            break;
+
+        case SimEventType::POWERUP_SPAWNED:
+            LOG_DEBUG("Spawned powerup 'Powerup{}'.", getEntitySlot(event.handle) + 1);
+            break;
+
+        case SimEventType::POWERUP_COLLECTED:
+            LOG_DEBUG("Ball collided with powerup 'Powerup{}'. Speed Multiplier: {}", getEntitySlot(event.handle) + 1, m_sim.getSpeedMultiplier());
+            AudioBank::getInstance().play(SoundId::POWERUP);
+            break;
+
+        case SimEventType::POWERUP_EXPIRED:
+            LOG_DEBUG("Powerup effect expired.");
+            break;
+
+        case SimEventType::SCORED:
+            LOG_DEBUG("Scores - Player1: {}, Player2: {}", m_sim.getScore(1), m_sim.getScore(2));
+            m_ai1.reaim();
+            m_ai2.reaim();
+            break;
+
+        case SimEventType::WALL_BOUNCE:
+            break;
+        }
     }
 }
-
@@ -2,13 +2,19 @@
 
 #include <vector>
 #include <memory>
-#include "Player.h"
-#include "Ball.h"
-#include "Obstacle.h"
-#include "Powerup.h"
-#include "Music.h"
-#include "Menu.h"
-#include "GameObject.h"
+#include <random>
+#include "player.h"
+#include "ball.h"
+#include "obstacle.h"
+#include "powerup.h"
+#include "menu.h"
+#include "simulation.h"
+#include "brushcache.h"
+#include "hud.h"
+#include "replay.h"
+#include "paddleai.h"
+#include "objectpool.h"
+#include "gameobject.h"
 #include "config.h"
 #include "sgg/graphics.h"
 
@@ -20,77 +26,43 @@
 class Level
 {
 private:
-    // Current level number (1-4)
+    // Current level number
     int m_level_number = 1;
 
-    // Timer for each level (1 minute = 600.0f seconds)
-    float m_level_timer = 300.0f;
+    // Headless gameplay engine owning all game rules, scores and object state
+    Simulation m_sim{ std::random_device{}() };
 
-    // Powerup spawning variables
-    float m_elapsed_time;                     // Tracks elapsed time since level start
-    float m_next_powerup_spawn_time;          // Time at which the next powerup should spawn
-    int m_total_powerups_to_spawn;            // Total number of powerups to spawn in the level
-    int m_powerups_spawned;                   // Number of powerups that have been spawned so far
-    int m_next_breakable_obstacle_spawn_time_level4; // Time at which the next obstacle should spawn in Level 4
-	float m_speed_multiplier; 			 // Speed multiplier to track active powerups affecting the ball's speed
+    // Records the seed and per-tick input of the current match
+    ReplayRecorder m_recorder;
 
-    std::vector<std::pair<float, float>> m_powerup_spawn_positions; // Predefined spawn positions for powerups
+    // Storage of the players and the ball, cleared and refilled by every level without heap traffic
+    ObjectPool<Player, 2> m_player_pool;
+    ObjectPool<Ball, 1> m_ball_pool;
 
-    // Spawn Boundaries for Level 4 (Sudden Death)
-    // Define minimum and maximum X and Y coordinates for spawning obstacles and powerups
-    float m_obstacle_spawn_min_x = 250.0f;
-    float m_obstacle_spawn_max_x = CANVAS_WIDTH - 250.0f;
-    float m_obstacle_spawn_min_y = 200.0f;
-    float m_obstacle_spawn_max_y = CANVAS_HEIGHT - 250.0f;
-
-    float m_powerup_spawn_min_x = 200.0f;
-    float m_powerup_spawn_max_x = CANVAS_WIDTH - 200.0f;
-    float m_powerup_spawn_min_y = 200.0f;
-    float m_powerup_spawn_max_y = CANVAS_HEIGHT - 200.0f;
-
-    // Maximum counts
-    static const int MAX_UNBREAKABLE_OBSTACLES = 2;
-	static const int MAX_BREAKABLE_OBSTACLES = 3;
-    static const int MAX_POWERUPS = 5;
-
-    // Counters to track spawned obstacles and powerups in Level 4
-    int m_obstacles_spawned_level4 = 0;
-    int m_unbreakable_obstacles_spawned_level4 = 0;
-    int m_breakable_obstacles_spawned_level4 = 0;
-    int m_powerups_spawned_level4 = 0;
-
-    // Next spawn times for obstacles and powerups in Level 4
-    float m_next_obstacle_spawn_time_level4 = 0.0f;
-    float m_next_powerup_spawn_time_level4 = 0.0f;
-
-    // Each player has its own score to determine who wins in the end
-    int m_player1_score = 0;
-    int m_player2_score = 0;
-
-    // Define which player destroyed the obstacle
-    int m_last_player_to_hit = 0; // 0: none, 1: Player1, 2: Player2
-
-	// Winner of the match (0 = no winner yet, 1 = player 1, 2 = player 2)
-    int m_winner = 0;
-
-    // Players
-    std::unique_ptr<Player> m_player1;
-    std::unique_ptr<Player> m_player2;
+    // Players (display objects mirroring the simulation state)
+    Player* m_player1 = nullptr;
+    Player* m_player2 = nullptr;
 
     // Ball
-    std::unique_ptr<Ball> m_ball;
-
-    // Obstacles and Powerups
-    std::vector<std::unique_ptr<Obstacle>> m_obstacles;
-    std::vector<std::unique_ptr<Powerup>> m_powerups;
-
-    // Background Brush
-    graphics::Brush m_bg_brush;
-
-    // Music and Sound Effects
-	std::unique_ptr<Music> m_background_music;
-	std::unique_ptr<Music> m_paddle_hit_sound;
-	std::unique_ptr<Music> m_powerup_sound;
+    Ball* m_ball = nullptr;
+
+    // Computer controllers, used instead of the keys for the players the Main Menu hands to the computer
+    PaddleAI m_ai1{ std::random_device{}() };
+    PaddleAI m_ai2{ std::random_device{}() };
+    bool m_computer_player1 = false;
+    bool m_computer_player2 = false;
+
+    // Brushes of the background and the text
+    BrushHandle m_bg_brush = 0;
+    BrushHandle m_text_brush = 0;       // White
+    BrushHandle m_p1_brush = 0;         // Blue winner text of Player 1
+    BrushHandle m_p2_brush = 0;         // Red winner text of Player 2
+
+    // Text of the gameplay HUD and the game over screen, reformatted by draw() when values change
+    mutable Hud m_hud;
+    size_t m_hud_p1 = 0, m_hud_center = 0, m_hud_p2 = 0;
+    mutable Hud m_game_over_hud;
+    size_t m_hud_winner = 0, m_hud_sudden_death = 0, m_hud_final_score = 0;
 
     // Menu
 	std::unique_ptr<Menu> m_menu;
@@ -110,11 +82,16 @@ private:
     LevelState m_level_state = LevelState::MAIN_MENU; ///< Current state within the level.
 
     /**
-     * @brief Sets up the game objects specific to a given level (1-4).
+     * @brief Sets up the game objects specific to a given level.
      * @param level_number The level number to set up.
      */
     void setupLevelObjects(int level_number);
 
+    /**
+     * @brief Crossfades to the track of the current state's playlist.
+     */
+    void playStateMusic();
+
     /**
      * @brief Checks if it's time to advance to the next level based on timer or player lives.
      */
@@ -125,6 +102,26 @@ private:
      */
     void nextLevel();
 
+    /**
+     * @brief Copies the paddle and ball state of the simulation to their display objects.
+     */
+    void syncObjects();
+
+    /**
+     * @brief Plays sounds and logs the gameplay events raised by the last simulation advance.
+     */
+    void handleSimulationEvents();
+
+    /**
+     * @brief Reseeds the simulation, reloads Level 1 and starts recording the match replay.
+     */
+    void startMatch();
+
+    /**
+     * @brief Saves the replay of the current match, if one is being recorded.
+     */
+    void finishRecording();
+
 public:
     /**
      * @brief Initializes the level: sets up players, ball, obstacles, powerups
@@ -134,16 +131,17 @@ public:
     void init(int level_number = 1, bool show_menu = true);
 
     /**
-     * @brief Updates all objects in the level, checks for collisions, and
-     *        handles timer / lives logic to proceed to next level.
-     * @param dt Time elapsed since the last update in seconds.
+     * @brief Handles menus, feeds paddle input to the simulation and advances it,
+     *        and proceeds to the next level when the current one is over.
+     * @param dt Time elapsed since the last update in milliseconds.
      */
     void update(float dt);
 
     /**
-     * @brief Draws all level objects (players, ball, obstacles, powerups) and background.
+     * @brief Records the draw commands of all level objects (players, ball, obstacles, powerups) and background.
+     * @param list Draw list of the frame.
      */
-    void draw() const;
+    void draw(DrawList& list) const;
 
     /**
      * @brief Retrieves the current level number.
@@ -151,37 +149,28 @@ public:
      */
     int getLevelNumber() const { return m_level_number; }
 
+    /**
+     * @brief Checks if the level is in active gameplay (no menu or game over screen).
+     */
+    bool isPlaying() const { return m_level_state == LevelState::ACTIVE; }
+
     /**
     * @brief Retrieves the first player object.
     * @return Pointer to the first Player.
     */
-    Player* getPlayer1() const { return m_player1.get(); }
+    Player* getPlayer1() const { return m_player1; }
 
     /**
      * @brief Retrieves the second player object.
      * @return Pointer to the second Player.
      */
-    Player* getPlayer2() const { return m_player2.get(); }
+    Player* getPlayer2() const { return m_player2; }
 
     /**
      * @brief Retrieves the ball object.
      * @return Pointer to the Ball.
      */
-    Ball* getBall() const { return m_ball.get(); }
-
-    /**
-    * @brief Generates a random float between min and max.
-    * @param min The minimum value.
-    * @param max The maximum value.
-    * @return A random float within [min, max].
-    */
-    float getRandomFloat(float min, float max)
-    {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> dist(min, max);
-        return dist(gen);
-    }
+    Ball* getBall() const { return m_ball; }
 
     /**
      * @brief Destructor for the Level class.
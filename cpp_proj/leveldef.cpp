@@ -0,0 +1,743 @@
+#include "leveldef.h"
+#include "assetarchive.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// File header of the compiled form: magic and format version
+static const char LEVELS_MAGIC[4] = { 'P', 'L', 'V', 'L' };
+static const uint32_t LEVELS_VERSION = 1;
+
+// Type names of the text format, indexed by Obstacle::Type and Powerup::Type
+static const char* const OBSTACLE_TYPES[] = { "breakable", "unbreakable" };
+static const char* const POWERUP_TYPES[] = { "speed_up", "slow_down", "increase_size", "decrease_size" };
+static const uint8_t OBSTACLE_TYPE_COUNT = 2;
+static const uint8_t POWERUP_TYPE_COUNT = 4;
+
+// Most whitespace-separated tokens on one line
+static const size_t MAX_TOKENS = 16;
+
+// The levels of the original game; assets/levels.txt ships the same definitions for editing
+static const char DEFAULT_LEVELS[] =
+    "level 1\n"
+    "time_limit 30\n"
+    "reset_scores\n"
+    "next_level 2\n"
+    "music level_1.mp3\n"
+    "\n"
+    "level 2\n"
+    "time_limit 30\n"
+    "next_level 3\n"
+    "music level_2.mp3\n"
+    "obstacle breakable 450 700 2 0\n"
+    "obstacle breakable 450 250 2 0\n"
+    "powerup_schedule 5 2 5\n"
+    "powerup speed_up 300 300\n"
+    "powerup slow_down 600 300\n"
+    "powerup speed_up 400 500\n"
+    "powerup slow_down 500 200\n"
+    "\n"
+    "level 3\n"
+    "time_limit 30\n"
+    "next_level 0\n"
+    "tie_level 4\n"
+    "music level_3.mp3\n"
+    "obstacle breakable 400 700 2 0\n"
+    "obstacle breakable 500 250 2 0\n"
+    "obstacle unbreakable 350 300 0 0.5\n"
+    "obstacle unbreakable 550 700 0 0.5\n"
+    "powerup_schedule 5 2 5\n"
+    "powerup increase_size 500 500\n"
+    "powerup decrease_size 700 200\n"
+    "powerup speed_up 200 600\n"
+    "powerup slow_down 400 400\n"
+    "\n"
+    "level 4\n"
+    "reset_scores\n"
+    "sudden_death\n"
+    "win_score 10\n"
+    "next_level 1\n"
+    "music level_4.mp3\n"
+    "spawn obstacle unbreakable hit_points=0 speed=0.5 limit=2 total=2 first=2 interval=2,5 area=250,200,650,650\n"
+    "spawn obstacle breakable hit_points=2 speed=0 limit=3 first=4 interval=2,5 area=250,200,650,650\n"
+    "spawn powerup types=slow_down,increase_size,decrease_size,slow_down limit=5 first=3 interval=2,5 "
+    "area=200,200,700,700 min_distance=100\n";
+
+namespace
+{
+    /**
+     * @struct Token
+     * @brief A word of a line of the text format, pointing into the text.
+     */
+    struct Token
+    {
+        const char* data;
+        size_t size;
+
+        bool operator==(const char* word) const
+        {
+            return std::strlen(word) == size && std::memcmp(data, word, size) == 0;
+        }
+    };
+
+    /**
+     * @brief Splits a token at the first occurrence of a separator.
+     * @return False if the token does not contain it.
+     */
+    bool splitToken(const Token& token, char separator, Token& head, Token& tail)
+    {
+        const char* at = static_cast<const char*>(std::memchr(token.data, separator, token.size));
+        if (!at)
+            return false;
+        head = { token.data, static_cast<size_t>(at - token.data) };
+        tail = { at + 1, token.size - head.size - 1 };
+        return true;
+    }
+
+    bool parseFloat(const Token& token, float& value)
+    {
+        char buffer[32];
+        if (token.size == 0 || token.size >= sizeof(buffer))
+            return false;
+        std::memcpy(buffer, token.data, token.size);
+        buffer[token.size] = '\0';
+        char* end;
+        value = std::strtof(buffer, &end);
+        return end == buffer + token.size;
+    }
+
+    bool parseInt(const Token& token, int32_t& value)
+    {
+        char buffer[16];
+        if (token.size == 0 || token.size >= sizeof(buffer))
+            return false;
+        std::memcpy(buffer, token.data, token.size);
+        buffer[token.size] = '\0';
+        char* end;
+        long parsed = std::strtol(buffer, &end, 10);
+        value = static_cast<int32_t>(parsed);
+        return end == buffer + token.size && parsed == value;
+    }
+
+    /**
+     * @brief Parses a comma-separated list of exactly count floats.
+     */
+    bool parseFloats(Token token, float* values, size_t count)
+    {
+        for (size_t i = 0; i + 1 < count; i++)
+        {
+            Token head;
+            if (!splitToken(token, ',', head, token) || !parseFloat(head, values[i]))
+                return false;
+        }
+        return parseFloat(token, values[count - 1]);
+    }
+
+    /**
+     * @brief Looks up a type name in a table of names.
+     */
+    bool parseType(const Token& token, const char* const* names, uint8_t count, uint8_t& type)
+    {
+        for (uint8_t i = 0; i < count; i++)
+        {
+            if (token == names[i])
+            {
+                type = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Parses the key=value settings of a spawn statement.
+     * @return An empty string on success, otherwise the error.
+     */
+    std::string parseSpawner(const Token* tokens, size_t count, LevelSpawner& spawner)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            Token key, value;
+            if (!splitToken(tokens[i], '=', key, value))
+                return "expected key=value";
+
+            bool valid;
+            if (key == "limit")
+                valid = parseInt(value, spawner.limit);
+            else if (key == "total")
+                valid = parseInt(value, spawner.total_limit);
+            else if (key == "first")
+                valid = parseFloat(value, spawner.first_time);
+            else if (key == "interval")
+            {
+                float range[2] = {};
+                valid = parseFloats(value, range, 2);
+                spawner.interval_min = range[0];
+                spawner.interval_max = range[1];
+            }
+            else if (key == "area")
+            {
+                float area[4] = {};
+                valid = parseFloats(value, area, 4);
+                spawner.min_x = area[0];
+                spawner.min_y = area[1];
+                spawner.max_x = area[2];
+                spawner.max_y = area[3];
+            }
+            else if (key == "min_distance")
+                valid = parseFloat(value, spawner.min_distance);
+            else if (key == "hit_points" && spawner.kind == LevelSpawner::Kind::OBSTACLE)
+                valid = parseInt(value, spawner.hit_points);
+            else if (key == "speed" && spawner.kind == LevelSpawner::Kind::OBSTACLE)
+                valid = parseFloat(value, spawner.speed);
+            else if (key == "types" && spawner.kind == LevelSpawner::Kind::POWERUP)
+            {
+                spawner.powerup_types.clear();
+                Token type;
+                valid = true;
+                while (valid && splitToken(value, ',', type, value))
+                {
+                    spawner.powerup_types.push_back(0);
+                    valid = parseType(type, POWERUP_TYPES, POWERUP_TYPE_COUNT, spawner.powerup_types.back());
+                }
+                spawner.powerup_types.push_back(0);
+                valid = valid && parseType(value, POWERUP_TYPES, POWERUP_TYPE_COUNT, spawner.powerup_types.back());
+            }
+            else
+                return "unknown setting " + std::string(key.data, key.size);
+
+            if (!valid)
+                return "invalid value for " + std::string(key.data, key.size);
+        }
+        return std::string();
+    }
+
+    /**
+     * @brief Checks the values that the simulation relies on.
+     * @return An empty string if the levels are valid, otherwise the first error.
+     */
+    std::string validate(const std::vector<LevelDef>& levels)
+    {
+        if (levels.empty())
+            return "no levels";
+
+        auto exists = [&](int number)
+        {
+            return std::any_of(levels.begin(), levels.end(), [number](const LevelDef& level) { return level.number == number; });
+        };
+
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            const LevelDef& level = levels[i];
+            std::string name = "level " + std::to_string(level.number) + ": ";
+            if (level.number <= 0)
+                return name + "level numbers start at 1";
+            for (size_t j = 0; j < i; j++)
+            {
+                if (levels[j].number == level.number)
+                    return name + "defined twice";
+            }
+            if (level.time_limit < 0.0f || level.win_score < 0)
+                return name + "negative time limit or win score";
+            if ((level.next_level != 0 && !exists(level.next_level)) || (level.tie_level != 0 && !exists(level.tie_level)))
+                return name + "next or tie level does not exist";
+            if (level.powerup_interval_min > level.powerup_interval_max)
+                return name + "powerup interval is inverted";
+
+            for (uint8_t type : level.obstacle_type)
+            {
+                if (type >= OBSTACLE_TYPE_COUNT)
+                    return name + "unknown obstacle type";
+            }
+            for (uint8_t type : level.powerup_type)
+            {
+                if (type >= POWERUP_TYPE_COUNT)
+                    return name + "unknown powerup type";
+            }
+
+            for (const LevelSpawner& spawner : level.spawners)
+            {
+                if (spawner.kind == LevelSpawner::Kind::OBSTACLE && spawner.obstacle_type >= OBSTACLE_TYPE_COUNT)
+                    return name + "unknown obstacle type";
+                if (spawner.kind == LevelSpawner::Kind::POWERUP && spawner.powerup_types.empty())
+                    return name + "powerup spawner without types";
+                for (uint8_t type : spawner.powerup_types)
+                {
+                    if (type >= POWERUP_TYPE_COUNT)
+                        return name + "unknown powerup type";
+                }
+                if (spawner.limit < 0 || spawner.total_limit < 0 || spawner.min_distance < 0.0f)
+                    return name + "negative spawner limit or distance";
+                if (spawner.interval_min > spawner.interval_max || spawner.min_x > spawner.max_x || spawner.min_y > spawner.max_y)
+                    return name + "spawner interval or area is inverted";
+            }
+        }
+        return std::string();
+    }
+
+    /**
+     * @brief Appends a fixed-size little-endian integer.
+     */
+    template <typename T>
+    void writeFixed(std::vector<uint8_t>& out, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /**
+     * @brief Reads a fixed-size little-endian integer.
+     * @return False if the value would extend past the end.
+     */
+    template <typename T>
+    bool readFixed(const uint8_t* data, size_t size, size_t& offset, T& value)
+    {
+        if (size < offset || size - offset < sizeof(T))
+            return false;
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            value |= static_cast<T>(data[offset++]) << (8 * i);
+        }
+        return true;
+    }
+
+    void writeValue(std::vector<uint8_t>& out, uint8_t value) { out.push_back(value); }
+    void writeValue(std::vector<uint8_t>& out, int32_t value) { writeFixed(out, static_cast<uint32_t>(value)); }
+
+    void writeValue(std::vector<uint8_t>& out, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeFixed(out, bits);
+    }
+
+    bool readValue(const uint8_t* data, size_t size, size_t& offset, uint8_t& value)
+    {
+        return readFixed(data, size, offset, value);
+    }
+
+    bool readValue(const uint8_t* data, size_t size, size_t& offset, int32_t& value)
+    {
+        uint32_t bits;
+        if (!readFixed(data, size, offset, bits))
+            return false;
+        value = static_cast<int32_t>(bits);
+        return true;
+    }
+
+    bool readValue(const uint8_t* data, size_t size, size_t& offset, float& value)
+    {
+        uint32_t bits;
+        if (!readFixed(data, size, offset, bits))
+            return false;
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    template <typename T>
+    void writeArray(std::vector<uint8_t>& out, const std::vector<T>& values)
+    {
+        for (T value : values)
+        {
+            writeValue(out, value);
+        }
+    }
+
+    /**
+     * @brief Reads count values into an array, after checking that the data holds them all.
+     */
+    template <typename T>
+    bool readArray(const uint8_t* data, size_t size, size_t& offset, size_t count, std::vector<T>& values)
+    {
+        if (size < offset || (size - offset) / sizeof(T) < count)
+            return false;
+        values.resize(count);
+        for (T& value : values)
+        {
+            readValue(data, size, offset, value);
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Retrieves a level by number.
+ *
+ * @param number The level number.
+ * @return The level, or nullptr if the set has no such level.
+ */
+const LevelDef* LevelSet::find(int number) const
+{
+    for (const LevelDef& level : m_levels)
+    {
+        if (level.number == number)
+            return &level;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Replaces the levels with those of a level text file.
+ *
+ * The text is parsed in place, one line at a time; only the level arrays are allocated.
+ *
+ * @param text Contents of the file.
+ * @param size Length of the contents.
+ * @param error Receives the line number and description of the first error.
+ * @return False if the text is invalid; the set is left unchanged.
+ */
+bool LevelSet::parse(const char* text, size_t size, std::string& error)
+{
+    std::vector<LevelDef> levels;
+    const char* const end = text + size;
+    int line_number = 0;
+
+    for (const char* line = text; line < end; )
+    {
+        const char* line_end = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        if (!line_end)
+            line_end = end;
+        line_number++;
+
+        // Split the line into tokens, stopping at a comment
+        Token tokens[MAX_TOKENS];
+        size_t count = 0;
+        const char* at = line;
+        while (at < line_end && *at != '#')
+        {
+            if (*at == ' ' || *at == '\t' || *at == '\r')
+            {
+                at++;
+                continue;
+            }
+            const char* start = at;
+            while (at < line_end && *at != ' ' && *at != '\t' && *at != '\r' && *at != '#')
+                at++;
+            if (count == MAX_TOKENS)
+            {
+                count++;
+                break;
+            }
+            tokens[count++] = { start, static_cast<size_t>(at - start) };
+        }
+        line = line_end + 1;
+
+        if (count == 0)
+            continue;
+
+        std::string problem;
+        const Token& keyword = tokens[0];
+        LevelDef* level = levels.empty() ? nullptr : &levels.back();
+
+        if (count > MAX_TOKENS)
+            problem = "too many words";
+        else if (keyword == "level")
+        {
+            levels.emplace_back();
+            if (count != 2 || !parseInt(tokens[1], levels.back().number))
+                problem = "expected level NUMBER";
+        }
+        else if (!level)
+            problem = "statement before the first level";
+        else if (keyword == "time_limit")
+        {
+            if (count != 2 || !parseFloat(tokens[1], level->time_limit))
+                problem = "expected time_limit SECONDS";
+        }
+        else if (keyword == "reset_scores" && count == 1)
+            level->reset_scores = true;
+        else if (keyword == "sudden_death" && count == 1)
+            level->sudden_death = true;
+        else if (keyword == "win_score")
+        {
+            if (count != 2 || !parseInt(tokens[1], level->win_score))
+                problem = "expected win_score POINTS";
+        }
+        else if (keyword == "next_level")
+        {
+            if (count != 2 || !parseInt(tokens[1], level->next_level))
+                problem = "expected next_level NUMBER";
+        }
+        else if (keyword == "tie_level")
+        {
+            if (count != 2 || !parseInt(tokens[1], level->tie_level))
+                problem = "expected tie_level NUMBER";
+        }
+        else if (keyword == "music")
+        {
+            if (count == 2)
+                level->music.assign(tokens[1].data, tokens[1].size);
+            else
+                problem = "expected music FILE";
+        }
+        else if (keyword == "obstacle")
+        {
+            uint8_t type;
+            float x, y, speed;
+            int32_t hit_points;
+            if (count != 6 || !parseType(tokens[1], OBSTACLE_TYPES, OBSTACLE_TYPE_COUNT, type) ||
+                !parseFloat(tokens[2], x) || !parseFloat(tokens[3], y) ||
+                !parseInt(tokens[4], hit_points) || !parseFloat(tokens[5], speed))
+            {
+                problem = "expected obstacle TYPE X Y HIT_POINTS SPEED";
+            }
+            else
+            {
+                level->obstacle_type.push_back(type);
+                level->obstacle_x.push_back(x);
+                level->obstacle_y.push_back(y);
+                level->obstacle_hit_points.push_back(hit_points);
+                level->obstacle_speed.push_back(speed);
+            }
+        }
+        else if (keyword == "powerup")
+        {
+            uint8_t type;
+            float x, y;
+            if (count != 4 || !parseType(tokens[1], POWERUP_TYPES, POWERUP_TYPE_COUNT, type) ||
+                !parseFloat(tokens[2], x) || !parseFloat(tokens[3], y))
+            {
+                problem = "expected powerup TYPE X Y";
+            }
+            else
+            {
+                level->powerup_type.push_back(type);
+                level->powerup_x.push_back(x);
+                level->powerup_y.push_back(y);
+            }
+        }
+        else if (keyword == "powerup_schedule")
+        {
+            if (count != 4 || !parseFloat(tokens[1], level->powerup_first_time) ||
+                !parseFloat(tokens[2], level->powerup_interval_min) || !parseFloat(tokens[3], level->powerup_interval_max))
+            {
+                problem = "expected powerup_schedule FIRST MIN MAX";
+            }
+        }
+        else if (keyword == "spawn" && count >= 2)
+        {
+            LevelSpawner spawner;
+            size_t settings = 2;
+            if (tokens[1] == "obstacle" && count >= 3 &&
+                parseType(tokens[2], OBSTACLE_TYPES, OBSTACLE_TYPE_COUNT, spawner.obstacle_type))
+            {
+                spawner.kind = LevelSpawner::Kind::OBSTACLE;
+                settings = 3;
+            }
+            else if (tokens[1] == "powerup")
+                spawner.kind = LevelSpawner::Kind::POWERUP;
+            else
+                problem = "expected spawn obstacle TYPE ... or spawn powerup ...";
+
+            if (problem.empty())
+                problem = parseSpawner(tokens + settings, count - settings, spawner);
+            if (problem.empty())
+                level->spawners.push_back(std::move(spawner));
+        }
+        else
+            problem = "unknown statement " + std::string(keyword.data, keyword.size);
+
+        if (!problem.empty())
+        {
+            error = "line " + std::to_string(line_number) + ": " + problem;
+            return false;
+        }
+    }
+
+    error = validate(levels);
+    if (!error.empty())
+        return false;
+
+    m_levels.swap(levels);
+    return true;
+}
+
+/**
+ * @brief Compiles the levels into the binary form read by load().
+ *
+ * @return The contents of the compiled file.
+ */
+std::vector<uint8_t> LevelSet::save() const
+{
+    std::vector<uint8_t> out(LEVELS_MAGIC, LEVELS_MAGIC + sizeof(LEVELS_MAGIC));
+    writeFixed(out, LEVELS_VERSION);
+    writeFixed(out, static_cast<uint32_t>(m_levels.size()));
+
+    for (const LevelDef& level : m_levels)
+    {
+        writeValue(out, level.number);
+        writeValue(out, level.time_limit);
+        writeValue(out, static_cast<uint8_t>((level.reset_scores ? 1 : 0) | (level.sudden_death ? 2 : 0)));
+        writeValue(out, level.win_score);
+        writeValue(out, level.next_level);
+        writeValue(out, level.tie_level);
+        writeFixed(out, static_cast<uint16_t>(level.music.size()));
+        out.insert(out.end(), level.music.begin(), level.music.end());
+
+        writeFixed(out, static_cast<uint32_t>(level.obstacle_type.size()));
+        writeArray(out, level.obstacle_type);
+        writeArray(out, level.obstacle_x);
+        writeArray(out, level.obstacle_y);
+        writeArray(out, level.obstacle_hit_points);
+        writeArray(out, level.obstacle_speed);
+
+        writeValue(out, level.powerup_first_time);
+        writeValue(out, level.powerup_interval_min);
+        writeValue(out, level.powerup_interval_max);
+        writeFixed(out, static_cast<uint32_t>(level.powerup_type.size()));
+        writeArray(out, level.powerup_type);
+        writeArray(out, level.powerup_x);
+        writeArray(out, level.powerup_y);
+
+        writeFixed(out, static_cast<uint32_t>(level.spawners.size()));
+        for (const LevelSpawner& spawner : level.spawners)
+        {
+            writeValue(out, static_cast<uint8_t>(spawner.kind));
+            writeValue(out, spawner.obstacle_type);
+            writeValue(out, spawner.hit_points);
+            writeValue(out, spawner.speed);
+            writeValue(out, spawner.limit);
+            writeValue(out, spawner.total_limit);
+            writeValue(out, spawner.first_time);
+            writeValue(out, spawner.interval_min);
+            writeValue(out, spawner.interval_max);
+            writeValue(out, spawner.min_x);
+            writeValue(out, spawner.min_y);
+            writeValue(out, spawner.max_x);
+            writeValue(out, spawner.max_y);
+            writeValue(out, spawner.min_distance);
+            writeValue(out, static_cast<uint8_t>(spawner.powerup_types.size()));
+            writeArray(out, spawner.powerup_types);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Replaces the levels with those of a compiled level file.
+ *
+ * @param data Contents of the file.
+ * @param size Length of the contents.
+ * @param error Receives a description of the failure.
+ * @return False if the data is invalid; the set is left unchanged.
+ */
+bool LevelSet::load(const uint8_t* data, size_t size, std::string& error)
+{
+    uint32_t version, level_count;
+    size_t offset = sizeof(LEVELS_MAGIC);
+    if (size < offset || std::memcmp(data, LEVELS_MAGIC, sizeof(LEVELS_MAGIC)) != 0 ||
+        !readFixed(data, size, offset, version) || version != LEVELS_VERSION ||
+        !readFixed(data, size, offset, level_count))
+    {
+        error = "not a compiled level file of version " + std::to_string(LEVELS_VERSION);
+        return false;
+    }
+
+    std::vector<LevelDef> levels;
+    bool valid = true;
+    for (uint32_t i = 0; valid && i < level_count; i++)
+    {
+        levels.emplace_back();
+        LevelDef& level = levels.back();
+        uint8_t flags;
+        uint16_t music_size;
+        uint32_t count;
+
+        valid = readValue(data, size, offset, level.number) &&
+            readValue(data, size, offset, level.time_limit) &&
+            readValue(data, size, offset, flags) &&
+            readValue(data, size, offset, level.win_score) &&
+            readValue(data, size, offset, level.next_level) &&
+            readValue(data, size, offset, level.tie_level) &&
+            readFixed(data, size, offset, music_size) && size - offset >= music_size;
+        if (!valid)
+            break;
+        level.reset_scores = (flags & 1) != 0;
+        level.sudden_death = (flags & 2) != 0;
+        level.music.assign(reinterpret_cast<const char*>(data + offset), music_size);
+        offset += music_size;
+
+        valid = readFixed(data, size, offset, count) &&
+            readArray(data, size, offset, count, level.obstacle_type) &&
+            readArray(data, size, offset, count, level.obstacle_x) &&
+            readArray(data, size, offset, count, level.obstacle_y) &&
+            readArray(data, size, offset, count, level.obstacle_hit_points) &&
+            readArray(data, size, offset, count, level.obstacle_speed) &&
+            readValue(data, size, offset, level.powerup_first_time) &&
+            readValue(data, size, offset, level.powerup_interval_min) &&
+            readValue(data, size, offset, level.powerup_interval_max) &&
+            readFixed(data, size, offset, count) &&
+            readArray(data, size, offset, count, level.powerup_type) &&
+            readArray(data, size, offset, count, level.powerup_x) &&
+            readArray(data, size, offset, count, level.powerup_y) &&
+            readFixed(data, size, offset, count);
+
+        for (uint32_t j = 0; valid && j < count; j++)
+        {
+            level.spawners.emplace_back();
+            LevelSpawner& spawner = level.spawners.back();
+            uint8_t kind = 0, type_count = 0;
+            valid = readValue(data, size, offset, kind) && kind <= static_cast<uint8_t>(LevelSpawner::Kind::POWERUP) &&
+                readValue(data, size, offset, spawner.obstacle_type) &&
+                readValue(data, size, offset, spawner.hit_points) &&
+                readValue(data, size, offset, spawner.speed) &&
+                readValue(data, size, offset, spawner.limit) &&
+                readValue(data, size, offset, spawner.total_limit) &&
+                readValue(data, size, offset, spawner.first_time) &&
+                readValue(data, size, offset, spawner.interval_min) &&
+                readValue(data, size, offset, spawner.interval_max) &&
+                readValue(data, size, offset, spawner.min_x) &&
+                readValue(data, size, offset, spawner.min_y) &&
+                readValue(data, size, offset, spawner.max_x) &&
+                readValue(data, size, offset, spawner.max_y) &&
+                readValue(data, size, offset, spawner.min_distance) &&
+                readValue(data, size, offset, type_count) &&
+                readArray(data, size, offset, type_count, spawner.powerup_types);
+            spawner.kind = static_cast<LevelSpawner::Kind>(kind);
+        }
+    }
+
+    if (!valid)
+    {
+        error = "compiled level file is truncated or corrupt";
+        return false;
+    }
+    error = validate(levels);
+    if (!error.empty())
+        return false;
+
+    m_levels.swap(levels);
+    return true;
+}
+
+/**
+ * @brief Computes a hash of the compiled levels: the FNV-1a hash an asset archive records for
+ * levels.bin, so equal sets hash equal whether read from text or from the binary.
+ *
+ * @return The hash of save().
+ */
+uint64_t LevelSet::getHash() const
+{
+    std::vector<uint8_t> data = save();
+    return AssetArchive::hashData(data.data(), data.size());
+}
+
+/**
+ * @brief Retrieves the built-in levels, parsed from DEFAULT_LEVELS on first use.
+ *
+ * @return The levels of the original game.
+ */
+const LevelSet& LevelSet::getDefault()
+{
+    static const LevelSet levels = []
+    {
+        LevelSet set;
+        std::string error;
+        set.parse(DEFAULT_LEVELS, sizeof(DEFAULT_LEVELS) - 1, error);
+        return set;
+    }();
+    return levels;
+}
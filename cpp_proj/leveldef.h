@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Level file designers edit, and the name its compiled form is packed under in the asset archive
+const char* const LEVELS_TEXT_ASSET = "levels.txt";
+const char* const LEVELS_BINARY_ASSET = "levels.bin";
+
+/**
+ * @struct LevelSpawner
+ * @brief Spawns obstacles or powerups at random positions while a level runs.
+ *
+ * The first object appears at first_time; each later one a random interval after the previous.
+ * A spawner stops after limit objects, or once the spawners of its kind have spawned total_limit
+ * objects together.
+ */
+struct LevelSpawner
+{
+    enum class Kind : uint8_t { OBSTACLE, POWERUP };
+
+    Kind kind = Kind::OBSTACLE;
+    uint8_t obstacle_type = 0;          ///< Obstacle::Type of the spawned obstacles.
+    int32_t hit_points = 0;             ///< Hit points of the spawned obstacles.
+    float speed = 0.0f;                 ///< Vertical speed of the spawned obstacles.
+    std::vector<uint8_t> powerup_types; ///< Powerup::Type of the spawned powerups, cycled in order.
+
+    int32_t limit = 0;                  ///< Objects this spawner spawns at most.
+    int32_t total_limit = 0;            ///< Objects all spawners of this kind spawn at most (0: no limit).
+    float first_time = 0.0f;            ///< Seconds into the level of the first spawn.
+    float interval_min = 0.0f;          ///< Range of the random time to the next spawn, in seconds.
+    float interval_max = 0.0f;
+    float min_x = 0.0f;                 ///< Area the spawn positions are drawn from.
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+    float min_distance = 0.0f;          ///< Distance kept from existing objects; a spawn too close is retried next tick.
+};
+
+/**
+ * @struct LevelDef
+ * @brief Layout and rules of one level. Obstacles and powerups are kept in flat arrays, one entry
+ * per object.
+ */
+struct LevelDef
+{
+    int32_t number = 0;
+    float time_limit = 0.0f;            ///< Length of the level in seconds (0: no time limit).
+    bool reset_scores = false;          ///< Both scores start from 0.
+    bool sudden_death = false;          ///< Faster ball, and the SPEED_UP powerup has no effect.
+    int32_t win_score = 0;              ///< Score that wins the match at once (0: none).
+    int32_t next_level = 0;             ///< Level loaded when the time runs out (0: the higher score wins).
+    int32_t tie_level = 0;              ///< Level loaded when the scores are tied and next_level is 0.
+    std::string music;                  ///< Music track played during the level.
+
+    // Obstacles present from the start
+    std::vector<uint8_t> obstacle_type;
+    std::vector<float> obstacle_x;
+    std::vector<float> obstacle_y;
+    std::vector<int32_t> obstacle_hit_points;
+    std::vector<float> obstacle_speed;
+
+    // Powerups spawned one after another at fixed positions
+    float powerup_first_time = 0.0f;    ///< Seconds into the level of the first powerup.
+    float powerup_interval_min = 0.0f;  ///< Range of the random time between two powerups, in seconds.
+    float powerup_interval_max = 0.0f;
+    std::vector<uint8_t> powerup_type;
+    std::vector<float> powerup_x;
+    std::vector<float> powerup_y;
+
+    std::vector<LevelSpawner> spawners;
+};
+
+/**
+ * @class LevelSet
+ * @brief The levels of a match, read from a text file designers edit or from its compiled binary
+ * form.
+ *
+ * The text format has one statement per line; '#' starts a comment. A "level N" line opens a level
+ * and the lines up to the next one describe it (see assets/levels.txt). The binary form holds the
+ * same fields as fixed-size little-endian values and loads without any text parsing.
+ */
+class LevelSet
+{
+public:
+    /**
+     * @brief Retrieves a level by number.
+     * @return The level, or nullptr if the set has no such level.
+     */
+    const LevelDef* find(int number) const;
+
+    /**
+     * @brief Retrieves every level, in the order they were defined.
+     */
+    const std::vector<LevelDef>& getLevels() const { return m_levels; }
+
+    /**
+     * @brief Replaces the levels with those of a level text file.
+     * @param text Contents of the file.
+     * @param size Length of the contents.
+     * @param error Receives the line number and description of the first error.
+     * @return False if the text is invalid; the set is left unchanged.
+     */
+    bool parse(const char* text, size_t size, std::string& error);
+
+    /**
+     * @brief Replaces the levels with those of a compiled level file.
+     * @param data Contents of the file.
+     * @param size Length of the contents.
+     * @param error Receives a description of the failure.
+     * @return False if the data is invalid; the set is left unchanged.
+     */
+    bool load(const uint8_t* data, size_t size, std::string& error);
+
+    /**
+     * @brief Compiles the levels into the binary form read by load().
+     */
+    std::vector<uint8_t> save() const;
+
+    /**
+     * @brief Computes a hash of the compiled levels, telling level sets apart (e.g. in replays).
+     */
+    uint64_t getHash() const;
+
+    /**
+     * @brief Retrieves the built-in levels, used when no level file is available.
+     */
+    static const LevelSet& getDefault();
+
+private:
+    std::vector<LevelDef> m_levels;
+};
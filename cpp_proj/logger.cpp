@@ -0,0 +1,260 @@
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+/**
+ * @brief Claims the next argument slot. Arguments beyond MAX_ARGS are ignored.
+ */
+LogArg& LogRecord::next(LogArg::Type type)
+{
+    LogArg& arg = args[arg_count];
+    if (arg_count < MAX_ARGS)
+        arg_count++;
+    arg.type = type;
+    return arg;
+}
+
+/**
+ * @brief Copies a string argument into the record, truncated to the space left.
+ */
+void LogRecord::addText(const char* value, size_t length)
+{
+    length = std::min(length, TEXT_SIZE - text_used);
+    LogArg& arg = next(LogArg::Type::TEXT);
+    arg.text.offset = text_used;
+    arg.text.length = static_cast<uint16_t>(length);
+    std::memcpy(text + text_used, value, length);
+    text_used = static_cast<uint16_t>(text_used + length);
+}
+
+static const char* getLevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace: return "trace";
+    case LogLevel::Debug: return "debug";
+    case LogLevel::Info: return "info";
+    case LogLevel::Warning: return "warning";
+    default: return "error";
+    }
+}
+
+/**
+ * @brief Formats a record as one line: time in seconds, level, message.
+ */
+static void formatRecord(const LogRecord& record, std::string& line)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "[%9.3f] [%s] ", record.time_us / 1e6, getLevelName(record.level));
+    line = buffer;
+
+    int arg_index = 0;
+    for (const char* c = record.format; *c; c++)
+    {
+        if (c[0] != '{' || c[1] != '}' || arg_index >= record.arg_count)
+        {
+            line += *c;
+            continue;
+        }
+
+        const LogArg& arg = record.args[arg_index++];
+        switch (arg.type)
+        {
+        case LogArg::Type::INT: line += std::to_string(arg.i); break;
+        case LogArg::Type::UINT: line += std::to_string(arg.u); break;
+        case LogArg::Type::BOOL: line += arg.b ? "true" : "false"; break;
+        case LogArg::Type::TEXT: line.append(record.text + arg.text.offset, arg.text.length); break;
+        case LogArg::Type::FLOAT:
+            std::snprintf(buffer, sizeof(buffer), "%g", arg.f); // Same as the default std::ostream format
+            line += buffer;
+            break;
+        }
+        c++; // Skip the closing brace
+    }
+    line += '\n';
+}
+
+/**
+ * @brief Retrieves the singleton instance.
+ *
+ * @return The logger.
+ */
+Logger& Logger::getInstance()
+{
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger()
+    : m_slots(new Slot[CAPACITY]),
+    m_start(std::chrono::steady_clock::now())
+{
+    for (size_t i = 0; i < CAPACITY; i++)
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Stops the background thread, writing any pending messages.
+ */
+Logger::~Logger()
+{
+    stop();
+}
+
+uint64_t Logger::getTime() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - m_start).count());
+}
+
+/**
+ * @brief Starts the background thread. Does nothing if it already runs.
+ */
+void Logger::start()
+{
+    if (m_running.exchange(true))
+        return;
+    m_thread = std::thread(&Logger::run, this);
+}
+
+/**
+ * @brief Writes all pending messages and stops the background thread. Later messages are
+ * written synchronously.
+ *
+ * Messages pushed from other threads while stopping are rejected and reported as dropped; those
+ * already being queued are waited for, so none is left behind in the buffer.
+ */
+void Logger::stop()
+{
+    if (!m_running.load(std::memory_order_acquire))
+        return;
+
+    m_stopping.store(true);
+    m_running.store(false);
+    m_thread.join();
+    while (m_pushing.load() != 0)
+        std::this_thread::yield();
+    drain();
+
+    m_stopping.store(false);
+    drain(); // Reports the messages rejected during the last drain
+}
+
+/**
+ * @brief Queues a record for the background thread, or writes it right away if the thread does
+ * not run.
+ *
+ * Producers claim a slot by advancing the head with a compare-and-swap, then publish the record
+ * through the slot's sequence number (bounded MPMC ring buffer). A producer is counted in
+ * m_pushing from before it checks the flags until it has published, so stop() either sees it or
+ * it sees the stopping flag.
+ */
+void Logger::push(const LogRecord& record)
+{
+    m_pushing.fetch_add(1);
+    if (m_stopping.load())
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_pushing.fetch_sub(1);
+        return;
+    }
+
+    if (!m_running.load(std::memory_order_acquire))
+    {
+        m_pushing.fetch_sub(1);
+        std::string line;
+        formatRecord(record, line);
+        std::lock_guard<std::mutex> lock(m_output_mutex);
+        std::cout << line;
+        return;
+    }
+
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;)
+    {
+        slot = &m_slots[pos & (CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Full: the background thread has not caught up
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            m_pushing.fetch_sub(1);
+            return;
+        }
+        else
+        {
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->record = record;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    m_pushing.fetch_sub(1);
+}
+
+/**
+ * @brief Takes the oldest published record. Only called by the thread that drains the buffer.
+ *
+ * @return False if no record is ready.
+ */
+bool Logger::pop(LogRecord& record)
+{
+    Slot& slot = m_slots[m_tail & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1)
+        return false;
+
+    record = slot.record;
+    slot.sequence.store(m_tail + CAPACITY, std::memory_order_release);
+    m_tail++;
+    return true;
+}
+
+/**
+ * @brief Formats and writes every queued record, with one flush for the whole batch.
+ */
+void Logger::drain()
+{
+    LogRecord record;
+    std::string line, batch;
+    while (pop(record))
+    {
+        formatRecord(record, line);
+        batch += line;
+    }
+
+    uint64_t dropped = getDroppedCount();
+    if (dropped != m_reported_dropped)
+    {
+        batch += "[logger] " + std::to_string(dropped - m_reported_dropped) + " messages dropped (buffer full or stopping)\n";
+        m_reported_dropped = dropped;
+    }
+
+    if (!batch.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_output_mutex);
+        std::cout << batch << std::flush;
+    }
+}
+
+/**
+ * @brief Background thread: drains the buffer every millisecond until stopped.
+ */
+void Logger::run()
+{
+    while (m_running.load(std::memory_order_acquire))
+    {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @enum LogLevel
+ * @brief Severity of a log message, from most to least verbose.
+ */
+enum class LogLevel : uint8_t
+{
+    Trace,      ///< Per-frame details (music refreshes).
+    Debug,      ///< Per-event gameplay details (collisions, spawns).
+    Info,       ///< State changes (levels, menus, replays).
+    Warning,    ///< Recoverable problems.
+    Error       ///< Failures.
+};
+
+/**
+ * @brief Compile-time log threshold: LOG_* calls below it compile to nothing, arguments included.
+ * 0 = Trace, 1 = Debug, 2 = Info, 3 = Warning, 4 = Error, 5 = off.
+ * Defaults to Debug in debug builds and Info in release builds.
+ */
+#ifndef PONG_LOG_LEVEL
+#ifdef NDEBUG
+#define PONG_LOG_LEVEL 2
+#else
+#define PONG_LOG_LEVEL 1
+#endif
+#endif
+
+/**
+ * @struct LogArg
+ * @brief A single argument of a log record, stored as plain data.
+ */
+struct LogArg
+{
+    enum class Type : uint8_t { INT, UINT, FLOAT, BOOL, TEXT };
+
+    Type type;
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double f;
+        bool b;
+        struct
+        {
+            uint16_t offset;    // Offset of the text in LogRecord::text
+            uint16_t length;
+        } text;
+    };
+};
+
+/**
+ * @struct LogRecord
+ * @brief Binary log message: format string and raw arguments, formatted later by the logging thread.
+ */
+struct LogRecord
+{
+    static const int MAX_ARGS = 8;
+    static const size_t TEXT_SIZE = 128;
+
+    const char* format = nullptr;   // String literal with one {} per argument
+    uint64_t time_us = 0;           // Time of the call since the logger was created
+    LogLevel level = LogLevel::Info;
+    uint8_t arg_count = 0;
+    uint16_t text_used = 0;
+    LogArg args[MAX_ARGS + 1];      // The last entry absorbs arguments beyond MAX_ARGS
+    char text[TEXT_SIZE];           // Copies of the string arguments (truncated if too long)
+
+    void add(bool value) { LogArg& a = next(LogArg::Type::BOOL); a.b = value; }
+    void add(char value) { addText(&value, 1); }
+    void add(int value) { addInt(value); }
+    void add(long value) { addInt(value); }
+    void add(long long value) { addInt(value); }
+    void add(unsigned value) { addUint(value); }
+    void add(unsigned long value) { addUint(value); }
+    void add(unsigned long long value) { addUint(value); }
+    void add(float value) { add(static_cast<double>(value)); }
+    void add(double value) { LogArg& a = next(LogArg::Type::FLOAT); a.f = value; }
+    void add(const char* value) { addText(value ? value : "(null)", std::strlen(value ? value : "(null)")); }
+    void add(const std::string& value) { addText(value.data(), value.size()); }
+
+private:
+    LogArg& next(LogArg::Type type);
+    void addInt(int64_t value) { LogArg& a = next(LogArg::Type::INT); a.i = value; }
+    void addUint(uint64_t value) { LogArg& a = next(LogArg::Type::UINT); a.u = value; }
+    void addText(const char* value, size_t length);
+};
+
+/**
+ * @class Logger
+ * @brief Asynchronous logger. Game code packs messages into binary records and pushes them into a
+ * lock-free ring buffer; a background thread formats and writes them to stdout, so logging never
+ * blocks on console output.
+ *
+ * Until start() is called (and after stop()) messages are formatted and written synchronously.
+ * When the buffer is full, or while stop() writes the last messages, messages are dropped and
+ * counted rather than blocking the caller.
+ */
+class Logger
+{
+public:
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static Logger& getInstance();
+
+    ~Logger();
+
+    /**
+     * @brief Starts the background thread.
+     */
+    void start();
+
+    /**
+     * @brief Writes all pending messages and stops the background thread.
+     */
+    void stop();
+
+    /**
+     * @brief Logs a message. Prefer the LOG_* macros, which remove calls below PONG_LOG_LEVEL.
+     *
+     * @param level Severity of the message.
+     * @param format String literal; each {} is replaced by the next argument.
+     * @param args Up to LogRecord::MAX_ARGS numbers, bools or strings.
+     */
+    template <typename... Args>
+    void write(LogLevel level, const char* format, const Args&... args)
+    {
+        LogRecord record;
+        record.format = format;
+        record.level = level;
+        record.time_us = getTime();
+        int expand[] = { 0, (record.add(args), 0)... };
+        (void)expand;
+        push(record);
+    }
+
+    /**
+     * @brief Number of messages dropped because the buffer was full or the logger was stopping.
+     */
+    uint64_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    static const size_t CAPACITY = 1024;   // Records in the ring buffer (power of two)
+
+    /**
+     * @struct Slot
+     * @brief Ring buffer entry. The sequence number tells producers and the consumer whose turn it is.
+     */
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<size_t> m_head{ 0 };        // Next slot to write (producers)
+    size_t m_tail = 0;                      // Next slot to read (background thread only)
+    std::atomic<uint64_t> m_dropped{ 0 };
+    uint64_t m_reported_dropped = 0;
+
+    std::atomic<bool> m_running{ false };
+    std::atomic<bool> m_stopping{ false };  // Set by stop() until the last records are written
+    std::atomic<int> m_pushing{ 0 };        // Producers between their check of the flags and publishing
+    std::thread m_thread;
+    std::mutex m_output_mutex;              // Serializes synchronous writes with the background thread
+    std::chrono::steady_clock::time_point m_start;
+
+    uint64_t getTime() const;
+    void push(const LogRecord& record);
+    bool pop(LogRecord& record);
+    void drain();
+    void run();
+};
+
+#define PONG_LOG(level, ...) Logger::getInstance().write(level, __VA_ARGS__)
+
+#if PONG_LOG_LEVEL <= 0
+#define LOG_TRACE(...) PONG_LOG(LogLevel::Trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if PONG_LOG_LEVEL <= 1
+#define LOG_DEBUG(...) PONG_LOG(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if PONG_LOG_LEVEL <= 2
+#define LOG_INFO(...) PONG_LOG(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if PONG_LOG_LEVEL <= 3
+#define LOG_WARNING(...) PONG_LOG(LogLevel::Warning, __VA_ARGS__)
+#else
+#define LOG_WARNING(...) ((void)0)
+#endif
+
+#if PONG_LOG_LEVEL <= 4
+#define LOG_ERROR(...) PONG_LOG(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
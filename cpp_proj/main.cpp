@@ -1,10 +1,11 @@
 // main.cpp
-#include "GameState.h"
+#include "gamestate.h"
 #include <sgg/graphics.h>
 #include <memory>
 #include <string>
+#include <cstdlib>
 #include "config.h"
-#include <iostream>
+#include "logger.h"
 
 /**
  * @brief Draw callback function.
@@ -33,6 +34,9 @@ void update(float dt)
 
 int main()
 {
+    // Console output is written by the logging thread, off the game loop
+    Logger::getInstance().start();
+
     // Initialize game window with canvas size 900x900
     graphics::createWindow(900, 900, "Advanced Pong");
 
@@ -49,10 +53,21 @@ int main()
     // Start the game loop
     graphics::startMessageLoop();
 
+    // Soak runs set PONG_REQUIRE_NO_ALLOCATIONS=1 to fail if any gameplay frame touched the heap
+    int exit_code = 0;
+    const char* require_no_allocations = std::getenv("PONG_REQUIRE_NO_ALLOCATIONS");
+    uint64_t allocations = GameState::getInstance()->getGameplayAllocations();
+    if (require_no_allocations && std::atoi(require_no_allocations) != 0 && allocations > 0)
+    {
+        LOG_ERROR("{} heap allocations during gameplay.", allocations);
+        exit_code = 1;
+    }
+
     // Cleanup (optional, depending on implementation)
     // Currently, the Singleton instance is not deleted automatically
     GameState::getInstance()->releaseInstance();
 
     graphics::destroyWindow();
-    return 0;
+    Logger::getInstance().stop();
+    return exit_code;
 }
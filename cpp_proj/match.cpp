@@ -0,0 +1,191 @@
+#include "match.h"
+#include "profiler.h"
+
+/**
+ * @brief Constructs a new MatchBot and draws its first aiming error.
+ *
+ * @param seed Seed of the bot's aiming errors.
+ * @param max_error Maximum aiming error in either direction, in canvas units.
+ */
+MatchBot::MatchBot(uint32_t seed, float max_error)
+    : m_rng(seed),
+    m_max_error(max_error)
+{
+    reaim();
+}
+
+/**
+ * @brief Draws a new aiming error, uniformly in [-max_error, max_error].
+ */
+void MatchBot::reaim()
+{
+    std::uniform_real_distribution<float> dist(-m_max_error, m_max_error);
+    m_aim_error = dist(m_rng);
+}
+
+/**
+ * @brief Computes the bot's input for one tick.
+ *
+ * The paddle follows the ball (plus the aiming error) while the ball approaches it, and returns
+ * to the center of the canvas otherwise.
+ *
+ * @param sim The simulation being played.
+ * @param player The paddle controlled by the bot (1 or 2).
+ * @return The paddle input.
+ */
+PaddleInput MatchBot::getInput(const Simulation& sim, int player) const
+{
+    const SimPaddle& paddle = sim.getPaddle(player);
+    const SimBall& ball = sim.getBall();
+
+    bool approaching = (player == 1) ? ball.speed_x < 0.0f : ball.speed_x > 0.0f;
+    float target = approaching ? ball.y + m_aim_error : CANVAS_HEIGHT / 2.0f;
+
+    // Dead zone of one tick of paddle movement avoids jittering around the target
+    const float dead_zone = paddle.speed * sim.getTickMs();
+
+    PaddleInput input;
+    input.up = paddle.y > target + dead_zone;
+    input.down = paddle.y < target - dead_zone;
+    return input;
+}
+
+/**
+ * @brief Input of a MatchBot for one tick.
+ */
+static PaddleInput getBotInput(const MatchBot& bot, const Simulation& sim, int player)
+{
+    return bot.getInput(sim, player);
+}
+
+/**
+ * @brief Input of a PaddleAI for one tick.
+ */
+static PaddleInput getBotInput(PaddleAI& bot, const Simulation& sim, int player)
+{
+    return bot.getInput(sim, player, sim.getTickMs());
+}
+
+/**
+ * @brief Plays a full match between two bots of the same kind without any window.
+ *
+ * Levels follow the same progression rules as the game: Levels 1-3 in order, then Sudden Death
+ * if the scores are tied. Rally lengths are counted as paddle hits between two points.
+ *
+ * @param sim The simulation, seeded and at Level 1.
+ * @param bot1 Bot of Player 1.
+ * @param bot2 Bot of Player 2.
+ * @param max_ticks Tick limit after which the match is abandoned without a winner.
+ * @param recorder Optional recorder receiving the replay of the match.
+ * @param result Receives the outcome and statistics of the match.
+ */
+template <typename Bot>
+static void playMatch(Simulation& sim, Bot& bot1, Bot& bot2, uint64_t max_ticks, ReplayRecorder* recorder,
+    MatchResult& result)
+{
+    int rally = 0;
+    while (result.ticks < max_ticks)
+    {
+        // Every tick is a profiler frame when profiling a single match
+        PROFILE_FRAME();
+
+        if (sim.isLevelOver())
+        {
+            int next_level = sim.resolveLevelEnd();
+            if (next_level == 0)
+                break;
+            sim.loadLevel(next_level);
+            if (recorder)
+                recorder->recordLevelLoad(next_level);
+            rally = 0;
+        }
+
+        SimInput input;
+        input.player1 = getBotInput(bot1, sim, 1);
+        input.player2 = getBotInput(bot2, sim, 2);
+
+        sim.clearEvents();
+        sim.tick(input);
+        result.ticks++;
+        if (recorder)
+            recorder->record(input);
+
+        for (const SimEvent& event : sim.getEvents())
+        {
+            if (event.type == SimEventType::PADDLE_HIT)
+            {
+                rally++;
+                bot1.reaim();
+                bot2.reaim();
+            }
+            else if (event.type == SimEventType::SCORED)
+            {
+                result.points++;
+                result.paddle_hits += rally;
+                if (rally > result.longest_rally)
+                    result.longest_rally = rally;
+                rally = 0;
+                bot1.reaim();
+                bot2.reaim();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Plays a full match between two MatchBots, or two PaddleAIs if ai is given, without
+ * any window.
+ *
+ * @param seed Seed of the simulation and the bots.
+ * @param config Gameplay constants to use.
+ * @param max_ticks Tick limit after which the match is abandoned without a winner.
+ * @param recorder Optional recorder receiving the replay of the match.
+ * @param ai Skill of both PaddleAIs, or nullptr for MatchBots.
+ * @param levels Level definitions of the match, or nullptr for the built-in levels.
+ * @return The result of the match.
+ */
+MatchResult runMatch(uint32_t seed, const SimConfig& config, uint64_t max_ticks, ReplayRecorder* recorder,
+    const PaddleAIConfig* ai, const LevelSet* levels)
+{
+    MatchResult result;
+    result.seed = seed;
+
+    Simulation sim(seed, config);
+    if (levels)
+    {
+        // Level 1 of the given set, right after seeding like the constructor does
+        sim.setLevels(*levels);
+        sim.seed(seed);
+        sim.loadLevel(1);
+    }
+
+    if (recorder)
+    {
+        // Level 1 was loaded right after seeding
+        recorder->begin(seed, config, sim.getLevels());
+        recorder->recordLevelLoad(1);
+    }
+
+    if (ai)
+    {
+        PaddleAI bot1(seed ^ 0x9E3779B9u, *ai);
+        PaddleAI bot2(seed ^ 0x7F4A7C15u, *ai);
+        playMatch(sim, bot1, bot2, max_ticks, recorder, result);
+    }
+    else
+    {
+        MatchBot bot1(seed ^ 0x9E3779B9u);
+        MatchBot bot2(seed ^ 0x7F4A7C15u);
+        playMatch(sim, bot1, bot2, max_ticks, recorder, result);
+    }
+
+    if (recorder)
+        recorder->finish(sim.getStateHash());
+
+    result.tick_ms = sim.getTickMs();
+    result.winner = sim.getWinner();
+    result.final_level = sim.getLevelNumber();
+    result.score1 = sim.getScore(1);
+    result.score2 = sim.getScore(2);
+    return result;
+}
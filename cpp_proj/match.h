@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include "simulation.h"
+#include "replay.h"
+#include "paddleai.h"
+
+/**
+ * @struct MatchResult
+ * @brief Outcome and statistics of one full unattended match (Levels 1-3 and Sudden Death if tied).
+ */
+struct MatchResult
+{
+    uint32_t seed = 0;          ///< Seed the match was played with.
+    int winner = 0;             ///< 1 or 2, or 0 if the match hit the tick limit.
+    int final_level = 1;        ///< Level in which the match ended.
+    int score1 = 0;             ///< Final score of Player 1 in the last level played.
+    int score2 = 0;             ///< Final score of Player 2 in the last level played.
+    uint64_t ticks = 0;         ///< Total number of simulated ticks.
+    float tick_ms = 0.0f;       ///< Duration of one tick in ms.
+    int points = 0;             ///< Number of points scored over the whole match.
+    int paddle_hits = 0;        ///< Number of paddle hits in rallies that ended with a point.
+    int longest_rally = 0;      ///< Most paddle hits in a single rally.
+
+    /**
+     * @brief Retrieves the duration of the match in game seconds.
+     */
+    double getDuration() const { return ticks * static_cast<double>(tick_ms) / 1000.0; }
+};
+
+/**
+ * @class MatchBot
+ * @brief Simple scripted paddle controller for unattended matches: follows the ball with a random
+ * aiming error that is redrawn after every bounce and serve, so rallies eventually end.
+ */
+class MatchBot
+{
+private:
+    std::mt19937 m_rng;
+    float m_aim_error = 0.0f;   // Offset from the ball's y the paddle currently aims for
+    float m_max_error;          // Maximum aiming error in either direction
+
+public:
+    /**
+     * @brief Creates a bot.
+     * @param seed Seed of the bot's aiming errors.
+     * @param max_error Maximum aiming error in either direction, in canvas units.
+     */
+    MatchBot(uint32_t seed, float max_error = 45.0f);
+
+    /**
+     * @brief Draws a new aiming error.
+     */
+    void reaim();
+
+    /**
+     * @brief Computes the bot's input for one tick.
+     * @param sim The simulation being played.
+     * @param player The paddle controlled by the bot (1 or 2).
+     */
+    PaddleInput getInput(const Simulation& sim, int player) const;
+};
+
+/**
+ * @brief Plays a full match between two bots without any window.
+ *
+ * @param seed Seed of the simulation and the bots.
+ * @param config Gameplay constants to use.
+ * @param max_ticks Tick limit after which the match is abandoned without a winner.
+ * @param recorder Optional recorder receiving the replay of the match.
+ * @param ai Skill of two PaddleAIs playing the match, or nullptr for two MatchBots.
+ * @param levels Level definitions of the match, or nullptr for LevelSet::getDefault().
+ * @return The result of the match.
+ */
+MatchResult runMatch(uint32_t seed, const SimConfig& config, uint64_t max_ticks,
+    ReplayRecorder* recorder = nullptr, const PaddleAIConfig* ai = nullptr, const LevelSet* levels = nullptr);
@@ -1,9 +1,10 @@
 ﻿// Menu.cpp
-#include "Menu.h"
+#include "menu.h"
 #include "sgg/graphics.h"
-#include <iostream>
+#include "logger.h"
 #include "config.h"
 #include "gamestate.h"
+#include "drawlist.h"
 
 /**
  * @text_brief Constructor initializes the menu type and flags.
@@ -12,10 +13,25 @@
 Menu::Menu(MenuType type)
     : m_type(type), m_play_clicked(false), m_exit_clicked(false), m_ready_pressed(false)
 {
+    BrushCache& brushes = BrushCache::getInstance();
+
     // Initialize the Background Brush
-    m_bg_brush.texture = GameState::getInstance()->getFullAssetPath("background.png");
-    m_bg_brush.fill_opacity = 0.17f;     // Semi-transparent fill
-    m_bg_brush.outline_opacity = 0.0f;  // No outline
+    BrushStyle bg;
+    bg.texture = AssetRegistry::getInstance().getTexture("background.png");
+    bg.fill_opacity = 0.17f;     // Semi-transparent fill
+    bg.outline_opacity = 0.0f;   // No outline
+    m_bg_brush = brushes.getHandle(bg);
+
+    // Light blue title and white text
+    BrushStyle title(0.0f, 0.5f, 1.0f);
+    title.outline_opacity = 0.0f; // No outline
+    m_title_brush = brushes.getHandle(title);
+
+    BrushStyle text(1.0f, 1.0f, 1.0f);
+    text.outline_opacity = 0.0f;
+    m_text_brush = brushes.getHandle(text);
+
+    buildHud();
 }
 
 /**
@@ -25,6 +41,7 @@ Menu::Menu(MenuType type)
 void Menu::setMenuType(MenuType type)
 {
     m_type = type;
+    buildHud();
     resetFlags();
 }
 
@@ -39,12 +56,14 @@ void Menu::resetFlags()
 }
 
 /**
- * @text_brief Draws the menu based on its type.
+ * @text_brief Records the draw commands of the menu based on its type.
+ * @param list Draw list of the frame.
  */
-void Menu::draw() const
+void Menu::draw(DrawList& list) const
 {
     // Draw the Background Rectangle Covering the Entire Canvas
-    graphics::drawRect(
+    list.drawRect(
+        DrawLayer::BACKGROUND,
         CANVAS_WIDTH / 2.0f,    // Center X
         CANVAS_HEIGHT / 2.0f,   // Center Y
         CANVAS_WIDTH,            // Width
@@ -52,107 +71,84 @@ void Menu::draw() const
         m_bg_brush               // Brush with texture and opacity
     );
 
-    // Create a Separate Brush for the Title
-    graphics::resetPose();
-    graphics::Brush title_br;
-    title_br.fill_color[0] = 0.0f; // Red component (0.0f - 1.0f)
-    title_br.fill_color[1] = 0.5f; // Green component (0.0f - 1.0f)
-    title_br.fill_color[2] = 1.0f; // Blue component (0.0f - 1.0f)
-    title_br.fill_opacity = 1.0f;  // Fully opaque
-    title_br.outline_opacity = 0.0f; // No outline
-
-
-    graphics::setFont(GameState::getInstance()->getFullAssetPath("ARIAL.ttf"));
-    graphics::resetPose();
-    graphics::Brush text_br;
-    text_br.fill_color[0] = 1.0f;   // White text
-    text_br.fill_color[1] = 1.0f;
-    text_br.fill_color[2] = 1.0f;
-    text_br.outline_opacity = 0.0f;
-    text_br.fill_opacity = 1.0f;
-
-    // Draw text according to the current menu type
+    m_hud.draw(list);
+}
+
+/**
+ * @text_brief Lays out the text of the current menu type. The lines never change afterwards, so
+ * they are formatted once here rather than on every draw.
+ */
+void Menu::buildHud()
+{
+    const FontHandle title_font = FontManager::getFont(GameFont::TITLE);
+    const FontHandle heading_font = FontManager::getFont(GameFont::HEADING);
+    const FontHandle body_font = FontManager::getFont(GameFont::BODY);
+    const FontHandle hud_font = FontManager::getFont(GameFont::HUD);
+
+    m_hud.clear();
     if (m_type == MenuType::MAIN_MENU)
     {
-        // 1. Draw Title "Advanced Pong"
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 195.0f,    // Center the title horizontally
-            CANVAS_HEIGHT / 2.0f - 100.0f,   // Place title higher
-            60.0f,                           // Font size for title
-            "Advanced Pong",
-            title_br
-        );
-
-        // 2. Draw Play Button Text
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 130.0f,    // Center horizontally
-            CANVAS_HEIGHT / 2.0f - 20.0f,    // Adjust position below the title
-            30.0f,
-            "Press SPACE to Play",
-            text_br
-        );
-
-        // 3. Draw Exit Button Text
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 130.0f,    // Center horizontally
-            CANVAS_HEIGHT / 2.0f + 40.0f,    // Adjust position below the play text
-            30.0f,
-            "Press E to Exit Game",
-            text_br
-        );
-    }
+        // 1. Title "Advanced Pong", centered and placed higher
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 195.0f, CANVAS_HEIGHT / 2.0f - 100.0f, title_font, m_title_brush, "Advanced Pong");
+
+        // 2. Play Button Text below the title
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 130.0f, CANVAS_HEIGHT / 2.0f - 20.0f, body_font, m_text_brush, "Press SPACE to Play");
 
+        // 3. Exit Button Text below the play text
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 130.0f, CANVAS_HEIGHT / 2.0f + 40.0f, body_font, m_text_brush, "Press E to Exit Game");
+
+        // 4. Paddle controls below, filled in by updateControlsText()
+        m_hud_controls[0] = m_hud.addText(CANVAS_WIDTH / 2.0f - 175.0f, CANVAS_HEIGHT / 2.0f + 120.0f, hud_font, m_text_brush);
+        m_hud_controls[1] = m_hud.addText(CANVAS_WIDTH / 2.0f - 175.0f, CANVAS_HEIGHT / 2.0f + 150.0f, hud_font, m_text_brush);
+        updateControlsText();
+    }
     else if (m_type == MenuType::PAUSE_MENU)
     {
         // Centered "Ready?"
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 75.0f,    // Adjusted to center horizontally
-            CANVAS_HEIGHT / 2.0f - 20.0f,   // Centered vertically
-            50.0f,                          // Font size for "Ready?"
-            "Ready?",
-            text_br
-        );
-
-        // Centered "Press SPACE to Continue"
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 175.0f,   // Adjusted to center horizontally
-            CANVAS_HEIGHT / 2.0f + 40.0f,   // Positioned below "Ready?"
-            20.0f,                          // Font size for instructions
-            "Press SPACE to Continue to the next Level",
-            text_br
-        );
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 75.0f, CANVAS_HEIGHT / 2.0f - 20.0f, heading_font, m_text_brush, "Ready?");
+
+        // Centered "Press SPACE to Continue" below it
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 175.0f, CANVAS_HEIGHT / 2.0f + 40.0f, hud_font, m_text_brush,
+            "Press SPACE to Continue to the next Level");
     }
     else if (m_type == MenuType::GAME_OVER_MENU)
     {
-        // 1. Draw "Game Over" Title
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 100.0f,    // Centered horizontally
-            CANVAS_HEIGHT / 2.0f - 100.0f,   // Positioned higher vertically
-            50.0f,                            // Font size
-            "Game Over",
-            text_br
-        );
-
-        // 2. Draw "Press R to return to the Main Menu" Instruction
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 150.0f,    // Centered horizontally
-            CANVAS_HEIGHT / 2.0f,             // Centered vertically
-            30.0f,                            // Font size
-            "Press R to Play Again",
-            text_br
-        );
-
-        // 3. Draw "Press E to Exit Game" Instruction
-        graphics::drawText(
-            CANVAS_WIDTH / 2.0f - 130.0f,    // Centered horizontally
-            CANVAS_HEIGHT / 2.0f + 40.0f,    // Positioned below the first instruction
-            30.0f,                            // Font size
-            "Press E to Exit Game",
-            text_br
-        );
+        // 1. "Game Over" Title, positioned higher
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 100.0f, CANVAS_HEIGHT / 2.0f - 100.0f, heading_font, m_text_brush, "Game Over");
+
+        // 2. "Press R to Play Again" Instruction, centered
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 150.0f, CANVAS_HEIGHT / 2.0f, body_font, m_text_brush, "Press R to Play Again");
+
+        // 3. "Press E to Exit Game" Instruction below it
+        m_hud.addText(CANVAS_WIDTH / 2.0f - 130.0f, CANVAS_HEIGHT / 2.0f + 40.0f, body_font, m_text_brush, "Press E to Exit Game");
+    }
+}
+
+/**
+ * @text_brief Shows who controls each paddle in the Main Menu.
+ */
+void Menu::updateControlsText()
+{
+    for (int player = 1; player <= 2; player++)
+    {
+        if (isComputerPlayer(player))
+            m_hud.setText(m_hud_controls[player - 1], "Player %d: Computer (press %d for keyboard)", player, player);
+        else
+            m_hud.setText(m_hud_controls[player - 1], "Player %d: Keyboard (press %d for computer)", player, player);
     }
 }
 
+/**
+ * @text_brief Hands a paddle to the computer, or back to the keyboard.
+ * @param player The player (1 or 2).
+ */
+void Menu::toggleComputerPlayer(int player)
+{
+    bool& computer = m_computer_player[player - 1];
+    computer = !computer;
+    updateControlsText();
+    LOG_INFO("Player {} is now played by the {}.", player, computer ? "computer" : "keyboard");
+}
 
 /**
  * @text_brief Handles input events for the menu.
@@ -169,19 +165,29 @@ void Menu::update()
         if (current_spacebar && !m_previous_spacebar_state)
         {
             m_play_clicked = true;
-            std::cout << "Play button pressed (Spacebar).\n";
+            LOG_INFO("Play button pressed (Spacebar).");
         }
 
         // Exit Button: Detect key down event
         if (current_e && !m_previous_e_state)
         {
             m_exit_clicked = true;
-            std::cout << "Exit button pressed ('E').\n";
+            LOG_INFO("Exit button pressed ('E').");
         }
 
+        // Computer Players: 1 and 2 hand a paddle to the computer and back
+        bool current_1 = graphics::getKeyState(graphics::SCANCODE_1);
+        bool current_2 = graphics::getKeyState(graphics::SCANCODE_2);
+        if (current_1 && !m_previous_1_state)
+            toggleComputerPlayer(1);
+        if (current_2 && !m_previous_2_state)
+            toggleComputerPlayer(2);
+
         // Update previous states
         m_previous_spacebar_state = current_spacebar;
         m_previous_e_state = current_e;
+        m_previous_1_state = current_1;
+        m_previous_2_state = current_2;
     }
     // Handle Pause Menu Inputs
     else if (m_type == MenuType::PAUSE_MENU)
@@ -192,7 +198,7 @@ void Menu::update()
         if (current_spacebar && !m_previous_spacebar_state)
         {
             m_ready_pressed = true;
-            std::cout << "Continue pressed (Spacebar).\n";
+            LOG_INFO("Continue pressed (Spacebar).");
         }
 
         // Update previous state
@@ -207,14 +213,14 @@ void Menu::update()
         if (current_r && !m_previous_spacebar_state)
         {
             m_play_clicked = true; // Reuse the play_clicked flag for Main Menu return
-            std::cout << "Main Menu pressed (R).\n";
+            LOG_INFO("Main Menu pressed (R).");
         }
 
         // 2. Detect E Press for Exiting the Game
         if (current_e && !m_previous_e_state)
         {
             m_exit_clicked = true;
-            std::cout << "Exit button pressed ('E').\n";
+            LOG_INFO("Exit button pressed ('E').");
         }
 
         // 3. Update Previous Key States
@@ -1,9 +1,12 @@
 // Menu.h
 #pragma once
 
-#include "sgg/graphics.h"
+#include "brushcache.h"
+#include "hud.h"
 #include <string>
 
+class DrawList;
+
 /**
  * @enum MenuType
  * @brief Defines the type of menu (Main Menu or Pause Menu).
@@ -31,9 +34,36 @@ private:
     bool m_previous_spacebar_state = false;
     bool m_previous_e_state = false;
     bool m_previous_r_state = false;
+    bool m_previous_1_state = false;
+    bool m_previous_2_state = false;
+
+    // Players handed to the computer in the Main Menu, indexed by player - 1
+    bool m_computer_player[2] = { false, false };
+    size_t m_hud_controls[2] = { 0, 0 };   // HUD lines showing who controls each paddle
+
+    // Brushes, resolved once by the constructor
+    BrushHandle m_bg_brush;
+    BrushHandle m_title_brush;
+    BrushHandle m_text_brush;
+
+    // Text of the current menu type
+    Hud m_hud;
 
-    // Declare the Background Brush
-    graphics::Brush m_bg_brush;
+    /**
+     * @brief Lays out the text of the current menu type.
+     */
+    void buildHud();
+
+    /**
+     * @brief Shows who controls each paddle in the Main Menu.
+     */
+    void updateControlsText();
+
+    /**
+     * @brief Hands a paddle to the computer, or back to the keyboard.
+     * @param player The player (1 or 2).
+     */
+    void toggleComputerPlayer(int player);
 
 public:
     /**
@@ -43,9 +73,10 @@ public:
     Menu(MenuType type = MenuType::MAIN_MENU);
 
     /**
-     * @brief Draws the menu based on its type.
+     * @brief Records the draw commands of the menu based on its type.
+     * @param list Draw list of the frame.
      */
-    void draw() const;
+    void draw(DrawList& list) const;
 
     /**
      * @brief Handles input events for the menu.
@@ -82,6 +113,13 @@ public:
      */
     bool isReadyPressed() const;
 
+    /**
+     * @brief Checks if a player was handed to the computer (toggled with 1 and 2 in the Main Menu).
+     * @param player The player (1 or 2).
+     * @return True if the computer plays the paddle, False for the keyboard.
+     */
+    bool isComputerPlayer(int player) const { return m_computer_player[player == 1 ? 0 : 1]; }
+
     /**
      * @brief Resets the menu state flags.
      */
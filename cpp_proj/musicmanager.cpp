@@ -0,0 +1,141 @@
+#include "musicmanager.h"
+#include "gamestate.h"
+#include "logger.h"
+#include "clamp.h"
+#include "sgg/graphics.h"
+
+namespace
+{
+    /**
+     * @struct TrackInfo
+     * @brief File and playback settings of a music track.
+     */
+    struct TrackInfo
+    {
+        const char* asset;
+        float volume;       // Relative to the music volume
+        bool looping;
+    };
+
+    // Indexed by MusicId
+    const TrackInfo TRACKS[static_cast<size_t>(MusicId::COUNT)] =
+    {
+        { "title_screen.mp3", 0.7f, true },
+        { "ready_screen.mp3", 0.7f, true },
+        { "level_1.mp3", 0.7f, true },
+        { "level_2.mp3", 0.7f, true },
+        { "level_3.mp3", 0.7f, true },
+        { "level_4.mp3", 0.7f, true },
+        { "game_over.mp3", 0.7f, false },
+    };
+}
+
+/**
+ * @brief Retrieves the singleton instance.
+ *
+ * @return The music manager.
+ */
+MusicManager& MusicManager::getInstance()
+{
+    static MusicManager instance;
+    return instance;
+}
+
+/**
+ * @brief Resolves the path of every track once. Does nothing if already initialised.
+ */
+void MusicManager::init()
+{
+    if (m_loaded)
+        return;
+
+    for (size_t i = 0; i < static_cast<size_t>(MusicId::COUNT); i++)
+    {
+        m_paths[i] = GameState::getInstance()->getFullAssetPath(TRACKS[i].asset);
+    }
+    m_enabled = GameState::getInstance()->music_on;
+    m_loaded = true;
+}
+
+/**
+ * @brief Stops the music when GameState::music_on is turned off, and resumes the current track
+ * when it is turned back on. Does nothing while the flag is unchanged.
+ */
+void MusicManager::update()
+{
+    bool enabled = GameState::getInstance()->music_on;
+    if (enabled == m_enabled)
+        return;
+
+    m_enabled = enabled;
+    if (m_enabled)
+        start();
+    else
+        graphics::stopMusic(CROSSFADE_TIME);
+}
+
+/**
+ * @brief Crossfades to a track. Asking for the current track does not restart it.
+ *
+ * @param track The track to play.
+ */
+void MusicManager::play(MusicId track)
+{
+    if (!m_loaded || track == m_current || track == MusicId::COUNT)
+        return;
+
+    m_current = track;
+    start();
+}
+
+/**
+ * @brief Looks up a track by its file name.
+ *
+ * @param asset File name in the asset directory, e.g. "level_1.mp3".
+ * @return The track, or MusicId::COUNT if no track uses that file.
+ */
+MusicId MusicManager::findTrack(const std::string& asset)
+{
+    for (size_t i = 0; i < static_cast<size_t>(MusicId::COUNT); i++)
+    {
+        if (asset == TRACKS[i].asset)
+            return static_cast<MusicId>(i);
+    }
+    return MusicId::COUNT;
+}
+
+/**
+ * @brief Fades out the current track.
+ */
+void MusicManager::stop()
+{
+    if (m_current == MusicId::COUNT)
+        return;
+
+    m_current = MusicId::COUNT;
+    graphics::stopMusic(CROSSFADE_TIME);
+    LOG_TRACE("Music stopped.");
+}
+
+/**
+ * @brief Sets the music volume. SGG cannot change the volume of a stream while it plays, so
+ * rather than restarting the current track the volume applies from the next track on.
+ *
+ * @param volume The desired volume level (0.0f to 1.0f).
+ */
+void MusicManager::setVolume(float volume)
+{
+    m_volume = clamp(volume, 0.0f, 1.0f);
+    LOG_DEBUG("Music volume set to: {}", m_volume);
+}
+
+void MusicManager::start()
+{
+    if (!m_enabled || m_current == MusicId::COUNT)
+        return;
+
+    size_t index = static_cast<size_t>(m_current);
+    const TrackInfo& info = TRACKS[index];
+    graphics::playMusic(m_paths[index], m_volume * info.volume, info.looping, CROSSFADE_TIME);
+    LOG_INFO("Music playing: {}", m_paths[index]);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @enum MusicId
+ * @brief Integer identifiers of the music tracks loaded by the MusicManager.
+ */
+enum class MusicId : uint8_t
+{
+    TITLE_SCREEN,   ///< Main menu.
+    READY_SCREEN,   ///< Pause menu between levels.
+    LEVEL_1,
+    LEVEL_2,
+    LEVEL_3,
+    SUDDEN_DEATH,   ///< Level 4.
+    GAME_OVER,      ///< Plays once on the game over screen.
+    COUNT
+};
+
+/**
+ * @class MusicManager
+ * @brief Persistent music player: one stream at a time, crossfaded on every track change.
+ *
+ * Playing the track that is already playing does nothing, so callers can ask for the music of a
+ * state as often as they like without restarting the stream. SGG streams music from disk; the
+ * tracks were read ahead by AssetRegistry::preload(), so a transition opens a file that is
+ * already in the OS cache instead of stalling the frame on the disk.
+ */
+class MusicManager
+{
+public:
+    static const int CROSSFADE_TIME = 500;  ///< Fade between two tracks, in ms.
+
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static MusicManager& getInstance();
+
+    /**
+     * @brief Resolves the path of every track. Called once by GameState::init.
+     */
+    void init();
+
+    /**
+     * @brief Follows GameState::music_on, stopping or resuming the current track when it changes.
+     */
+    void update();
+
+    /**
+     * @brief Crossfades to a track, unless it is already the current one.
+     * @param track The track to play.
+     */
+    void play(MusicId track);
+
+    /**
+     * @brief Looks up a track by its file name, as level files name their music.
+     * @return The track, or MusicId::COUNT if no track uses that file.
+     */
+    static MusicId findTrack(const std::string& asset);
+
+    /**
+     * @brief Fades out the current track.
+     */
+    void stop();
+
+    /**
+     * @brief Sets the music volume, applied from the next track on.
+     * @param volume Volume level (0.0f to 1.0f).
+     */
+    void setVolume(float volume);
+
+    /**
+     * @brief Returns the music volume.
+     */
+    float getVolume() const { return m_volume; }
+
+    /**
+     * @brief Returns the current track, or MusicId::COUNT if none.
+     */
+    MusicId getCurrent() const { return m_current; }
+
+private:
+    MusicManager() {}
+    MusicManager(const MusicManager&) = delete;
+    MusicManager& operator=(const MusicManager&) = delete;
+
+    /**
+     * @brief Starts the current track in SGG, fading it in over the previous one.
+     */
+    void start();
+
+    std::string m_paths[static_cast<size_t>(MusicId::COUNT)];   // Full paths, resolved by init()
+    MusicId m_current = MusicId::COUNT;
+    float m_volume = 1.0f;
+    bool m_enabled = true;      // Last seen value of GameState::music_on
+    bool m_loaded = false;
+};
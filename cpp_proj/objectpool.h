@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class ObjectPool
+ * @brief Fixed-capacity storage for objects of one type, constructed in place without touching
+ * the heap.
+ *
+ * Free slots form an intrusive list through a parallel index array, so create() and destroy() are
+ * O(1). clear() ends the lifetime of every live object and forgets the free list: slots are
+ * handed out from the start again, as from an arena that was reset, and no memory is returned to
+ * the heap. A level clears its pools instead of freeing its objects one by one.
+ *
+ * @tparam T Type of the objects.
+ * @tparam Capacity Number of objects that can be live at once.
+ */
+template <typename T, size_t Capacity>
+class ObjectPool
+{
+public:
+    ObjectPool() {}
+    ~ObjectPool() { clear(); }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Constructs an object in a free slot.
+     * @return The object, or nullptr if the pool is full.
+     */
+    template <typename... Args>
+    T* create(Args&&... args)
+    {
+        uint32_t slot;
+        if (m_free_head != NO_SLOT)
+        {
+            slot = m_free_head;
+            m_free_head = m_next_free[slot];
+        }
+        else if (m_used < Capacity)
+        {
+            slot = m_used++;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        T* object = new (&m_slots[slot]) T(std::forward<Args>(args)...);
+        m_live[slot] = true;
+        m_size++;
+        return object;
+    }
+
+    /**
+     * @brief Destroys an object of this pool and frees its slot. Does nothing for nullptr.
+     */
+    void destroy(T* object)
+    {
+        if (!object)
+            return;
+
+        uint32_t slot = static_cast<uint32_t>(reinterpret_cast<Slot*>(object) - m_slots);
+        object->~T();
+        m_live[slot] = false;
+        m_next_free[slot] = m_free_head;
+        m_free_head = slot;
+        m_size--;
+    }
+
+    /**
+     * @brief Destroys every live object and frees all slots, in one pass over the slots handed
+     * out since the last clear().
+     */
+    void clear()
+    {
+        for (uint32_t slot = 0; slot < m_used; slot++)
+        {
+            if (m_live[slot])
+            {
+                reinterpret_cast<T*>(&m_slots[slot])->~T();
+                m_live[slot] = false;
+            }
+        }
+        m_used = 0;
+        m_free_head = NO_SLOT;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Number of live objects.
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief Number of objects that can be live at once.
+     */
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static const uint32_t NO_SLOT = UINT32_MAX;
+
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    Slot m_slots[Capacity];
+    uint32_t m_next_free[Capacity];     // Next free slot, for slots in the free list
+    bool m_live[Capacity] = {};
+    uint32_t m_used = 0;                // Slots handed out since the last clear(); the rest are untouched
+    uint32_t m_free_head = NO_SLOT;     // First slot of the free list
+    size_t m_size = 0;
+};
@@ -1,146 +1,67 @@
-#include "Obstacle.h"
-#include "GameState.h"
-#include "config.h"
+#include "obstacle.h"
+#include "entitystore.h"
+#include "drawlist.h"
 #include "sgg/graphics.h"
-#include <iostream>
 
 /**
- * @brief Constructs a new Obstacle object.
- *
- * Initializes the Obstacle with the specified parameters, setting its type, hit points,
- * speed, and position within the game world.
- *
- * @param gs Pointer to the current GameState.
- * @param name The name identifier for the Obstacle.
- * @param type The type of obstacle (Breakable or Unbreakable).
- * @param x The initial X-coordinate position of the Obstacle.
- * @param y The initial Y-coordinate position of the Obstacle.
- * @param width The width of the Obstacle.
- * @param height The height of the Obstacle.
- * @param hit_points The number of hits the Obstacle can take before being destroyed (only for Breakable obstacles).
- * @param speed The movement speed of the Obstacle (only for Unbreakable obstacles).
- */
-Obstacle::Obstacle(GameState* gs, const std::string& name, Type type,
-    float x, float y, float width, float height,
-    int hit_points, float speed)
-    : GameObject(gs, name),
-    m_type(type),
-    m_hit_points(hit_points),
-    m_speed(speed)
-{
-    setX(x);
-    setY(y);
-    setWidth(width);
-    setHeight(height);
-}
-
-/**
- * @brief Initializes the Obstacle object.
- *
- * Logs the initialization of the Obstacle, including its name and position.
+ * @struct ObstacleBrushes
+ * @brief Brushes of the obstacle states, resolved once on first use.
  */
-void Obstacle::init()
+struct ObstacleBrushes
 {
-    std::cout << "Obstacle '" << getName()
-        << "' initialized at position: (" << getX() << ", " << getY() << ")\n";
-}
+    BrushHandle healthy;        // Breakable with 2 or more hit points
+    BrushHandle damaged;        // Breakable with less than 2 hit points
+    BrushHandle unbreakable;
 
-/**
- * @brief Updates the Obstacle's state.
- *
- * Handles the movement logic for Unbreakable obstacles, allowing them to move
- * up and down within the game boundaries. Breakable obstacles remain stationary.
- *
- * @param dt Delta time since the last update in seconds.
- */
-void Obstacle::update(float dt)
-{
-    if (m_type == Type::Unbreakable)
+    ObstacleBrushes()
     {
-        // Calculate the new Y-position based on speed and direction
-        float new_y = getY() + m_speed * m_direction * dt;
+        BrushCache& brushes = BrushCache::getInstance();
+        BrushStyle style;
+        style.outline_color[0] = 0.0f;
+        style.outline_opacity = 0.0f; // No outline
 
-        float canvasHeight = m_state->getCanvasHeight();
-        float halfHeight = getHeight() / 2.0f;
+        style.fill_color[0] = 0.0f; // Green
+        style.fill_color[1] = 1.0f;
+        style.fill_color[2] = 0.0f;
+        healthy = brushes.getHandle(style);
 
-        // Check for collision with the top boundary
-        if (new_y + halfHeight >= canvasHeight)
-        {
-            new_y = canvasHeight - halfHeight; // Prevent moving out of bounds
-            m_direction = -1; // Reverse direction to move downward
-        }
-        // Check for collision with the bottom boundary
-        else if (new_y - halfHeight <= 0.0f)
-        {
-            new_y = halfHeight; // Prevent moving out of bounds
-            m_direction = 1; // Reverse direction to move upward
-        }
+        style.fill_color[0] = 1.0f; // Red
+        style.fill_color[1] = 0.0f;
+        style.fill_color[2] = 0.0f;
+        damaged = brushes.getHandle(style);
 
-        setY(new_y); // Update the Obstacle's Y-position
+        style.fill_color[0] = 0.5f; // Gray
+        style.fill_color[1] = 0.5f;
+        style.fill_color[2] = 0.5f;
+        unbreakable = brushes.getHandle(style);
     }
-}
+};
 
 /**
- * @brief Renders the Obstacle on the screen.
+ * @brief Renders every active obstacle on the screen.
  *
- * Draws the Obstacle with colors indicating its type and current state.
+ * Draws each Obstacle with colors indicating its type and current state.
  * Breakable obstacles change color based on remaining hit points, while
  * Unbreakable obstacles are rendered in a consistent gray color.
+ *
+ * @param obstacles The obstacles to draw.
+ * @param list Draw list of the frame.
  */
-void Obstacle::draw()
+void Obstacle::drawAll(const ObstacleStore& obstacles, DrawList& list)
 {
-    graphics::Brush br;
+    static const ObstacleBrushes brushes;
 
-    if (m_type == Type::Breakable)
-    {
-        // Set color based on remaining hit points
-        if (m_hit_points >= 2) {
-            // Green color when hit points are 2 or more
-            br.fill_color[0] = 0.0f;
-            br.fill_color[1] = 1.0f;
-            br.fill_color[2] = 0.0f;
-        }
-        else {
-            // Red color when hit points are less than 2
-            br.fill_color[0] = 1.0f;
-            br.fill_color[1] = 0.0f;
-            br.fill_color[2] = 0.0f;
-        }
-    }
-    else
+    for (size_t i = 0; i < obstacles.size(); i++)
     {
-        // Gray color for Unbreakable obstacles
-        br.fill_color[0] = 0.5f;
-        br.fill_color[1] = 0.5f;
-        br.fill_color[2] = 0.5f;
-    }
-
-    br.outline_color[0] = 0.0f;
-    br.outline_opacity = 0.0f; // No outline
-    br.texture = ""; // No texture
+        if (!obstacles.active[i])
+            continue;
 
-    // Draw the Obstacle as a rectangle at its current position and size
-    graphics::drawRect(getX(), getY(), getWidth(), getHeight(), br);
-}
-
-/**
- * @brief Handles a hit on the Obstacle.
- *
- * Decrements the hit points of a Breakable obstacle and checks if it should be destroyed.
- * Unbreakable obstacles are unaffected by hits.
- */
-void Obstacle::handleHit()
-{
-    if (m_type == Type::Breakable)
-    {
-        m_hit_points--; // Decrement hit points
-        std::cout << "Obstacle '" << getName() << "' hit! HP: " << m_hit_points << "\n";
+        // Breakable obstacles change color with their remaining hit points
+        BrushHandle brush = brushes.unbreakable;
+        if (obstacles.type[i] == Type::Breakable)
+            brush = obstacles.hit_points[i] >= 2 ? brushes.healthy : brushes.damaged;
 
-        if (m_hit_points <= 0)
-        {
-            setActive(false); // Deactivate the Obstacle if hit points are depleted
-            std::cout << "Obstacle '" << getName() << "' destroyed!\n";
-        }
+        // Draw the Obstacle as a rectangle at its current position and size
+        list.drawRect(DrawLayer::WORLD, obstacles.x[i], obstacles.y[i], obstacles.width[i], obstacles.height[i], brush);
     }
-    // Unbreakable obstacles do not respond to hits
 }
@@ -1,13 +1,14 @@
 #pragma once
-#include "GameObject.h"
-#include "box.h"
-#include <string>
+
+struct ObstacleStore;
+class DrawList;
 
 /**
  * @class Obstacle
- * @brief Represents an obstacle in the Pong game.
+ * @brief Obstacle types and rendering. Obstacles are stored and moved by the Simulation in a
+ * structure-of-arrays ObstacleStore; this class draws them straight from that store.
  */
-class Obstacle : public GameObject
+class Obstacle
 {
 public:
     enum class Type {
@@ -15,72 +16,10 @@ public:
         Unbreakable
     };
 
-private:
-	Type m_type;         ///< Type of obstacle.
-    int m_hit_points;    ///< For breakable obstacles.
-    float m_speed;       ///< For unbreakable obstacles.
-    int m_direction = 1; ///< 1 for down, -1 for up.
-
-public:
-    /**
-     * @brief Constructor for Obstacle.
-     */
-    Obstacle(GameState* gs, const std::string& name, Type type,
-        float x, float y, float width, float height,
-        int hit_points = 0, float speed = 0.0f);
-
-    /**
-     * @brief Initializes the obstacle.
-     */
-    void init() override;
-
-    /**
-     * @brief Updates the obstacle, moving it if unbreakable.
-     */
-    void update(float dt) override;
-
     /**
-     * @brief Draws the obstacle on screen.
+     * @brief Draws every active obstacle of a store.
+     * @param obstacles The obstacles to draw.
+     * @param list Draw list of the frame.
      */
-    void draw() override;
-
-    /**
-     * @brief Handles a hit on a breakable obstacle.
-     */
-    void handleHit();
-
-	/**
-	* @brief Returns true if the obstacle is breakable.
-	*/
-    bool isBreakable() const { return m_type == Type::Breakable; }
-
-	/**
-	* @brief Returns the hit points of the obstacle.
-	*/
-    int getHitPoints() const { return m_hit_points; }
-
-	/**
-	* @brief Sets the hit points of the obstacle.
-	*/
-    void setHitPoints(int hp) { m_hit_points = hp; }
-
-    /**
-	* @brief Returns the width of the obstacle.
-	*/
-    float getWidth() const { return m_width; }
-
-	/**
-	* @brief Returns the height of the obstacle.
-	*/
-    float getHeight() const { return m_height; }
-
-    /**
-	* @brief Returns the speed of the obstacle.
-	*/
-    float getSpeed() const { return m_speed; }
-
-	/**
-	* @brief Returns the direction of the obstacle.
-	*/
-    int getDirection() const { return m_direction; }
+    static void drawAll(const ObstacleStore& obstacles, DrawList& list);
 };
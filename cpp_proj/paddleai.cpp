@@ -0,0 +1,117 @@
+#include "paddleai.h"
+#include <cmath>
+#include <algorithm>
+
+/**
+ * @brief Predicts where the ball's center will be when it reaches a vertical line.
+ *
+ * The center moves between height / 2 and CANVAS_HEIGHT - height / 2. Measured from the lower
+ * bound, the unrolled position u maps back into [0, span] by taking it modulo 2 * span and
+ * mirroring the upper half, which is what each wall bounce does to the path.
+ */
+float predictBallY(float x, float y, float speed_x, float speed_y, float height, float target_x)
+{
+    const float half_height = height / 2.0f;
+    const float span = CANVAS_HEIGHT - height;
+    if (speed_x == 0.0f || span <= 0.0f)
+        return y;
+
+    // A line behind the ball is reached now
+    const float time = std::max(0.0f, (target_x - x) / speed_x);
+    const float unrolled = y - half_height + speed_y * time;
+
+    const float period = 2.0f * span;
+    float folded = std::fmod(unrolled, period);
+    if (folded < 0.0f)
+        folded += period;
+    if (folded > span)
+        folded = period - folded;
+    return folded + half_height;
+}
+
+/**
+ * @brief Constructs a new PaddleAI and draws its first aiming error.
+ *
+ * @param seed Seed of the AI's aiming errors.
+ * @param config Reaction delay and aiming error.
+ */
+PaddleAI::PaddleAI(uint32_t seed, const PaddleAIConfig& config)
+    : m_config(config),
+    m_rng(seed)
+{
+    reaim();
+}
+
+/**
+ * @brief Draws a new aiming error, uniformly in [-max_error, max_error].
+ */
+void PaddleAI::reaim()
+{
+    std::uniform_real_distribution<float> dist(-m_config.max_error, m_config.max_error);
+    m_aim_error = dist(m_rng);
+}
+
+/**
+ * @brief Observes the ball and computes the paddle input until the next call.
+ *
+ * The ball is recorded into a ring of samples; the AI acts on the newest one that is at least
+ * reaction_ms old, or on the oldest one kept if the delay is longer than the ring. That sample only
+ * moves forward, so finding it costs O(1) per call on average.
+ *
+ * @param sim The simulation being played.
+ * @param player The paddle controlled by the AI (1 or 2).
+ * @param dt Time until the next call in ms.
+ * @return The paddle input.
+ */
+PaddleInput PaddleAI::getInput(const Simulation& sim, int player, float dt)
+{
+    const SimBall& ball = sim.getBall();
+
+    // Record the ball; when the ring is full the oldest sample is overwritten
+    uint32_t next = (m_count == 0) ? 0 : (m_newest + 1) % MAX_SAMPLES;
+    if (m_count > 0 && next == m_seen)
+        m_seen = (m_seen + 1) % MAX_SAMPLES;
+    m_newest = next;
+    if (m_count < MAX_SAMPLES)
+        m_count++;
+
+    // While the ball ramps up after a serve its velocity grows towards the serve velocity; the
+    // direction is the same, and only the direction matters for the prediction
+    BallSample& sample = m_samples[next];
+    sample.time = m_clock;
+    sample.x = ball.x;
+    sample.y = ball.y;
+    sample.speed_x = ball.ramping_up ? ball.target_speed_x : ball.speed_x;
+    sample.speed_y = ball.ramping_up ? ball.target_speed_y : ball.speed_y;
+    sample.width = ball.width;
+    sample.height = ball.height;
+    m_clock += dt;
+
+    // Act on the newest sample that is old enough
+    while (m_seen != m_newest)
+    {
+        uint32_t after = (m_seen + 1) % MAX_SAMPLES;
+        if (sample.time - m_samples[after].time < m_config.reaction_ms)
+            break;
+        m_seen = after;
+    }
+    const BallSample& seen = m_samples[m_seen];
+
+    // Aim for the point where the ball touches the paddle's face, or wait at the center
+    const SimPaddle& paddle = sim.getPaddle(player);
+    const float towards_paddle = (player == 1) ? -1.0f : 1.0f;
+    float target = CANVAS_HEIGHT / 2.0f;
+    if (seen.speed_x * towards_paddle > 0.0f)
+    {
+        float face_x = paddle.x - towards_paddle * (paddle.width + seen.width) / 2.0f;
+        target = predictBallY(seen.x, seen.y, seen.speed_x, seen.speed_y, seen.height, face_x) + m_aim_error;
+    }
+
+    // Dead zone of one call's paddle movement avoids jittering around the target
+    const float dead_zone = paddle.speed * std::max(dt, sim.getTickMs());
+
+    PaddleInput input;
+    input.up = paddle.y > target + dead_zone;
+    input.down = paddle.y < target - dead_zone;
+    return input;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include "simulation.h"
+
+/**
+ * @brief Predicts where the ball's center will be when it reaches a vertical line, reflecting
+ * it off the top and bottom walls in closed form.
+ *
+ * The straight path is unrolled as if there were no walls, then folded back into the range the
+ * ball's center can reach: a triangle wave of period 2 * (CANVAS_HEIGHT - height). The cost is
+ * constant however many bounces lie ahead. Paddles, obstacles and powerups are not considered.
+ *
+ * @param x, y Center of the ball.
+ * @param speed_x, speed_y Velocity of the ball; speed_x must not be 0.
+ * @param height Height of the ball.
+ * @param target_x The vertical line, ahead of the ball in the direction of speed_x.
+ * @return The y coordinate of the ball's center at target_x.
+ */
+float predictBallY(float x, float y, float speed_x, float speed_y, float height, float target_x);
+
+/**
+ * @struct PaddleAIConfig
+ * @brief Skill of a PaddleAI.
+ */
+struct PaddleAIConfig
+{
+    float reaction_ms = 150.0f; ///< Age of the ball state the AI acts on, in ms.
+    float max_error = 40.0f;    ///< Maximum aiming error in either direction, in canvas units.
+};
+
+/**
+ * @class PaddleAI
+ * @brief Paddle controller that moves to the point where the ball will cross the paddle, using
+ * predictBallY() on the ball as it was reaction_ms ago.
+ *
+ * While the ball flies straight the delayed state predicts the same intercept as the current one,
+ * so the delay only shows after paddle and obstacle hits: the AI keeps going for the old intercept
+ * until it "sees" the bounce. Its aim is off by a random error that is redrawn by reaim(), as with
+ * MatchBot. When the ball moves away the paddle returns to the center.
+ */
+class PaddleAI
+{
+private:
+    /**
+     * @struct BallSample
+     * @brief Ball state as seen at one call of getInput().
+     */
+    struct BallSample
+    {
+        double time;    // Time of the sample on the AI's clock, in ms
+        float x, y;
+        float speed_x;  // Velocity, or the serve velocity while the ball ramps up
+        float speed_y;
+        float width, height;
+    };
+
+    // Samples kept for the reaction delay; older ones are overwritten
+    static const uint32_t MAX_SAMPLES = 256;
+
+    PaddleAIConfig m_config;
+    std::mt19937 m_rng;
+    float m_aim_error = 0.0f;   // Offset from the intercept the paddle currently aims for
+    double m_clock = 0.0;       // Time since the AI was created, in ms
+
+    BallSample m_samples[MAX_SAMPLES];
+    uint32_t m_newest = 0;      // Index of the newest sample
+    uint32_t m_seen = 0;        // Index of the sample the AI acts on
+    uint32_t m_count = 0;       // Samples recorded, up to MAX_SAMPLES
+
+public:
+    /**
+     * @brief Creates an AI.
+     * @param seed Seed of the AI's aiming errors.
+     * @param config Reaction delay and aiming error.
+     */
+    explicit PaddleAI(uint32_t seed, const PaddleAIConfig& config = PaddleAIConfig());
+
+    /**
+     * @brief Draws a new aiming error.
+     */
+    void reaim();
+
+    /**
+     * @brief Observes the ball and computes the paddle input until the next call.
+     * @param sim The simulation being played.
+     * @param player The paddle controlled by the AI (1 or 2).
+     * @param dt Time until the next call in ms: one tick, or one frame when the input is applied
+     * to every tick of a frame.
+     */
+    PaddleInput getInput(const Simulation& sim, int player, float dt);
+
+    const PaddleAIConfig& getConfig() const { return m_config; }
+};
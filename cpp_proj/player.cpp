@@ -1,5 +1,6 @@
-#include "Player.h"
-#include "GameState.h"
+#include "player.h"
+#include "gamestate.h"
+#include "drawlist.h"
 #include <sgg/graphics.h>
 #include "config.h"
 #include <iostream>
@@ -32,40 +33,26 @@ Player::Player(GameState* gs, const std::string& name,
 {
     setX(posX);
     setY(posY);
+
+    BrushStyle paddle(0.0f, 1.0f, 0.0f); // Green fill
+    paddle.outline_width = 2.0f;         // White outline for better visibility
+    m_brush = BrushCache::getInstance().getHandle(paddle);
 }
 
 /**
- * @brief Updates the Player's state based on user input and ensures it remains within boundaries.
+ * @brief Samples the Player's movement keys.
  *
- * Handles the Player's vertical movement by checking if the assigned movement keys are pressed.
- * It moves the Player up or down accordingly and clamps the Player's position within the
- * predefined canvas boundaries to prevent it from moving off-screen.
+ * Movement and clamping to the canvas boundaries are performed by the Simulation, which
+ * receives this input every frame.
  *
- * @param dt Delta time since the last update in seconds.
+ * @return The paddle input, with up/down set if the assigned keys are pressed.
  */
-void Player::update(float dt)
+PaddleInput Player::readInput() const
 {
-    // Move up if the up key is pressed
-    if (graphics::getKeyState(moveUpKey))
-    {
-        y -= speed * dt;
-    }
-
-    // Move down if the down key is pressed
-    if (graphics::getKeyState(moveDownKey))
-    {
-        y += speed * dt;
-    }
-
-    // Clamp the Player's Y-position within the canvas boundaries
-    if (y + m_height / 2.0f > CANVAS_HEIGHT)
-    {
-        y = CANVAS_HEIGHT - m_height / 2.0f; // Prevent moving beyond the bottom boundary
-    }
-    if (y - m_height / 2.0f < 0.0f)
-    {
-        y = m_height / 2.0f; // Prevent moving beyond the top boundary
-    }
+    PaddleInput input;
+    input.up = graphics::getKeyState(moveUpKey);
+    input.down = graphics::getKeyState(moveDownKey);
+    return input;
 }
 
 /**
@@ -73,22 +60,11 @@ void Player::update(float dt)
  *
  * Draws the Player's paddle as a rectangle with a green fill and a white outline.
  * The paddle's dimensions and position are based on the Player's current state.
+ *
+ * @param list Draw list of the frame.
  */
-void Player::draw()
+void Player::draw(DrawList& list)
 {
-    graphics::Brush br;
-
-    // Set fill color to green for the paddle
-    br.fill_color[0] = 0.0f; // Red component
-    br.fill_color[1] = 1.0f; // Green component
-    br.fill_color[2] = 0.0f; // Blue component
-
-    // Set outline color to white for better visibility
-    br.outline_color[0] = 1.0f; // Red component
-    br.outline_color[1] = 1.0f; // Green component
-    br.outline_color[2] = 1.0f; // Blue component
-    br.outline_width = 2.0f;    // Thickness of the outline
-
     // Draw the paddle as a rectangle at the Player's current position and size
-    graphics::drawRect(x, y, m_width, m_height, br);
+    list.drawRect(DrawLayer::WORLD, x, y, m_width, m_height, m_brush);
 }
@@ -1,6 +1,8 @@
 #pragma once
-#include "GameObject.h"
+#include "gameobject.h"
 #include "sgg/scancodes.h"
+#include "simulation.h"
+#include "brushcache.h"
 #include <string>
 
 /**
@@ -17,6 +19,8 @@ private:
 	graphics::scancode_t moveUpKey;      // Key to move the paddle up.
 	graphics::scancode_t moveDownKey;    // Key to move the paddle down.
 
+	BrushHandle m_brush;                 // Green paddle with a white outline.
+
 public:
     /**
      * @brief Constructor for the Player class.
@@ -27,14 +31,15 @@ public:
         float paddleWidth, float paddleHeight);
 
     /**
-     * @brief Updates the player's position and input.
+     * @brief Samples the player's movement keys.
+     * @return The paddle input to feed to the Simulation.
      */
-    void update(float dt) override;
+    PaddleInput readInput() const;
 
     /**
      * @brief Draws the player paddle on screen.
      */
-    void draw() override;
+    void draw(DrawList& list) override;
 
     // Getters
     float getWidth() const { return m_width; }
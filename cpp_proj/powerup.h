@@ -1,12 +1,14 @@
 #pragma once
-#include "GameObject.h"
-#include <string>
+
+struct PowerupStore;
+class DrawList;
 
 /**
  * @class Powerup
- * @brief Represents a powerup that affects the ball's behavior for a limited time.
+ * @brief Powerup types and rendering. Powerups affect the ball's behavior for a limited time;
+ * they are stored by the Simulation in a structure-of-arrays PowerupStore and drawn from it.
  */
-class Powerup : public GameObject
+class Powerup
 {
 public:
     enum class Type {
@@ -16,28 +18,17 @@ public:
         DECREASE_SIZE
     };
 
-private:
-    Type m_type;                    // Type of the powerup
-    std::string m_texture_file;     // Asset for the powerup
-
-public:
-    Powerup(GameState* gs, const std::string& name, Type type, float x, float y);
-
-    /*
-	* @brief Initializes the Powerup object.
-    */
-    void init() override;
-
-	/*
-	* @brief Updates the Powerup object.
-    */
-    void update(float dt) override;
-
-	/*
-	* @brief Draws the Powerup object.
-    */
-    void draw() override;
+    /**
+     * @brief Retrieves the texture asset of a powerup type.
+     * @param type The powerup type.
+     * @return The asset file name, or an empty string for undefined types.
+     */
+    static const char* getTextureFile(Type type);
 
-    // Powerup type getter
-    Type getType() const { return m_type; }
+    /**
+     * @brief Draws every active powerup of a store.
+     * @param powerups The powerups to draw.
+     * @param list Draw list of the frame.
+     */
+    static void drawAll(const PowerupStore& powerups, DrawList& list);
 };
@@ -0,0 +1,186 @@
+#include "profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+Profiler Profiler::s_instance;
+
+// Reference point of all timestamps
+static const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+
+/**
+ * @brief Current time in ns since the profiler was created.
+ *
+ * @return The time in ns.
+ */
+uint64_t Profiler::now() noexcept
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_epoch).count());
+}
+
+// Zones each frame of the ring holds without growing
+static const size_t RESERVED_EVENTS = 64;
+
+/**
+ * @brief Clears the recorded frames and starts a new one. The frames keep room for a typical
+ * frame's zones, so recording does not allocate.
+ */
+void Profiler::reset()
+{
+    for (ProfileFrame& frame : m_frames)
+    {
+        frame.events.clear();
+        frame.events.reserve(RESERVED_EVENTS);
+    }
+    m_current = 0;
+    m_completed = 0;
+    m_frame_index = 0;
+    m_depth = 0;
+    m_frames[0].index = 0;
+    m_frames[0].start_ns = now();
+}
+
+/**
+ * @brief Starts or stops recording. Enabling clears the recorded frames.
+ *
+ * @param enabled True to record zones.
+ */
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !m_enabled)
+        reset();
+    m_enabled = enabled;
+}
+
+/**
+ * @brief Sets the number of recent frames kept in the ring. Clears the recorded frames.
+ *
+ * @param frames Number of frames, at least 1.
+ */
+void Profiler::setFrameCapacity(size_t frames)
+{
+    m_frames.assign(frames > 0 ? frames : 1, ProfileFrame());
+    reset();
+}
+
+/**
+ * @brief Ends the current frame and starts the next one, overwriting the oldest frame once the
+ * ring is full. Event buffers keep their capacity, so steady-state recording does not allocate.
+ */
+void Profiler::nextFrame()
+{
+    if (!m_enabled)
+        return;
+
+    uint64_t time = now();
+    m_frames[m_current].end_ns = time;
+    if (m_completed < m_frames.size() - 1)
+        m_completed++;
+
+    m_current = (m_current + 1) % m_frames.size();
+    ProfileFrame& frame = m_frames[m_current];
+    frame.index = ++m_frame_index;
+    frame.start_ns = time;
+    frame.end_ns = time;
+    frame.events.clear();
+}
+
+/**
+ * @brief Opens a zone.
+ *
+ * @return The start time of the zone.
+ */
+uint64_t Profiler::enterZone() noexcept
+{
+    m_depth++;
+    return now();
+}
+
+/**
+ * @brief Closes the innermost zone and records it in the current frame.
+ *
+ * @param name Zone name (string literal).
+ * @param start_ns Start time returned by enterZone().
+ */
+void Profiler::leaveZone(const char* name, uint64_t start_ns) noexcept
+{
+    uint64_t end = now();
+    if (m_depth > 0)
+        m_depth--;
+    m_frames[m_current].events.push_back({ name, start_ns, end, m_depth });
+}
+
+/**
+ * @brief Retrieves a completed frame.
+ *
+ * @param age 0 for the last completed frame, up to getFrameCount() - 1 for the oldest.
+ * @return The frame.
+ */
+const ProfileFrame& Profiler::getFrame(size_t age) const
+{
+    size_t size = m_frames.size();
+    return m_frames[(m_current + size - 1 - age % size) % size];
+}
+
+/**
+ * @brief Appends a string as a JSON string literal.
+ */
+static void writeJsonString(std::string& out, const char* text)
+{
+    out += '"';
+    for (const char* c = text; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            out += '\\';
+        if (static_cast<unsigned char>(*c) >= 0x20)
+            out += *c;
+    }
+    out += '"';
+}
+
+/**
+ * @brief Appends one complete ("X") trace event. Times are converted to the microseconds the
+ * format expects.
+ */
+static void writeTraceEvent(std::string& out, const char* name, const char* category, uint64_t start_ns, uint64_t end_ns)
+{
+    char buffer[128];
+    out += "{\"name\":";
+    writeJsonString(out, name);
+    std::snprintf(buffer, sizeof(buffer), ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1},\n",
+        category, start_ns / 1000.0, (end_ns - start_ns) / 1000.0);
+    out += buffer;
+}
+
+/**
+ * @brief Writes the completed frames, oldest first, as a Chrome trace_event JSON file. Every frame
+ * appears as a "frame" event enclosing its zones.
+ *
+ * @param path File to write.
+ * @return False if the file could not be written.
+ */
+bool Profiler::exportChromeTrace(const std::string& path) const
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    char name[32];
+    for (size_t age = m_completed; age-- > 0;)
+    {
+        const ProfileFrame& frame = getFrame(age);
+        std::snprintf(name, sizeof(name), "frame %llu", static_cast<unsigned long long>(frame.index));
+        writeTraceEvent(json, name, "frame", frame.start_ns, frame.end_ns);
+        for (const ProfileEvent& event : frame.events)
+        {
+            writeTraceEvent(json, event.name, "zone", event.start_ns, event.end_ns);
+        }
+    }
+
+    // Drop the separator after the last event
+    if (json.size() >= 2 && json[json.size() - 2] == ',')
+        json.erase(json.size() - 2, 1);
+    json += "]}\n";
+
+    std::ofstream out(path, std::ios::binary);
+    out << json;
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compile-time switch of the profiler: with PONG_PROFILE=0 the PROFILE_* macros compile to
+ * nothing. When compiled in, zones still cost a single branch until the profiler is enabled.
+ */
+#ifndef PONG_PROFILE
+#define PONG_PROFILE 1
+#endif
+
+#if defined(__GNUC__)
+#define PROFILE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define PROFILE_UNLIKELY(x) (x)
+#endif
+
+/**
+ * @struct ProfileEvent
+ * @brief A completed timing zone.
+ */
+struct ProfileEvent
+{
+    const char* name;   ///< Zone name (string literal).
+    uint64_t start_ns;  ///< Start time since the profiler was created.
+    uint64_t end_ns;    ///< End time since the profiler was created.
+    uint32_t depth;     ///< Nesting depth, 0 for top-level zones.
+};
+
+/**
+ * @struct ProfileFrame
+ * @brief The zones recorded during one frame.
+ */
+struct ProfileFrame
+{
+    uint64_t index = 0;                 ///< Frame number since the profiler was enabled.
+    uint64_t start_ns = 0;
+    uint64_t end_ns = 0;
+    std::vector<ProfileEvent> events;   ///< Zones in the order they ended.
+};
+
+/**
+ * @class Profiler
+ * @brief Frame profiler: scoped zones timed with the steady clock are collected per frame into a
+ * ring of recent frames, which can be exported as a Chrome trace_event JSON file (chrome://tracing,
+ * Perfetto).
+ *
+ * Has no graphics dependency, so the headless tools profile the simulation the same way. Zones
+ * must be opened on the thread that calls nextFrame() (the game loop).
+ */
+class Profiler
+{
+public:
+    /**
+     * @brief Retrieves the singleton instance.
+     */
+    static Profiler& getInstance() { return s_instance; }
+
+    /**
+     * @brief Starts or stops recording. Enabling clears the recorded frames.
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Sets the number of recent frames kept. Clears the recorded frames.
+     */
+    void setFrameCapacity(size_t frames);
+
+    /**
+     * @brief Ends the current frame and starts the next one.
+     */
+    void nextFrame();
+
+    /**
+     * @brief Opens a zone. Used by ProfileZone.
+     * @return The start time of the zone.
+     */
+    uint64_t enterZone() noexcept;
+
+    /**
+     * @brief Closes the innermost zone. Used by ProfileZone.
+     */
+    void leaveZone(const char* name, uint64_t start_ns) noexcept;
+
+    /**
+     * @brief Number of completed frames available, at most the frame capacity.
+     */
+    size_t getFrameCount() const { return m_completed; }
+
+    /**
+     * @brief Retrieves a completed frame.
+     * @param age 0 for the last completed frame, 1 for the one before, and so on.
+     */
+    const ProfileFrame& getFrame(size_t age) const;
+
+    /**
+     * @brief Writes the completed frames as a Chrome trace_event JSON file.
+     * @return False if the file could not be written.
+     */
+    bool exportChromeTrace(const std::string& path) const;
+
+    /**
+     * @brief Current time in ns since the profiler was created.
+     */
+    static uint64_t now() noexcept;
+
+private:
+    static Profiler s_instance;
+
+    bool m_enabled = false;
+    std::vector<ProfileFrame> m_frames = std::vector<ProfileFrame>(240); // Ring of frames
+    size_t m_current = 0;       // Frame being recorded
+    size_t m_completed = 0;     // Completed frames in the ring
+    uint64_t m_frame_index = 0;
+    uint32_t m_depth = 0;       // Nesting depth of the open zones
+
+    void reset();
+};
+
+/**
+ * @class ProfileZone
+ * @brief Times the enclosing scope as a zone of the current frame. Use PROFILE_ZONE.
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name)
+        : m_name(name),
+        m_active(Profiler::getInstance().isEnabled())
+    {
+        if (PROFILE_UNLIKELY(m_active))
+            m_start = Profiler::getInstance().enterZone();
+    }
+
+    ~ProfileZone()
+    {
+        if (PROFILE_UNLIKELY(m_active))
+            Profiler::getInstance().leaveZone(m_name, m_start);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_name;
+    bool m_active;
+    uint64_t m_start = 0;
+};
+
+#if PONG_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_FRAME() do { if (Profiler::getInstance().isEnabled()) Profiler::getInstance().nextFrame(); } while (0)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
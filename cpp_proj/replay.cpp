@@ -0,0 +1,346 @@
+#include "replay.h"
+#include <fstream>
+#include <cstring>
+#include <iterator>
+
+// File header: magic and format version
+static const char REPLAY_MAGIC[4] = { 'P', 'R', 'P', 'L' };
+static const uint8_t REPLAY_VERSION = 5;
+
+// Free space kept in the encoded inputs at every level load, so a level's input changes do not
+// grow the buffer during gameplay (thousands of changes)
+static const size_t INPUT_HEADROOM = 16 * 1024;
+
+/**
+ * @brief Appends an unsigned integer as a little-endian base-128 varint.
+ */
+static void writeVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Reads a varint written by writeVarint().
+ * @return False if the data ends in the middle of the varint or it is too long.
+ */
+static bool readVarint(const std::vector<uint8_t>& in, size_t& offset, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (offset >= in.size())
+            return false;
+        uint8_t byte = in[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Appends a fixed-size little-endian integer.
+ */
+template <typename T>
+static void writeFixed(std::vector<uint8_t>& out, T value)
+{
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Reads a fixed-size little-endian integer.
+ */
+template <typename T>
+static bool readFixed(const std::vector<uint8_t>& in, size_t& offset, T& value)
+{
+    if (in.size() - offset < sizeof(T))
+        return false;
+    value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        value |= static_cast<T>(in[offset++]) << (8 * i);
+    }
+    return true;
+}
+
+static void writeFloat(std::vector<uint8_t>& out, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeFixed(out, bits);
+}
+
+static bool readFloat(const std::vector<uint8_t>& in, size_t& offset, float& value)
+{
+    uint32_t bits;
+    if (!readFixed(in, offset, bits))
+        return false;
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+/**
+ * @brief Packs the input of both paddles into 4 bits.
+ *
+ * @param input The input to pack.
+ * @return Bit 0: P1 up, bit 1: P1 down, bit 2: P2 up, bit 3: P2 down.
+ */
+uint8_t encodeInput(const SimInput& input)
+{
+    return static_cast<uint8_t>(
+        (input.player1.up ? 1 : 0) |
+        (input.player1.down ? 2 : 0) |
+        (input.player2.up ? 4 : 0) |
+        (input.player2.down ? 8 : 0));
+}
+
+/**
+ * @brief Unpacks 4 input bits produced by encodeInput().
+ *
+ * @param bits The packed input.
+ * @return The input of both paddles.
+ */
+SimInput decodeInput(uint8_t bits)
+{
+    SimInput input;
+    input.player1.up = (bits & 1) != 0;
+    input.player1.down = (bits & 2) != 0;
+    input.player2.up = (bits & 4) != 0;
+    input.player2.down = (bits & 8) != 0;
+    return input;
+}
+
+/**
+ * @brief Starts a new recording, discarding any previous one.
+ *
+ * @param seed Seed of the simulation about to be played.
+ * @param config Gameplay constants of the simulation.
+ * @param levels Level definitions of the simulation.
+ */
+void ReplayRecorder::begin(uint32_t seed, const SimConfig& config, const LevelSet& levels)
+{
+    m_replay = Replay();
+    m_replay.seed = seed;
+    m_replay.config = config;
+    m_replay.levels_hash = levels.getHash();
+    m_replay.inputs.reserve(INPUT_HEADROOM);
+    m_run_bits = 0;
+    m_run_length = 0;
+    m_recording = true;
+}
+
+/**
+ * @brief Writes the current input run, if any, to the encoded inputs.
+ */
+void ReplayRecorder::flushRun()
+{
+    if (m_run_length > 0)
+    {
+        writeVarint(m_replay.inputs, (m_run_length << 4) | m_run_bits);
+        m_run_length = 0;
+    }
+}
+
+/**
+ * @brief Appends the input of one or more ticks, extending the current run if the input is unchanged.
+ *
+ * @param input Paddle input applied to the ticks.
+ * @param ticks Number of ticks simulated with this input.
+ */
+void ReplayRecorder::record(const SimInput& input, int ticks)
+{
+    if (!m_recording || ticks <= 0)
+        return;
+
+    uint8_t bits = encodeInput(input);
+    if (m_run_length > 0 && bits != m_run_bits)
+    {
+        flushRun();
+    }
+    m_run_bits = bits;
+    m_run_length += ticks;
+    m_replay.tick_count += ticks;
+}
+
+/**
+ * @brief Records a call to Simulation::loadLevel() as a run of zero ticks followed by the level
+ * number, and makes room for the input of the level.
+ *
+ * @param level_number The level loaded.
+ */
+void ReplayRecorder::recordLevelLoad(int level_number)
+{
+    if (!m_recording)
+        return;
+
+    flushRun();
+    writeVarint(m_replay.inputs, 0);
+    writeVarint(m_replay.inputs, static_cast<uint64_t>(level_number));
+    if (m_replay.inputs.capacity() - m_replay.inputs.size() < INPUT_HEADROOM)
+        m_replay.inputs.reserve(m_replay.inputs.size() + INPUT_HEADROOM);
+}
+
+/**
+ * @brief Ends the recording.
+ *
+ * @param final_hash State hash of the simulation after the last recorded tick.
+ * @return The finished replay.
+ */
+const Replay& ReplayRecorder::finish(uint64_t final_hash)
+{
+    flushRun();
+    m_replay.final_hash = final_hash;
+    m_recording = false;
+    return m_replay;
+}
+
+/**
+ * @brief Reads the next entry: either the input of one tick or a level load.
+ *
+ * @param input Receives the input of the tick.
+ * @param level_number Receives the level loaded, or 0 if the entry is a tick.
+ * @return False once all entries have been read or the data is corrupt.
+ */
+bool ReplayReader::next(SimInput& input, int& level_number)
+{
+    level_number = 0;
+    if (m_run_left == 0)
+    {
+        uint64_t run;
+        if (!readVarint(m_replay.inputs, m_offset, run))
+            return false;
+
+        m_run_bits = static_cast<uint8_t>(run & 0x0F);
+        m_run_left = run >> 4;
+        if (m_run_left == 0)
+        {
+            uint64_t number;
+            if (!readVarint(m_replay.inputs, m_offset, number) || number == 0 || number > INT32_MAX)
+                return false;
+            level_number = static_cast<int>(number);
+            return true;
+        }
+    }
+
+    m_run_left--;
+    input = decodeInput(m_run_bits);
+    return true;
+}
+
+/**
+ * @brief Writes a replay to a compact binary file.
+ *
+ * Layout (little-endian): magic "PRPL", version byte, seed, the SimConfig floats, level set
+ * hash, tick count, final state hash, length of the encoded inputs, encoded inputs.
+ *
+ * @param path File to write.
+ * @param replay The replay to write.
+ * @return False if the file could not be written.
+ */
+bool saveReplay(const std::string& path, const Replay& replay)
+{
+    std::vector<uint8_t> data(REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    data.push_back(REPLAY_VERSION);
+    writeFixed(data, replay.seed);
+    writeFloat(data, replay.config.ball_speed);
+    writeFloat(data, replay.config.sudden_death_speed_factor);
+    writeFloat(data, replay.config.speed_up_factor);
+    writeFloat(data, replay.config.slow_down_factor);
+    writeFloat(data, replay.config.tick_rate);
+    writeFixed(data, replay.levels_hash);
+    writeFixed(data, replay.tick_count);
+    writeFixed(data, replay.final_hash);
+    writeVarint(data, replay.inputs.size());
+    data.insert(data.end(), replay.inputs.begin(), replay.inputs.end());
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Reads a replay written by saveReplay().
+ *
+ * @param path File to read.
+ * @param replay Receives the replay.
+ * @return False if the file could not be read or is not a valid replay.
+ */
+bool loadReplay(const std::string& path, Replay& replay)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(REPLAY_MAGIC) + 1 ||
+        std::memcmp(data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+        data[sizeof(REPLAY_MAGIC)] != REPLAY_VERSION)
+        return false;
+
+    size_t offset = sizeof(REPLAY_MAGIC) + 1;
+    uint64_t input_size;
+    if (!readFixed(data, offset, replay.seed) ||
+        !readFloat(data, offset, replay.config.ball_speed) ||
+        !readFloat(data, offset, replay.config.sudden_death_speed_factor) ||
+        !readFloat(data, offset, replay.config.speed_up_factor) ||
+        !readFloat(data, offset, replay.config.slow_down_factor) ||
+        !readFloat(data, offset, replay.config.tick_rate) ||
+        !readFixed(data, offset, replay.levels_hash) ||
+        !readFixed(data, offset, replay.tick_count) ||
+        !readFixed(data, offset, replay.final_hash) ||
+        !readVarint(data, offset, input_size) ||
+        data.size() - offset != input_size)
+        return false;
+
+    replay.inputs.assign(data.begin() + offset, data.end());
+    return true;
+}
+
+/**
+ * @brief Plays back a replay headlessly, as fast as possible.
+ *
+ * @param replay The replay to play.
+ * @param levels Level definitions of the match.
+ * @param sim Receives the simulation state after the last tick.
+ * @return True if the final state hash matches the recorded one; false without playing if levels
+ * is not the recorded set.
+ */
+bool playReplay(const Replay& replay, const LevelSet& levels, Simulation& sim)
+{
+    sim = Simulation(replay.seed, replay.config);
+    sim.setLevels(levels);
+    if (levels.getHash() != replay.levels_hash)
+        return false;
+    sim.seed(replay.seed); // The recording starts with its own load of Level 1
+
+    ReplayReader reader(replay);
+    SimInput input;
+    int level_number;
+    while (reader.next(input, level_number))
+    {
+        if (level_number != 0)
+        {
+            if (sim.isLevelOver())
+                sim.resolveLevelEnd();
+            sim.loadLevel(level_number);
+        }
+        else
+        {
+            sim.clearEvents();
+            sim.tick(input);
+        }
+    }
+
+    if (sim.isLevelOver())
+        sim.resolveLevelEnd();
+    sim.clearEvents();
+    return sim.getStateHash() == replay.final_hash;
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+/**
+ * @struct Replay
+ * @brief Everything needed to reproduce a match bit-for-bit: the simulation seed and
+ * configuration, a hash of the levels played, plus the paddle input of every tick.
+ *
+ * Inputs are stored run-length encoded: each run is a varint holding (tick count << 4) | input bits,
+ * so held or released keys cost a few bytes per change rather than per tick. A run of zero ticks
+ * marks a call to Simulation::loadLevel(), followed by the level number as a varint of its own, so
+ * level transitions replay exactly as the game performed them.
+ */
+struct Replay
+{
+    uint32_t seed = 0;              ///< Seed the simulation was created with.
+    SimConfig config;               ///< Gameplay constants of the match.
+    uint64_t levels_hash = 0;       ///< LevelSet::getHash() of the levels of the match.
+    uint64_t tick_count = 0;        ///< Number of recorded ticks.
+    uint64_t final_hash = 0;        ///< Simulation::getStateHash() after the last tick.
+    std::vector<uint8_t> inputs;    ///< Run-length encoded input bits.
+};
+
+/**
+ * @brief Packs the input of both paddles into 4 bits (P1 up, P1 down, P2 up, P2 down).
+ */
+uint8_t encodeInput(const SimInput& input);
+
+/**
+ * @brief Unpacks 4 input bits produced by encodeInput().
+ */
+SimInput decodeInput(uint8_t bits);
+
+/**
+ * @class ReplayRecorder
+ * @brief Records the per-tick input of a match into a Replay.
+ */
+class ReplayRecorder
+{
+private:
+    Replay m_replay;
+    uint8_t m_run_bits = 0;     // Input bits of the current run
+    uint64_t m_run_length = 0;  // Ticks in the current run (0 = no run yet)
+    bool m_recording = false;
+
+    void flushRun();
+
+public:
+    /**
+     * @brief Starts a new recording, discarding any previous one.
+     * @param seed Seed of the simulation about to be played.
+     * @param config Gameplay constants of the simulation.
+     * @param levels Level definitions of the simulation.
+     */
+    void begin(uint32_t seed, const SimConfig& config, const LevelSet& levels);
+
+    /**
+     * @brief Appends the input of one or more ticks.
+     * @param input Paddle input applied to the ticks.
+     * @param ticks Number of ticks simulated with this input.
+     */
+    void record(const SimInput& input, int ticks = 1);
+
+    /**
+     * @brief Records a call to Simulation::loadLevel(). Also reserves room for thousands of input
+     * changes, so recording the level's ticks does not allocate.
+     * @param level_number The level loaded.
+     */
+    void recordLevelLoad(int level_number);
+
+    /**
+     * @brief Ends the recording.
+     * @param final_hash State hash of the simulation after the last recorded tick.
+     * @return The finished replay.
+     */
+    const Replay& finish(uint64_t final_hash);
+
+    /**
+     * @brief Checks if a recording is in progress.
+     */
+    bool isRecording() const { return m_recording; }
+
+    /**
+     * @brief Retrieves the replay recorded so far (complete once finish() was called).
+     */
+    const Replay& getReplay() const { return m_replay; }
+};
+
+/**
+ * @class ReplayReader
+ * @brief Decodes the per-tick inputs of a Replay in order.
+ */
+class ReplayReader
+{
+private:
+    const Replay& m_replay;
+    size_t m_offset = 0;        // Read position in the encoded inputs
+    uint8_t m_run_bits = 0;
+    uint64_t m_run_left = 0;    // Ticks left in the current run
+
+public:
+    /**
+     * @brief Creates a reader positioned at the first tick.
+     */
+    explicit ReplayReader(const Replay& replay) : m_replay(replay) {}
+
+    /**
+     * @brief Reads the next entry: either the input of one tick or a level load.
+     * @param input Receives the input of the tick.
+     * @param level_number Receives the level loaded, or 0 if the entry is a tick.
+     * @return False once all entries have been read or the data is corrupt.
+     */
+    bool next(SimInput& input, int& level_number);
+};
+
+/**
+ * @brief Writes a replay to a compact binary file.
+ * @return False if the file could not be written.
+ */
+bool saveReplay(const std::string& path, const Replay& replay);
+
+/**
+ * @brief Reads a replay written by saveReplay().
+ * @return False if the file could not be read or is not a valid replay.
+ */
+bool loadReplay(const std::string& path, Replay& replay);
+
+/**
+ * @brief Plays back a replay headlessly, as fast as possible.
+ *
+ * The simulation is recreated from the replay's seed and configuration, and levels are loaded
+ * wherever the recording loaded them. When a level is over before a load or at the end of the
+ * replay, its outcome is resolved like the game does, so the winner matches too.
+ *
+ * @param replay The replay to play.
+ * @param levels Level definitions of the match; must be the set the replay was recorded with.
+ * @param sim Receives the simulation state after the last tick. It refers to levels.
+ * @return True if the final state hash matches the recorded one. False without playing if levels
+ * is not the recorded set.
+ */
+bool playReplay(const Replay& replay, const LevelSet& levels, Simulation& sim);
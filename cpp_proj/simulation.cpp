@@ -0,0 +1,1077 @@
+#include "simulation.h"
+#include "profiler.h"
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+
+// Ball tuning
+static const float BALL_SIZE = 15.0f;                   // Ball width and height
+static const float RAMP_UP_MS = 1000.0f;                // Duration of the serve ramp-up
+static const float POWERUP_DURATION_MS = 4000.0f;       // Duration of a powerup effect
+
+// Paddle layout
+static const float PADDLE_OFFSET_X = 50.0f;             // Distance of the paddles from the side walls
+static const float PADDLE_WIDTH = 10.0f;
+static const float PADDLE_HEIGHT = 70.0f;
+static const float PADDLE_SPEED = 1.0f;
+
+// Obstacle dimensions
+static const float OBSTACLE_WIDTH = 10.0f;
+static const float OBSTACLE_HEIGHT = 100.0f;
+
+// Powerup dimensions (square)
+static const float POWERUP_SIZE = 50.0f;
+
+// Frame time a single advance() consumes at most, in ms; a longer stall is dropped rather than
+// caught up, which bounds the ticks (and events) of a frame
+static const float MAX_ADVANCE_MS = 250.0f;
+
+// Events a ball contact raises at most (hitting an obstacle and breaking it)
+static const size_t EVENTS_PER_CONTACT = 2;
+
+// Stores with at most this many slots are swept whole: for the few objects of the built-in levels
+// a grid query costs more than it saves
+static const size_t MIN_GRID_OBJECTS = 16;
+
+/**
+ * @brief Constructs a new Simulation.
+ *
+ * Seeds the random engine and loads Level 1 of the built-in levels so the simulation is always in a
+ * valid state.
+ *
+ * @param seed Seed of the random engine driving serves and spawns.
+ * @param config Gameplay constants to use.
+ */
+Simulation::Simulation(uint32_t seed, const SimConfig& config)
+    : m_levels(&LevelSet::getDefault()),
+    m_level(nullptr),
+    m_rng(seed),
+    m_config(config),
+    m_tick_ms(1000.0f / config.tick_rate),
+    m_obstacle_grid(CANVAS_WIDTH, CANVAS_HEIGHT, config.grid_cell_size),
+    m_powerup_grid(CANVAS_WIDTH, CANVAS_HEIGHT, config.grid_cell_size)
+{
+    m_max_advance_ticks = static_cast<int>(MAX_ADVANCE_MS / m_tick_ms) + 1; // + the carried-over time
+    loadLevel(1);
+}
+
+/**
+ * @brief Resets paddles, ball, obstacles, powerups and spawn schedules for a level.
+ *
+ * Everything specific to the level comes from its definition: the time limit, the obstacles
+ * present from the start, the powerup schedule and the random spawners. Levels that reset the
+ * scores start both players from 0; every other level carries the scores over from the previous one.
+ *
+ * @param level_number The level number to load. An unknown number loads the first level of the set.
+ */
+void Simulation::loadLevel(int level_number)
+{
+    const LevelDef* level = m_levels->find(level_number);
+    if (!level)
+        level = &m_levels->getLevels().front();
+
+    m_level = level;
+    m_level_number = level->number;
+    m_level_timer = level->time_limit * 10.0f;
+    m_elapsed_time = 0.0f;
+    m_accumulator = 0.0f;
+    m_tick = 0;
+    m_speed_multiplier = 1.0f;
+    m_last_player_to_hit = 0;
+    m_winner = 0;
+
+    m_obstacles.clear();
+    m_powerups.clear();
+    m_obstacle_grid.clear();
+    m_powerup_grid.clear();
+    m_events.clear();
+    reserveEvents();
+
+    if (level->reset_scores)
+    {
+        resetScores();
+    }
+
+    // Paddles
+    for (int i = 0; i < 2; i++)
+    {
+        SimPaddle& paddle = m_paddles[i];
+        paddle.x = (i == 0) ? PADDLE_OFFSET_X : CANVAS_WIDTH - PADDLE_OFFSET_X;
+        paddle.y = CANVAS_HEIGHT / 2.0f;
+        paddle.width = PADDLE_WIDTH;
+        paddle.height = PADDLE_HEIGHT;
+        paddle.speed = PADDLE_SPEED;
+    }
+
+    // Ball
+    m_ball = SimBall();
+    m_ball.base_width = BALL_SIZE;
+    m_ball.base_height = BALL_SIZE;
+    m_ball.speed = m_config.ball_speed;
+    resetBall();
+
+    // Increase ball speed in Sudden Death (applies from the next serve on)
+    if (level->sudden_death)
+    {
+        m_ball.speed *= m_config.sudden_death_speed_factor;
+    }
+
+    // Make room for every object the level can hold, so spawning does not allocate mid-game
+    size_t obstacle_count = level->obstacle_type.size();
+    size_t powerup_count = level->powerup_type.size();
+    for (const LevelSpawner& spawner : level->spawners)
+    {
+        size_t& count = spawner.kind == LevelSpawner::Kind::OBSTACLE ? obstacle_count : powerup_count;
+        count += static_cast<size_t>(spawner.limit);
+    }
+    reserveObjects(obstacle_count, powerup_count);
+
+    // Obstacles present from the start
+    for (size_t i = 0; i < level->obstacle_type.size(); i++)
+    {
+        addObstacle(static_cast<Obstacle::Type>(level->obstacle_type[i]), level->obstacle_x[i], level->obstacle_y[i],
+            level->obstacle_hit_points[i], level->obstacle_speed[i]);
+    }
+
+    // Spawn schedules
+    m_next_powerup_spawn_time = level->powerup_first_time;
+    m_powerups_spawned = 0;
+
+    m_spawners.assign(level->spawners.size(), SpawnerState());
+    for (size_t i = 0; i < m_spawners.size(); i++)
+    {
+        m_spawners[i].next_time = level->spawners[i].first_time;
+    }
+    m_spawned_by_kind[0] = 0;
+    m_spawned_by_kind[1] = 0;
+}
+
+/**
+ * @brief Makes room for the objects of a level in the stores, the grids and the sweep scratch.
+ * Capacity is kept across levels, so only a level with more objects than any before allocates.
+ *
+ * @param obstacles Obstacles the level can hold.
+ * @param powerups Powerups the level can hold.
+ */
+void Simulation::reserveObjects(size_t obstacles, size_t powerups)
+{
+    m_obstacles.reserve(obstacles);
+    m_powerups.reserve(powerups);
+    m_obstacle_grid.reserve(obstacles);
+    m_powerup_grid.reserve(powerups);
+
+    size_t candidates = std::max(obstacles, powerups);
+    m_sweep.indices.reserve(candidates);
+    m_sweep.x.reserve(candidates);
+    m_sweep.y.reserve(candidates);
+    m_sweep.width.reserve(candidates);
+    m_sweep.height.reserve(candidates);
+    m_sweep.active.reserve(candidates);
+    m_sweep.times.reserve(candidates);
+    m_sweep.hits.reserve(candidates);
+}
+
+/**
+ * @brief Resets both scores and the winner.
+ */
+void Simulation::resetScores()
+{
+    m_player1_score = 0;
+    m_player2_score = 0;
+    m_winner = 0;
+}
+
+/**
+ * @brief Reserves the event list for the events the current level raises at most between two
+ * clearEvents(): per tick the ball contacts, a powerup expiry, a scheduled powerup and one spawn
+ * per spawner, times the ticks of the longest advance() if reserveFrameEvents() was called.
+ */
+void Simulation::reserveEvents()
+{
+    size_t events_per_tick = EVENTS_PER_CONTACT * MAX_BALL_CONTACTS + 2 + m_level->spawners.size();
+    size_t ticks = m_frame_events ? static_cast<size_t>(m_max_advance_ticks) : 1;
+    m_events.reserve(ticks * events_per_tick);
+}
+
+/**
+ * @brief Makes room for the events of the longest advance(), now and at every level load, so a
+ * frame never grows the event list.
+ */
+void Simulation::reserveFrameEvents()
+{
+    m_frame_events = true;
+    reserveEvents();
+}
+
+/**
+ * @brief Consumes frame time in fixed ticks.
+ *
+ * Frame time is accumulated and simulated in steps of the tick duration, so the outcome does not
+ * depend on the frame rate. Leftover time is carried over to the next call. Frame time beyond
+ * MAX_ADVANCE_MS is dropped, so a stalled frame runs a bounded number of ticks. Once the
+ * level is over no further ticks are simulated.
+ *
+ * @param dt Frame time in ms.
+ * @param input Paddle input applied to every tick of this frame.
+ * @return The number of ticks simulated.
+ */
+int Simulation::advance(float dt, const SimInput& input)
+{
+    m_events.clear();
+    m_accumulator += std::min(dt, MAX_ADVANCE_MS);
+
+    int ticks = 0;
+    while (m_accumulator >= m_tick_ms)
+    {
+        if (isLevelOver())
+        {
+            m_accumulator = 0.0f;
+            break;
+        }
+        tick(input);
+        m_accumulator -= m_tick_ms;
+        ticks++;
+    }
+    return ticks;
+}
+
+/**
+ * @brief Simulates exactly one fixed tick: spawning, movement, and all collision responses.
+ *
+ * @param input Paddle input for this tick.
+ */
+void Simulation::tick(const SimInput& input)
+{
+    PROFILE_ZONE("Simulation::tick");
+
+    const float dt = m_tick_ms;
+    m_tick++;
+
+    // 1. Update Level Timer (unless the level has no time limit)
+    if (m_level->time_limit > 0.0f)
+    {
+        m_level_timer -= dt / 100.0f;
+        if (m_level_timer < 0.0f)
+        {
+            m_level_timer = 0.0f;
+        }
+    }
+    m_elapsed_time += dt / 1000.0f;
+
+    // 2. Spawning
+    spawnObjects();
+
+    // 3. Movement of paddles and obstacles
+    moveObjects(input, dt);
+
+    // 4. Ball movement with collision detection and response
+    moveBall(dt);
+
+    // 5. Winning score
+    checkWinScore();
+
+    // 6. Removal of broken obstacles and collected powerups
+    compactObjects();
+}
+
+/**
+ * @brief Checks if the current level is over.
+ *
+ * @return True if the level timer ran out or the match has a winner.
+ */
+bool Simulation::isLevelOver() const
+{
+    if (m_winner != 0)
+        return true;
+    return m_level->time_limit > 0.0f && m_level_timer <= 0.0f;
+}
+
+/**
+ * @brief Applies the progression rules once a level is over.
+ *
+ * A level with a next level advances to it. Otherwise the higher score wins the match, and a tie
+ * leads to the tie level (Sudden Death in the built-in levels), which is won by the first player
+ * to reach its win score.
+ *
+ * @return The next level number to load, or 0 if the match is over.
+ */
+int Simulation::resolveLevelEnd()
+{
+    if (m_winner != 0)
+        return 0;
+
+    if (m_level->next_level != 0)
+        return m_level->next_level;
+
+    if (m_player1_score > m_player2_score)
+    {
+        m_winner = 1;
+        return 0;
+    }
+    if (m_player2_score > m_player1_score)
+    {
+        m_winner = 2;
+        return 0;
+    }
+    return m_level->tie_level;
+}
+
+/**
+ * @brief Mixes a value into an FNV-1a hash, byte by byte.
+ */
+template <typename T>
+static void hashValue(uint64_t& hash, const T& value)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (unsigned char byte : bytes)
+    {
+        hash ^= byte;
+        hash *= 0x100000001B3ull;
+    }
+}
+
+/**
+ * @brief Computes a hash of the complete gameplay state.
+ *
+ * Floats are hashed by their bit patterns, so two simulations only have the same hash if they
+ * are bit-for-bit identical. Used to verify that a replay reproduces the recorded match.
+ *
+ * @return The 64-bit FNV-1a hash of the state.
+ */
+uint64_t Simulation::getStateHash() const
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hashValue(hash, m_level_number);
+    hashValue(hash, m_level_timer);
+    hashValue(hash, m_elapsed_time);
+    hashValue(hash, m_tick);
+    hashValue(hash, m_player1_score);
+    hashValue(hash, m_player2_score);
+    hashValue(hash, m_winner);
+    hashValue(hash, m_speed_multiplier);
+
+    for (const SimPaddle& paddle : m_paddles)
+    {
+        hashValue(hash, paddle.x);
+        hashValue(hash, paddle.y);
+    }
+
+    hashValue(hash, m_ball.x);
+    hashValue(hash, m_ball.y);
+    hashValue(hash, m_ball.width);
+    hashValue(hash, m_ball.height);
+    hashValue(hash, m_ball.speed_x);
+    hashValue(hash, m_ball.speed_y);
+    hashValue(hash, m_ball.powerup_active);
+
+    for (size_t i = 0; i < m_obstacles.size(); i++)
+    {
+        hashValue(hash, m_obstacles.x[i]);
+        hashValue(hash, m_obstacles.y[i]);
+        hashValue(hash, m_obstacles.hit_points[i]);
+        hashValue(hash, m_obstacles.active[i]);
+    }
+    for (size_t i = 0; i < m_powerups.size(); i++)
+    {
+        hashValue(hash, m_powerups.x[i]);
+        hashValue(hash, m_powerups.y[i]);
+        hashValue(hash, m_powerups.active[i]);
+    }
+    return hash;
+}
+
+/**
+ * @brief Spawns the level's powerups at fixed positions and the objects of its random spawners.
+ */
+void Simulation::spawnObjects()
+{
+    PROFILE_ZONE("Simulation::spawnObjects");
+
+    const LevelDef& level = *m_level;
+
+    // Powerups at fixed positions, one after another
+    if (m_powerups_spawned < static_cast<int>(level.powerup_type.size()) &&
+        m_elapsed_time >= m_next_powerup_spawn_time)
+    {
+        size_t i = static_cast<size_t>(m_powerups_spawned);
+        addPowerup(static_cast<Powerup::Type>(level.powerup_type[i]), level.powerup_x[i], level.powerup_y[i]);
+        m_powerups_spawned++;
+
+        // Schedule the next powerup
+        m_next_powerup_spawn_time += getRandomFloat(level.powerup_interval_min, level.powerup_interval_max);
+    }
+
+    // Random spawners, in the order they are defined
+    for (size_t i = 0; i < level.spawners.size(); i++)
+    {
+        const LevelSpawner& spawner = level.spawners[i];
+        SpawnerState& state = m_spawners[i];
+        int& kind_spawned = m_spawned_by_kind[static_cast<size_t>(spawner.kind)];
+
+        if (state.spawned >= spawner.limit ||
+            (spawner.total_limit > 0 && kind_spawned >= spawner.total_limit) ||
+            m_elapsed_time < state.next_time)
+            continue;
+
+        float x = getRandomFloat(spawner.min_x, spawner.max_x);
+        float y = getRandomFloat(spawner.min_y, spawner.max_y);
+
+        // Skip this attempt if the location is too close to existing objects
+        if (spawner.min_distance > 0.0f && !isSpawnClear(x, y, spawner.min_distance))
+            continue;
+
+        if (spawner.kind == LevelSpawner::Kind::OBSTACLE)
+        {
+            addObstacle(static_cast<Obstacle::Type>(spawner.obstacle_type), x, y, spawner.hit_points, spawner.speed);
+        }
+        else
+        {
+            // Cycle through the types of the spawner
+            size_t type = static_cast<size_t>(state.spawned) % spawner.powerup_types.size();
+            addPowerup(static_cast<Powerup::Type>(spawner.powerup_types[type]), x, y);
+        }
+
+        state.spawned++;
+        kind_spawned++;
+        state.next_time = m_elapsed_time + getRandomFloat(spawner.interval_min, spawner.interval_max);
+    }
+}
+
+/**
+ * @brief Checks that no obstacle or powerup is centered within a distance of a location.
+ *
+ * Any object whose center is in range overlaps the square around the location, so only the grid
+ * cells under that square need checking.
+ *
+ * @param x Location to check.
+ * @param y Location to check.
+ * @param distance Minimum distance to the center of every object.
+ * @return True if every object is far enough away.
+ */
+bool Simulation::isSpawnClear(float x, float y, float distance) const
+{
+    const float min_dist_sq = distance * distance;
+    const Box region(x, y, distance * 2.0f, distance * 2.0f);
+    std::vector<uint32_t>& nearby = m_sweep.indices;
+
+    m_obstacle_grid.query(region, nearby);
+    for (uint32_t i : nearby)
+    {
+        float dx = x - m_obstacles.x[i];
+        float dy = y - m_obstacles.y[i];
+        if (dx * dx + dy * dy < min_dist_sq)
+            return false;
+    }
+
+    m_powerup_grid.query(region, nearby);
+    for (uint32_t i : nearby)
+    {
+        float dx = x - m_powerups.x[i];
+        float dy = y - m_powerups.y[i];
+        if (dx * dx + dy * dy < min_dist_sq)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Moves the paddles from their input, ramps up a freshly served ball, expires its powerup,
+ * and moves the moving obstacles. The ball itself is moved by moveBall().
+ *
+ * @param input Paddle input for this tick.
+ * @param dt Tick duration in ms.
+ */
+void Simulation::moveObjects(const SimInput& input, float dt)
+{
+    PROFILE_ZONE("Simulation::moveObjects");
+
+    // Paddles
+    const PaddleInput* inputs[2] = { &input.player1, &input.player2 };
+    for (int i = 0; i < 2; i++)
+    {
+        SimPaddle& paddle = m_paddles[i];
+        if (inputs[i]->up)
+            paddle.y -= paddle.speed * dt;
+        if (inputs[i]->down)
+            paddle.y += paddle.speed * dt;
+
+        // Keep the paddle within the canvas
+        float half_height = paddle.height / 2.0f;
+        if (paddle.y + half_height > CANVAS_HEIGHT)
+            paddle.y = CANVAS_HEIGHT - half_height;
+        if (paddle.y - half_height < 0.0f)
+            paddle.y = half_height;
+    }
+
+    // Ball ramp-up after a serve
+    if (m_ball.ramping_up)
+    {
+        m_ball.ramp_elapsed += dt;
+        float progress = std::min(1.0f, m_ball.ramp_elapsed / RAMP_UP_MS);
+        m_ball.speed_x = m_ball.target_speed_x * progress;
+        m_ball.speed_y = m_ball.target_speed_y * progress;
+
+        if (progress >= 1.0f)
+        {
+            m_ball.ramping_up = false;
+        }
+    }
+
+    updateBallPowerup(dt);
+
+    // Unbreakable obstacles move vertically and bounce off the top and bottom walls
+    const size_t obstacle_count = m_obstacles.size();
+    float* obstacle_y = m_obstacles.y.data();
+    float* direction = m_obstacles.direction.data();
+    const float* speed = m_obstacles.speed.data();
+    const float* height = m_obstacles.height.data();
+    const uint8_t* active = m_obstacles.active.data();
+    const Obstacle::Type* type = m_obstacles.type.data();
+
+    for (size_t i = 0; i < obstacle_count; i++)
+    {
+        if (!active[i] || type[i] != Obstacle::Type::Unbreakable)
+            continue;
+
+        float new_y = obstacle_y[i] + speed[i] * direction[i] * dt;
+        float half_height = height[i] / 2.0f;
+
+        if (new_y + half_height >= CANVAS_HEIGHT)
+        {
+            new_y = CANVAS_HEIGHT - half_height;
+            direction[i] = -1.0f;
+        }
+        else if (new_y - half_height <= 0.0f)
+        {
+            new_y = half_height;
+            direction[i] = 1.0f;
+        }
+        obstacle_y[i] = new_y;
+        m_obstacle_grid.move(static_cast<uint32_t>(i), Box(m_obstacles.x[i], new_y, m_obstacles.width[i], height[i]));
+    }
+}
+
+/**
+ * @brief Views the arrays of a store as a batch for the sweep kernels.
+ */
+static BoxBatch makeBatch(const float* x, const float* y, const float* width, const float* height,
+    const uint8_t* active, size_t count)
+{
+    BoxBatch batch;
+    batch.x = x;
+    batch.y = y;
+    batch.width = width;
+    batch.height = height;
+    batch.active = active;
+    batch.count = count;
+    return batch;
+}
+
+/**
+ * @brief Finds the earliest contact of the ball moving by (dx, dy) from its current position.
+ *
+ * Goals are tested first so that reaching a goal and a wall at the same time scores, as before.
+ * Obstacles are ignored while the ball ramps up after a serve, and powerups while it ramps up or
+ * already carries a powerup. Obstacles and powerups are looked up in the broadphase grids and
+ * swept in SIMD batches (see sweepbatch.h).
+ *
+ * @param dx Movement of the ball on the x-axis.
+ * @param dy Movement of the ball on the y-axis.
+ * @return The earliest contact, or one with type NONE if the ball can move freely.
+ */
+Simulation::BallContact Simulation::findBallContact(float dx, float dy) const
+{
+    BallContact contact;
+    Box ball_box(m_ball.x, m_ball.y, m_ball.width, m_ball.height);
+
+    // Box covering the whole movement, to skip the sweep for boxes that are out of reach
+    Box swept_box(m_ball.x + dx / 2.0f, m_ball.y + dy / 2.0f, m_ball.width + fabs(dx), m_ball.height + fabs(dy));
+
+    auto consider = [&](BallContact::Type type, int index, const Box& box)
+    {
+        float normal_x, normal_y;
+        float time = ball_box.sweep(box, dx, dy, normal_x, normal_y);
+        if (time <= 1.0f && (contact.type == BallContact::Type::NONE || time < contact.time))
+        {
+            contact.type = type;
+            contact.index = index;
+            contact.time = time;
+            contact.normal_x = normal_x;
+            contact.normal_y = normal_y;
+            contact.box = box;
+        }
+    };
+
+    auto test = [&](BallContact::Type type, int index, const Box& box)
+    {
+        if (fabs(swept_box.m_pos_x - box.m_pos_x) * 2.0f > swept_box.m_width + box.m_width ||
+            fabs(swept_box.m_pos_y - box.m_pos_y) * 2.0f > swept_box.m_height + box.m_height)
+            return;
+        consider(type, index, box);
+    };
+
+    // Sweeps against the objects of a store as one batch. Only the earliest hit can be the next
+    // contact; ties go to the lowest store index. indices maps batch indices to store indices when
+    // the batch holds grid candidates (in ascending order), or is null for a whole store.
+    auto testBatch = [&](BallContact::Type type, const BoxBatch& batch, const uint32_t* indices)
+    {
+        sweepBatch(ball_box, dx, dy, batch, m_sweep.times, m_sweep.hits);
+        if (!m_sweep.hits.empty())
+        {
+            uint32_t i = m_sweep.hits.front().index;
+            uint32_t index = indices ? indices[i] : i;
+            consider(type, static_cast<int>(index), Box(batch.x[i], batch.y[i], batch.width[i], batch.height[i]));
+        }
+    };
+
+    // Small stores are swept whole; larger ones only in the grid cells the movement crosses
+    const Box query_box(swept_box.m_pos_x, swept_box.m_pos_y, swept_box.m_width + 1.0f, swept_box.m_height + 1.0f);
+
+    // Goals behind the paddles and the top/bottom walls, as boxes just outside the canvas
+    test(BallContact::Type::GOAL, 2, Box(-CANVAS_WIDTH / 2.0f, CANVAS_HEIGHT / 2.0f, CANVAS_WIDTH, CANVAS_HEIGHT * 3.0f));
+    test(BallContact::Type::GOAL, 1, Box(CANVAS_WIDTH * 1.5f, CANVAS_HEIGHT / 2.0f, CANVAS_WIDTH, CANVAS_HEIGHT * 3.0f));
+    test(BallContact::Type::WALL, 0, Box(CANVAS_WIDTH / 2.0f, -CANVAS_HEIGHT / 2.0f, CANVAS_WIDTH * 3.0f, CANVAS_HEIGHT));
+    test(BallContact::Type::WALL, 0, Box(CANVAS_WIDTH / 2.0f, CANVAS_HEIGHT * 1.5f, CANVAS_WIDTH * 3.0f, CANVAS_HEIGHT));
+
+    for (int i = 0; i < 2; i++)
+    {
+        const SimPaddle& paddle = m_paddles[i];
+        test(BallContact::Type::PADDLE, i + 1, Box(paddle.x, paddle.y, paddle.width, paddle.height));
+    }
+
+    if (!m_ball.ramping_up)
+    {
+        const ObstacleStore& o = m_obstacles;
+        if (o.size() > MIN_GRID_OBJECTS)
+        {
+            BoxBatch candidates = gatherCandidates(m_obstacle_grid, query_box, o.x.data(), o.y.data(), o.width.data(), o.height.data());
+            testBatch(BallContact::Type::OBSTACLE, candidates, m_sweep.indices.data());
+        }
+        else
+        {
+            BoxBatch all = makeBatch(o.x.data(), o.y.data(), o.width.data(), o.height.data(), o.active.data(), o.size());
+            testBatch(BallContact::Type::OBSTACLE, all, nullptr);
+        }
+    }
+
+    if (!m_ball.ramping_up && !m_ball.powerup_active)
+    {
+        const PowerupStore& p = m_powerups;
+        if (p.size() > MIN_GRID_OBJECTS)
+        {
+            BoxBatch candidates = gatherCandidates(m_powerup_grid, query_box, p.x.data(), p.y.data(), p.width.data(), p.height.data());
+            testBatch(BallContact::Type::POWERUP, candidates, m_sweep.indices.data());
+        }
+        else
+        {
+            BoxBatch all = makeBatch(p.x.data(), p.y.data(), p.width.data(), p.height.data(), p.active.data(), p.size());
+            testBatch(BallContact::Type::POWERUP, all, nullptr);
+        }
+    }
+    return contact;
+}
+
+/**
+ * @brief Collects the objects of a store that a grid finds in a region into the sweep scratch
+ * buffers, in ascending index order.
+ *
+ * @param grid Grid of the store's active objects.
+ * @param region Region to search.
+ * @param x Center x coordinates of the store.
+ * @param y Center y coordinates of the store.
+ * @param width Widths of the store.
+ * @param height Heights of the store.
+ * @return The candidates as a batch; index i of the batch is store index m_sweep.indices[i].
+ */
+BoxBatch Simulation::gatherCandidates(const SpatialGrid& grid, const Box& region, const float* x, const float* y,
+    const float* width, const float* height) const
+{
+    SweepScratch& s = m_sweep;
+    grid.query(region, s.indices);
+
+    s.x.clear();
+    s.y.clear();
+    s.width.clear();
+    s.height.clear();
+    for (uint32_t index : s.indices)
+    {
+        s.x.push_back(x[index]);
+        s.y.push_back(y[index]);
+        s.width.push_back(width[index]);
+        s.height.push_back(height[index]);
+    }
+    s.active.assign(s.indices.size(), 1); // The grids only hold active objects
+
+    return makeBatch(s.x.data(), s.y.data(), s.width.data(), s.height.data(), s.active.data(), s.indices.size());
+}
+
+/**
+ * @brief Moves the ball with continuous collision detection.
+ *
+ * The ball's box is swept along its movement for the tick, and every contact is resolved in
+ * the order it happens: the ball moves to the time of impact, the contact is handled, and the
+ * rest of the movement continues with the new velocity. A fast ball therefore cannot tunnel
+ * through paddles or obstacles, whatever the tick duration.
+ *
+ * @param dt Tick duration in ms.
+ */
+void Simulation::moveBall(float dt)
+{
+    PROFILE_ZONE("Simulation::moveBall");
+
+    if (!m_ball.powerup_active)
+    {
+        m_speed_multiplier = 1.0f; // Reset speed multiplier if no active powerup present
+    }
+
+    float remaining = dt;
+    for (int n = 0; n < MAX_BALL_CONTACTS && remaining > 0.0f; n++)
+    {
+        float dx = m_ball.speed_x * remaining;
+        float dy = m_ball.speed_y * remaining;
+
+        BallContact contact = findBallContact(dx, dy);
+        if (contact.type == BallContact::Type::NONE)
+        {
+            m_ball.x += dx;
+            m_ball.y += dy;
+            return;
+        }
+
+        // Advance to the time of impact
+        m_ball.x += dx * contact.time;
+        m_ball.y += dy * contact.time;
+        remaining -= remaining * contact.time;
+
+        switch (contact.type)
+        {
+        case BallContact::Type::GOAL:
+            // A new ball is served; the rest of the tick is dropped
+            onScore(contact.index);
+            return;
+
+        case BallContact::Type::WALL:
+            bounceBall(contact);
+            raise(SimEventType::WALL_BOUNCE);
+            break;
+
+        case BallContact::Type::PADDLE:
+            bounceBall(contact);
+            normalizeBallSpeed();
+            m_last_player_to_hit = contact.index;
+            raise(SimEventType::PADDLE_HIT, contact.index);
+            break;
+
+        case BallContact::Type::OBSTACLE:
+            bounceBall(contact);
+            hitObstacle(contact.index, contact.normal_x != 0.0f);
+            break;
+
+        case BallContact::Type::POWERUP:
+            collectPowerup(contact.index);
+            break;
+
+        case BallContact::Type::NONE:
+            break;
+        }
+    }
+    // Out of contacts for this tick (ball wedged between objects): the remaining movement is dropped
+}
+
+/**
+ * @brief Places the ball just outside the box it touched and reflects its velocity along the
+ * contact normal.
+ *
+ * @param contact The contact to resolve.
+ */
+void Simulation::bounceBall(const BallContact& contact)
+{
+    const float skin = 0.01f; // Gap left between the ball and the surface
+
+    if (contact.normal_x != 0.0f)
+    {
+        m_ball.x = contact.box.m_pos_x + contact.normal_x * ((contact.box.m_width + m_ball.width) / 2.0f + skin);
+        m_ball.speed_x = contact.normal_x * fabs(m_ball.speed_x);
+    }
+    if (contact.normal_y != 0.0f)
+    {
+        m_ball.y = contact.box.m_pos_y + contact.normal_y * ((contact.box.m_height + m_ball.height) / 2.0f + skin);
+        m_ball.speed_y = contact.normal_y * fabs(m_ball.speed_y);
+    }
+}
+
+/**
+ * @brief Applies a ball hit to an obstacle, after the ball bounced off it.
+ *
+ * On side hits the obstacle's vertical movement is transferred to the ball. Hits on the top or
+ * bottom end only reflect the ball, as transferring the movement there would steer the ball
+ * towards a vertical path. Breaking an obstacle awards a point to the last player who hit the ball.
+ *
+ * @param index Index of the obstacle hit.
+ * @param side_hit True if the ball hit the left or right side of the obstacle.
+ */
+void Simulation::hitObstacle(int index, bool side_hit)
+{
+    // Adjust the ball's vertical speed based on the obstacle's movement
+    if (side_hit)
+    {
+        m_ball.speed_y += m_obstacles.speed[index] * m_obstacles.direction[index];
+    }
+    normalizeBallSpeed();
+
+    raise(SimEventType::OBSTACLE_HIT, m_last_player_to_hit, m_obstacles.slots.handle[index]);
+
+    if (m_obstacles.type[index] == Obstacle::Type::Breakable)
+    {
+        int& hit_points = m_obstacles.hit_points[index];
+        hit_points--;
+        if (hit_points <= 0)
+        {
+            m_obstacles.remove(index);
+            m_obstacle_grid.remove(static_cast<uint32_t>(index));
+        }
+
+        // Breaking an obstacle scores for the last player to hit the ball
+        if (hit_points == 0)
+        {
+            if (m_last_player_to_hit == 1)
+                m_player1_score++;
+            else if (m_last_player_to_hit == 2)
+                m_player2_score++;
+            raise(SimEventType::OBSTACLE_BROKEN, m_last_player_to_hit, m_obstacles.slots.handle[index]);
+        }
+    }
+}
+
+/**
+ * @brief Applies a powerup the ball touched and removes it from the field.
+ *
+ * @param index Index of the powerup collected.
+ */
+void Simulation::collectPowerup(int index)
+{
+    Powerup::Type type = m_powerups.type[index];
+    applyPowerup(type);
+
+    // Adjust the speed multiplier used to renormalize the ball after bounces
+    if (type == Powerup::Type::SPEED_UP)
+    {
+        m_speed_multiplier *= m_config.speed_up_factor;
+    }
+    else if (type == Powerup::Type::SLOW_DOWN)
+    {
+        m_speed_multiplier *= m_config.slow_down_factor;
+    }
+
+    m_powerups.remove(index);
+    m_powerup_grid.remove(static_cast<uint32_t>(index));
+    raise(SimEventType::POWERUP_COLLECTED, m_last_player_to_hit, m_powerups.slots.handle[index]);
+}
+
+/**
+ * @brief Declares the winner once a player reaches the win score of the level.
+ */
+void Simulation::checkWinScore()
+{
+    if (m_level->win_score == 0 || m_winner != 0)
+        return;
+
+    if (m_player1_score >= m_level->win_score)
+    {
+        m_winner = 1;
+    }
+    else if (m_player2_score >= m_level->win_score)
+    {
+        m_winner = 2;
+    }
+}
+
+/**
+ * @brief Removes the obstacles broken and the powerups collected during the tick, so the stores
+ * hold only active objects between ticks, however long the level runs.
+ */
+void Simulation::compactObjects()
+{
+    PROFILE_ZONE("Simulation::compactObjects");
+
+    compactStore(m_obstacles, m_obstacle_grid);
+    compactStore(m_powerups, m_powerup_grid);
+}
+
+/**
+ * @brief Adds an obstacle with the default obstacle dimensions.
+ */
+void Simulation::addObstacle(Obstacle::Type type, float x, float y, int hit_points, float speed)
+{
+    EntityHandle handle = m_obstacles.add(type, x, y, OBSTACLE_WIDTH, OBSTACLE_HEIGHT, hit_points, speed);
+    m_obstacle_grid.insert(static_cast<uint32_t>(m_obstacles.size() - 1), Box(x, y, OBSTACLE_WIDTH, OBSTACLE_HEIGHT));
+    raise(SimEventType::OBSTACLE_SPAWNED, 0, handle);
+}
+
+/**
+ * @brief Adds a powerup with the default powerup dimensions.
+ */
+void Simulation::addPowerup(Powerup::Type type, float x, float y)
+{
+    EntityHandle handle = m_powerups.add(type, x, y, POWERUP_SIZE, POWERUP_SIZE);
+    m_powerup_grid.insert(static_cast<uint32_t>(m_powerups.size() - 1), Box(x, y, POWERUP_SIZE, POWERUP_SIZE));
+    raise(SimEventType::POWERUP_SPAWNED, 0, handle);
+}
+
+/**
+ * @brief Serves the ball from the center of the canvas in a random direction.
+ *
+ * The angle is drawn from 30-60 or 120-150 degrees, towards either side. The ball clears its
+ * powerup, returns to its base size and ramps up to full speed over RAMP_UP_MS.
+ */
+void Simulation::resetBall()
+{
+    m_ball.x = CANVAS_WIDTH / 2.0f;
+    m_ball.y = CANVAS_HEIGHT / 2.0f;
+    m_ball.width = m_ball.base_width;
+    m_ball.height = m_ball.base_height;
+    m_ball.powerup_active = false;
+    m_ball.powerup_elapsed = 0.0f;
+    m_ball.speed_x = 0.0f;
+    m_ball.speed_y = 0.0f;
+
+    std::uniform_real_distribution<float> dist1(30.0f, 60.0f);
+    std::uniform_real_distribution<float> dist2(120.0f, 150.0f);
+
+    float angle = (m_rng() % 2 == 0) ? dist1(m_rng) : dist2(m_rng);
+    float radians = angle * 3.14159265f / 180.0f;
+
+    // Randomly decide to shoot up or down
+    if ((m_rng() % 2) == 0)
+    {
+        radians = -radians;
+    }
+
+    m_ball.target_speed_x = m_ball.speed * std::cos(radians);
+    m_ball.target_speed_y = m_ball.speed * std::sin(radians);
+
+    m_ball.ramp_elapsed = 0.0f;
+    m_ball.ramping_up = true;
+}
+
+/**
+ * @brief Applies a powerup effect to the ball.
+ *
+ * Ignored while ramping up, while another powerup is active, and for SPEED_UP in Sudden Death
+ * levels.
+ *
+ * @param type The type of powerup to apply.
+ */
+void Simulation::applyPowerup(Powerup::Type type)
+{
+    if (m_level->sudden_death && type == Powerup::Type::SPEED_UP)
+        return;
+    if (m_ball.ramping_up || m_ball.powerup_active)
+        return;
+
+    m_ball.powerup_active = true;
+    m_ball.powerup_type = type;
+    m_ball.powerup_elapsed = 0.0f;
+
+    switch (type)
+    {
+    case Powerup::Type::SPEED_UP:
+        m_ball.speed_x *= m_config.speed_up_factor;
+        m_ball.speed_y *= m_config.speed_up_factor;
+        break;
+    case Powerup::Type::SLOW_DOWN:
+        m_ball.speed_x *= m_config.slow_down_factor;
+        m_ball.speed_y *= m_config.slow_down_factor;
+        break;
+    case Powerup::Type::INCREASE_SIZE:
+        m_ball.width = m_ball.base_width * 1.4f;
+        m_ball.height = m_ball.base_height * 1.4f;
+        break;
+    case Powerup::Type::DECREASE_SIZE:
+        m_ball.width = m_ball.base_width * 0.7f;
+        m_ball.height = m_ball.base_height * 0.7f;
+        break;
+    }
+}
+
+/**
+ * @brief Expires the active powerup once POWERUP_DURATION_MS has passed, reversing its effect.
+ *
+ * @param dt Tick duration in ms.
+ */
+void Simulation::updateBallPowerup(float dt)
+{
+    if (!m_ball.powerup_active)
+        return;
+
+    m_ball.powerup_elapsed += dt;
+    if (m_ball.powerup_elapsed < POWERUP_DURATION_MS)
+        return;
+
+    switch (m_ball.powerup_type)
+    {
+    case Powerup::Type::SPEED_UP:
+        m_ball.speed_x /= m_config.speed_up_factor;
+        m_ball.speed_y /= m_config.speed_up_factor;
+        break;
+    case Powerup::Type::SLOW_DOWN:
+        m_ball.speed_x /= m_config.slow_down_factor;
+        m_ball.speed_y /= m_config.slow_down_factor;
+        break;
+    case Powerup::Type::INCREASE_SIZE:
+    case Powerup::Type::DECREASE_SIZE:
+        m_ball.width = m_ball.base_width;
+        m_ball.height = m_ball.base_height;
+        break;
+    }
+
+    m_ball.powerup_active = false;
+    raise(SimEventType::POWERUP_EXPIRED);
+}
+
+/**
+ * @brief Rescales the ball's velocity to its base speed times the current speed multiplier,
+ * keeping its direction.
+ */
+void Simulation::normalizeBallSpeed()
+{
+    float current_speed = std::sqrt(m_ball.speed_x * m_ball.speed_x + m_ball.speed_y * m_ball.speed_y);
+    if (current_speed > 0.0f)
+    {
+        float new_speed = m_ball.speed * m_speed_multiplier;
+        m_ball.speed_x = (m_ball.speed_x / current_speed) * new_speed;
+        m_ball.speed_y = (m_ball.speed_y / current_speed) * new_speed;
+    }
+}
+
+/**
+ * @brief Awards a point and serves a new ball.
+ *
+ * @param player The player who scored (1 or 2).
+ */
+void Simulation::onScore(int player)
+{
+    if (player == 1)
+        m_player1_score++;
+    else
+        m_player2_score++;
+
+    resetBall();
+    m_speed_multiplier = 1.0f;
+    m_last_player_to_hit = 0;
+
+    raise(SimEventType::SCORED, player);
+}
+
+/**
+ * @brief Records a gameplay event for the presentation layer.
+ */
+void Simulation::raise(SimEventType type, int player, EntityHandle handle)
+{
+    SimEvent event;
+    event.type = type;
+    event.player = player;
+    event.handle = handle;
+    m_events.push_back(event);
+}
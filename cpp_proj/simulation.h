@@ -0,0 +1,336 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include "entitystore.h"
+#include "config.h"
+#include "box.h"
+#include "sweepbatch.h"
+#include "spatialgrid.h"
+#include "leveldef.h"
+
+/**
+ * @struct PaddleInput
+ * @brief Plain input state of one paddle, independent of any keyboard or window.
+ */
+struct PaddleInput
+{
+    bool up = false;    ///< Move the paddle up (towards smaller y values).
+    bool down = false;  ///< Move the paddle down (towards larger y values).
+};
+
+/**
+ * @struct SimInput
+ * @brief Input of both paddles, applied to every fixed tick of a frame.
+ */
+struct SimInput
+{
+    PaddleInput player1; ///< Input of the left paddle.
+    PaddleInput player2; ///< Input of the right paddle.
+};
+
+/**
+ * @struct SimConfig
+ * @brief Tunable gameplay constants, so balancing sweeps can vary them without recompiling.
+ */
+struct SimConfig
+{
+    float ball_speed = 0.7f;                 ///< Base ball speed in units per ms.
+    float sudden_death_speed_factor = 1.4f;  ///< Ball speed increase in Sudden Death.
+    float speed_up_factor = 1.5f;            ///< Ball speed factor of the SPEED_UP powerup.
+    float slow_down_factor = 0.6f;           ///< Ball speed factor of the SLOW_DOWN powerup.
+    float tick_rate = SIM_TICK_RATE;         ///< Fixed ticks per second; lower rates trade accuracy for throughput.
+    float grid_cell_size = GRID_CELL_SIZE;   ///< Cell size of the broadphase grids; affects speed only, never results.
+};
+
+/**
+ * @struct SimPaddle
+ * @brief Simulation state of a player paddle.
+ */
+struct SimPaddle
+{
+    float x = 0.0f;         ///< Center x coordinate.
+    float y = 0.0f;         ///< Center y coordinate.
+    float width = 10.0f;    ///< Width of the paddle.
+    float height = 70.0f;   ///< Height of the paddle.
+    float speed = 1.0f;     ///< Vertical speed in units per ms.
+};
+
+/**
+ * @struct SimBall
+ * @brief Simulation state of the ball, including serve ramp-up and the active powerup.
+ */
+struct SimBall
+{
+    float x = 0.0f;                 ///< Center x coordinate.
+    float y = 0.0f;                 ///< Center y coordinate.
+    float width = 15.0f;            ///< Current width (changed by size powerups).
+    float height = 15.0f;           ///< Current height (changed by size powerups).
+    float base_width = 15.0f;       ///< Width without powerups.
+    float base_height = 15.0f;      ///< Height without powerups.
+    float speed = 0.7f;             ///< Base speed in units per ms.
+    float speed_x = 0.0f;           ///< Current speed on the x-axis.
+    float speed_y = 0.0f;           ///< Current speed on the y-axis.
+    float target_speed_x = 0.0f;    ///< Speed on the x-axis once the serve ramp-up completes.
+    float target_speed_y = 0.0f;    ///< Speed on the y-axis once the serve ramp-up completes.
+    float ramp_elapsed = 0.0f;      ///< Time spent ramping up since the last serve, in ms.
+    bool ramping_up = false;        ///< True while the ball accelerates after a serve.
+    bool powerup_active = false;    ///< True while a powerup effect is applied.
+    Powerup::Type powerup_type = Powerup::Type::SPEED_UP; ///< Type of the active powerup.
+    float powerup_elapsed = 0.0f;   ///< Time the active powerup has been applied, in ms.
+};
+
+/**
+ * @enum SimEventType
+ * @brief Gameplay events reported by the simulation so the presentation layer can react (sounds, logs).
+ */
+enum class SimEventType
+{
+    PADDLE_HIT,         ///< The ball bounced off a paddle (player = paddle owner).
+    OBSTACLE_HIT,       ///< The ball bounced off an obstacle (handle = obstacle handle).
+    OBSTACLE_BROKEN,    ///< A breakable obstacle was destroyed (player = scorer or 0).
+    POWERUP_SPAWNED,    ///< A powerup was spawned (handle = powerup handle).
+    OBSTACLE_SPAWNED,   ///< An obstacle was spawned (handle = obstacle handle).
+    POWERUP_COLLECTED,  ///< The ball collected a powerup (handle = powerup handle).
+    POWERUP_EXPIRED,    ///< The active powerup effect on the ball ran out.
+    SCORED,             ///< A player scored by getting the ball past the opposite paddle.
+    WALL_BOUNCE         ///< The ball bounced off the top or bottom wall.
+};
+
+/**
+ * @struct SimEvent
+ * @brief A single gameplay event raised during a simulation tick.
+ */
+struct SimEvent
+{
+    SimEventType type;
+    int player = 0; ///< Player involved (1 or 2), or 0 if none.
+    EntityHandle handle = NO_ENTITY; ///< Obstacle or powerup involved, or NO_ENTITY; stale once it is removed.
+};
+
+/**
+ * @class Simulation
+ * @brief Headless gameplay engine: owns paddles, ball, obstacles, powerups, spawning and scoring,
+ * and advances them at a fixed tick rate. Has no dependency on the graphics library.
+ */
+class Simulation
+{
+    const LevelSet* m_levels;           // Definitions of the levels
+    const LevelDef* m_level;            // Definition of the current level
+    int m_level_number = 1;             // Current level number
+    float m_level_timer = 300.0f;       // Level countdown, in tenths of a second
+    float m_elapsed_time = 0.0f;        // Seconds of gameplay since the level started
+    float m_accumulator = 0.0f;         // Frame time not yet consumed by fixed ticks, in ms
+    uint64_t m_tick = 0;                // Number of ticks simulated since the level started
+
+    std::mt19937 m_rng;                 // Single source of randomness for serves and spawns
+    SimConfig m_config;                 // Tunable gameplay constants
+    float m_tick_ms;                    // Duration of one fixed tick in ms (speeds are in units per ms)
+    int m_max_advance_ticks = 0;        // Ticks a single advance() runs at most
+    bool m_frame_events = false;        // Event list sized for advance(), not a single tick
+
+    SimPaddle m_paddles[2];
+    SimBall m_ball;
+    ObstacleStore m_obstacles;
+    PowerupStore m_powerups;
+    std::vector<SimEvent> m_events;
+
+    // Broadphase grids of the active obstacles and powerups, keyed by store index
+    SpatialGrid m_obstacle_grid;
+    SpatialGrid m_powerup_grid;
+
+    /**
+     * @struct SweepScratch
+     * @brief Candidates of a batched ball sweep, gathered from a grid query. Kept between ticks
+     * to avoid reallocating.
+     */
+    struct SweepScratch
+    {
+        std::vector<uint32_t> indices;
+        std::vector<float> x, y, width, height;
+        std::vector<uint8_t> active;
+        std::vector<float> times;
+        std::vector<SweepHit> hits;
+    };
+    mutable SweepScratch m_sweep;
+
+    // Spawning state of the current level
+    float m_next_powerup_spawn_time = 0.0f; // Time of the next powerup at a fixed position, in seconds
+    int m_powerups_spawned = 0;             // Powerups spawned at fixed positions
+
+    /**
+     * @struct SpawnerState
+     * @brief Progress of one random spawner of the level.
+     */
+    struct SpawnerState
+    {
+        int spawned = 0;
+        float next_time = 0.0f;             // Time of the next spawn, in seconds
+    };
+    std::vector<SpawnerState> m_spawners;   // One per spawner of the level
+    int m_spawned_by_kind[2] = { 0, 0 };    // Objects spawned by all spawners, by LevelSpawner::Kind
+
+    // Speed multiplier to track active powerups affecting the ball's speed
+    float m_speed_multiplier = 1.0f;
+
+    int m_player1_score = 0;
+    int m_player2_score = 0;
+    int m_last_player_to_hit = 0;   // 0: none, 1: Player1, 2: Player2
+    int m_winner = 0;               // 0: no winner yet, 1: Player1, 2: Player2
+
+    void spawnObjects();
+    bool isSpawnClear(float x, float y, float distance) const;
+    /**
+     * @struct BallContact
+     * @brief A contact found by sweeping the ball along its movement.
+     */
+    struct BallContact
+    {
+        enum class Type { NONE, GOAL, WALL, PADDLE, OBSTACLE, POWERUP };
+
+        Type type = Type::NONE;
+        int index = 0;              // Scoring player, paddle owner, or obstacle/powerup index
+        float time = 1.0f;          // Fraction of the movement at which the contact happens
+        float normal_x = 0.0f;      // Contact normal, pointing towards the ball
+        float normal_y = 0.0f;
+        Box box;                    // Box the ball touched
+    };
+
+    // Contacts resolved per tick before the rest of the ball's movement is dropped
+    static const int MAX_BALL_CONTACTS = 8;
+
+    void reserveEvents();
+    void moveObjects(const SimInput& input, float dt);
+    void moveBall(float dt);
+    BallContact findBallContact(float dx, float dy) const;
+    BoxBatch gatherCandidates(const SpatialGrid& grid, const Box& region, const float* x, const float* y,
+        const float* width, const float* height) const;
+    void bounceBall(const BallContact& contact);
+    void hitObstacle(int index, bool side_hit);
+    void collectPowerup(int index);
+    void checkWinScore();
+    void compactObjects();
+
+    void reserveObjects(size_t obstacles, size_t powerups);
+    void addObstacle(Obstacle::Type type, float x, float y, int hit_points, float speed);
+    void addPowerup(Powerup::Type type, float x, float y);
+
+    void resetBall();
+    void applyPowerup(Powerup::Type type);
+    void updateBallPowerup(float dt);
+    void normalizeBallSpeed();
+    void onScore(int player);
+
+    void raise(SimEventType type, int player = 0, EntityHandle handle = NO_ENTITY);
+
+public:
+    /**
+     * @brief Creates a simulation with a fixed random seed.
+     * @param seed Seed of the random engine driving serves and spawns.
+     * @param config Gameplay constants to use.
+     */
+    explicit Simulation(uint32_t seed = 0, const SimConfig& config = SimConfig());
+
+    /**
+     * @brief Reseeds the random engine.
+     */
+    void seed(uint32_t seed) { m_rng.seed(seed); }
+
+    /**
+     * @brief Replaces the level definitions, LevelSet::getDefault() until then. Takes effect at the
+     * next loadLevel(); the set must outlive the simulation.
+     */
+    void setLevels(const LevelSet& levels) { m_levels = &levels; }
+
+    /**
+     * @brief Retrieves the level definitions set by setLevels().
+     */
+    const LevelSet& getLevels() const { return *m_levels; }
+
+    /**
+     * @brief Resets paddles, ball, obstacles and powerups for the given level, as its definition
+     * describes. An unknown number loads the first level of the set.
+     * @param level_number The level number to load.
+     */
+    void loadLevel(int level_number);
+
+    /**
+     * @brief Resets both scores and the winner.
+     */
+    void resetScores();
+
+    /**
+     * @brief Sizes the event list for the longest advance(), now and at every level load. Callers
+     * that advance() in frames call it once; those that only tick() keep room for one tick.
+     */
+    void reserveFrameEvents();
+
+    /**
+     * @brief Consumes frame time in fixed ticks. Leftover time is kept for the next call; frame
+     * time beyond 250 ms is dropped.
+     * @param dt Frame time in ms.
+     * @param input Paddle input applied to every tick of this frame.
+     * @return The number of ticks simulated.
+     */
+    int advance(float dt, const SimInput& input);
+
+    /**
+     * @brief Simulates exactly one fixed tick.
+     * @param input Paddle input for this tick.
+     */
+    void tick(const SimInput& input);
+
+    /**
+     * @brief Checks if the current level is over (timer ran out or the win score was reached).
+     */
+    bool isLevelOver() const;
+
+    /**
+     * @brief Applies the progression rules once a level is over.
+     * A level without a next level is decided by the higher score, and a tie leads to its tie level.
+     * @return The next level number to load, or 0 if the match is over.
+     */
+    int resolveLevelEnd();
+
+    /**
+     * @brief Computes a hash of the complete gameplay state, for bit-for-bit replay verification.
+     */
+    uint64_t getStateHash() const;
+
+    /**
+     * @brief Events raised during the last call to advance(), or since the last call to
+     * clearEvents() when stepping with tick() directly.
+     */
+    const std::vector<SimEvent>& getEvents() const { return m_events; }
+
+    /**
+     * @brief Discards all pending events.
+     */
+    void clearEvents() { m_events.clear(); }
+
+    int getLevelNumber() const { return m_level_number; }
+    const LevelDef& getLevelDef() const { return *m_level; }
+    float getLevelTimer() const { return m_level_timer; }
+    float getElapsedTime() const { return m_elapsed_time; }
+    uint64_t getTick() const { return m_tick; }
+    int getScore(int player) const { return player == 1 ? m_player1_score : m_player2_score; }
+    int getWinner() const { return m_winner; }
+    float getSpeedMultiplier() const { return m_speed_multiplier; }
+    const SimConfig& getConfig() const { return m_config; }
+    float getTickMs() const { return m_tick_ms; }
+
+    const SimPaddle& getPaddle(int player) const { return m_paddles[player == 1 ? 0 : 1]; }
+    const SimBall& getBall() const { return m_ball; }
+    const ObstacleStore& getObstacles() const { return m_obstacles; }
+    const PowerupStore& getPowerups() const { return m_powerups; }
+
+    /**
+     * @brief Generates a random float between min and max from the simulation's engine.
+     */
+    float getRandomFloat(float min, float max)
+    {
+        std::uniform_real_distribution<float> dist(min, max);
+        return dist(m_rng);
+    }
+};
@@ -0,0 +1,211 @@
+#include "spatialgrid.h"
+#include <algorithm>
+#include <cmath>
+
+// Objects each cell has room for after reserve()
+static const size_t RESERVED_PER_CELL = 8;
+
+/**
+ * @brief Constructs an empty grid covering [0, width] x [0, height].
+ *
+ * @param width Width of the covered area, starting at x = 0.
+ * @param height Height of the covered area, starting at y = 0.
+ * @param cell_size Width and height of a cell.
+ */
+SpatialGrid::SpatialGrid(float width, float height, float cell_size)
+    : m_cell_size(cell_size),
+    m_inv_cell_size(1.0f / cell_size),
+    m_columns(std::max(1, static_cast<int>(std::ceil(width / cell_size)))),
+    m_rows(std::max(1, static_cast<int>(std::ceil(height / cell_size)))),
+    m_cells(static_cast<size_t>(m_columns) * m_rows)
+{
+}
+
+/**
+ * @brief Removes all objects. The cells keep their capacity for the next level.
+ */
+void SpatialGrid::clear()
+{
+    for (std::vector<uint32_t>& cell : m_cells)
+    {
+        cell.clear();
+    }
+    m_ranges.clear();
+}
+
+/**
+ * @brief Makes room for a number of objects. Every cell gets room for a few of them, as objects
+ * spread over the grid.
+ *
+ * @param objects Number of objects, with IDs below this number.
+ */
+void SpatialGrid::reserve(size_t objects)
+{
+    m_ranges.reserve(objects);
+    m_stamps.reserve(objects);
+
+    size_t per_cell = std::min(objects, RESERVED_PER_CELL);
+    for (std::vector<uint32_t>& cell : m_cells)
+    {
+        cell.reserve(per_cell);
+    }
+}
+
+/**
+ * @brief Computes the cells covered by a box, clamped to the grid.
+ */
+SpatialGrid::CellRange SpatialGrid::getRange(const Box& box) const
+{
+    // Truncation equals floor for the non-negative coordinates that are not clamped to cell 0
+    auto cell = [this](float coordinate, int count)
+    {
+        float index = coordinate * m_inv_cell_size;
+        if (!(index > 0.0f))
+            return 0;
+        if (index >= static_cast<float>(count))
+            return count - 1;
+        return static_cast<int>(index);
+    };
+
+    CellRange range;
+    range.min_x = cell(box.m_pos_x - box.m_width / 2.0f, m_columns);
+    range.max_x = cell(box.m_pos_x + box.m_width / 2.0f, m_columns);
+    range.min_y = cell(box.m_pos_y - box.m_height / 2.0f, m_rows);
+    range.max_y = cell(box.m_pos_y + box.m_height / 2.0f, m_rows);
+    range.present = true;
+    return range;
+}
+
+void SpatialGrid::addToCells(uint32_t id, const CellRange& range)
+{
+    for (int y = range.min_y; y <= range.max_y; y++)
+    {
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            m_cells[static_cast<size_t>(y) * m_columns + x].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::removeFromCells(uint32_t id, const CellRange& range)
+{
+    for (int y = range.min_y; y <= range.max_y; y++)
+    {
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            // Cells hold few objects and their order does not matter: swap with the last and pop
+            std::vector<uint32_t>& cell = m_cells[static_cast<size_t>(y) * m_columns + x];
+            std::vector<uint32_t>::iterator it = std::find(cell.begin(), cell.end(), id);
+            if (it != cell.end())
+            {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Registers an object in every cell its box overlaps. If the ID is already present it is
+ * moved instead.
+ *
+ * @param id Dense ID of the object, e.g. its EntityHandle.
+ * @param box Bounds of the object.
+ */
+void SpatialGrid::insert(uint32_t id, const Box& box)
+{
+    if (contains(id))
+    {
+        move(id, box);
+        return;
+    }
+
+    if (id >= m_ranges.size())
+    {
+        m_ranges.resize(id + 1);
+    }
+    m_ranges[id] = getRange(box);
+    addToCells(id, m_ranges[id]);
+}
+
+/**
+ * @brief Updates the box of a registered object. The cells are only touched if the object
+ * crossed a cell border.
+ *
+ * @param id ID of the object.
+ * @param box New bounds of the object.
+ */
+void SpatialGrid::move(uint32_t id, const Box& box)
+{
+    if (!contains(id))
+    {
+        insert(id, box);
+        return;
+    }
+
+    CellRange range = getRange(box);
+    CellRange& old_range = m_ranges[id];
+    if (range.min_x == old_range.min_x && range.max_x == old_range.max_x &&
+        range.min_y == old_range.min_y && range.max_y == old_range.max_y)
+        return;
+
+    removeFromCells(id, old_range);
+    addToCells(id, range);
+    old_range = range;
+}
+
+/**
+ * @brief Unregisters an object. Does nothing if the ID is not present.
+ *
+ * @param id ID of the object.
+ */
+void SpatialGrid::remove(uint32_t id)
+{
+    if (!contains(id))
+        return;
+
+    removeFromCells(id, m_ranges[id]);
+    m_ranges[id] = CellRange();
+}
+
+/**
+ * @brief Finds the objects whose cells overlap a region.
+ *
+ * @param region The region to search.
+ * @param ids Receives the IDs found, each once, in ascending order so callers iterate
+ * deterministically whatever the order of insertion.
+ */
+void SpatialGrid::query(const Box& region, std::vector<uint32_t>& ids) const
+{
+    ids.clear();
+    if (m_ranges.empty())
+        return;
+
+    if (m_stamps.size() < m_ranges.size())
+    {
+        m_stamps.resize(m_ranges.size(), 0);
+    }
+    if (++m_query_stamp == 0)
+    {
+        // The stamp wrapped around: old stamps could collide with new ones
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_query_stamp = 1;
+    }
+
+    CellRange range = getRange(region);
+    for (int y = range.min_y; y <= range.max_y; y++)
+    {
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            for (uint32_t id : m_cells[static_cast<size_t>(y) * m_columns + x])
+            {
+                if (m_stamps[id] != m_query_stamp)
+                {
+                    m_stamps[id] = m_query_stamp;
+                    ids.push_back(id);
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+}
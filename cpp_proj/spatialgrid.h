@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "config.h"
+#include "box.h"
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform grid broadphase over the canvas.
+ *
+ * Every object is registered under a caller-chosen dense ID (e.g. its index in an ObstacleStore) in
+ * all cells its box overlaps. Region queries then only look at the cells the region covers instead of every
+ * object. Objects outside the canvas are clamped into the border cells, so queries stay correct
+ * anywhere.
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * @brief Constructs an empty grid.
+     *
+     * @param width Width of the covered area, starting at x = 0.
+     * @param height Height of the covered area, starting at y = 0.
+     * @param cell_size Width and height of a cell.
+     */
+    SpatialGrid(float width = CANVAS_WIDTH, float height = CANVAS_HEIGHT, float cell_size = GRID_CELL_SIZE);
+
+    /**
+     * @brief Removes all objects. The cells keep their capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Makes room for a number of objects, so registering them does not allocate unless
+     * they crowd into the same cells.
+     */
+    void reserve(size_t objects);
+
+    /**
+     * @brief Registers an object. If the ID is already present it is moved instead.
+     */
+    void insert(uint32_t id, const Box& box);
+
+    /**
+     * @brief Updates the box of a registered object.
+     */
+    void move(uint32_t id, const Box& box);
+
+    /**
+     * @brief Unregisters an object. Does nothing if the ID is not present.
+     */
+    void remove(uint32_t id);
+
+    /**
+     * @brief Checks if an object is registered.
+     */
+    bool contains(uint32_t id) const { return id < m_ranges.size() && m_ranges[id].present; }
+
+    /**
+     * @brief Finds the objects whose cells overlap a region.
+     *
+     * This is a conservative test: the result contains every object whose box overlaps the region
+     * (including touching boxes), plus possibly some that do not.
+     *
+     * @param region The region to search.
+     * @param ids Receives the IDs found, each once, in ascending order.
+     */
+    void query(const Box& region, std::vector<uint32_t>& ids) const;
+
+    float getCellSize() const { return m_cell_size; }
+
+private:
+    /**
+     * @struct CellRange
+     * @brief Inclusive range of cells covered by an object.
+     */
+    struct CellRange
+    {
+        int min_x = 0;
+        int min_y = 0;
+        int max_x = -1;
+        int max_y = -1;
+        bool present = false;
+    };
+
+    float m_cell_size;
+    float m_inv_cell_size;
+    int m_columns;
+    int m_rows;
+    std::vector<std::vector<uint32_t>> m_cells;     // Object IDs per cell, row by row
+    std::vector<CellRange> m_ranges;                // Cells covered by each object, indexed by ID
+
+    // Query deduplication: an ID is reported once per query by stamping it with the query number
+    mutable std::vector<uint32_t> m_stamps;
+    mutable uint32_t m_query_stamp = 0;
+
+    CellRange getRange(const Box& box) const;
+    void addToCells(uint32_t id, const CellRange& range);
+    void removeFromCells(uint32_t id, const CellRange& range);
+};
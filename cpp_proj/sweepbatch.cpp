@@ -0,0 +1,316 @@
+#include "sweepbatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PONG_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PONG_TARGET_AVX2
+#else
+#define PONG_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// Time reported for boxes that are not touched (any value greater than 1)
+static const float NO_HIT = 2.0f;
+
+/**
+ * @brief Detects AVX2 support of the CPU and the OS (which must save the YMM registers).
+ */
+static SimdLevel detectSimdLevel()
+{
+#if defined(PONG_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7)
+    {
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+        {
+            __cpuidex(info, 7, 0);
+            if (info[1] & (1 << 5))
+                return SimdLevel::AVX2;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+#endif
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+/**
+ * @brief Detects the best instruction set supported by this CPU and OS. Detection runs once.
+ *
+ * @return The fastest supported level.
+ */
+SimdLevel getSimdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+/**
+ * @brief Retrieves a printable name of an instruction set.
+ *
+ * @param level The instruction set.
+ * @return Its name.
+ */
+const char* getSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::AVX2: return "AVX2";
+    case SimdLevel::SSE2: return "SSE2";
+    default: return "scalar";
+    }
+}
+
+/**
+ * @brief Scalar kernel for the boxes [begin, end): Box::sweep() on every active box.
+ */
+static void sweepScalar(const Box& box, float dx, float dy, const BoxBatch& batch, float* times,
+    size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        float normal_x, normal_y;
+        times[i] = batch.active[i]
+            ? box.sweep(Box(batch.x[i], batch.y[i], batch.width[i], batch.height[i]), dx, dy, normal_x, normal_y)
+            : NO_HIT;
+    }
+}
+
+#if defined(PONG_X86)
+/**
+ * @brief SSE2 kernel: 4 boxes per iteration, the remainder is handled by the scalar kernel.
+ *
+ * Mirrors Box::sweep() operation by operation so the results are bit-for-bit identical.
+ */
+static size_t sweepSse2(const Box& box, float dx, float dy, const BoxBatch& batch, float* times)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 no_hit = _mm_set1_ps(NO_HIT);
+    const __m128 neg_inf = _mm_set1_ps(-INFINITY);
+    const __m128 pos_inf = _mm_set1_ps(INFINITY);
+    const __m128i zero_i = _mm_setzero_si128();
+
+    const __m128 bx = _mm_set1_ps(box.m_pos_x);
+    const __m128 by = _mm_set1_ps(box.m_pos_y);
+    const __m128 bw = _mm_set1_ps(box.m_width);
+    const __m128 bh = _mm_set1_ps(box.m_height);
+    const __m128 vdx = _mm_set1_ps(dx);
+    const __m128 vdy = _mm_set1_ps(dy);
+
+    size_t i = 0;
+    for (; i + 4 <= batch.count; i += 4)
+    {
+        __m128 rel_x = _mm_sub_ps(bx, _mm_loadu_ps(batch.x + i));
+        __m128 rel_y = _mm_sub_ps(by, _mm_loadu_ps(batch.y + i));
+        __m128 half_w = _mm_mul_ps(_mm_add_ps(bw, _mm_loadu_ps(batch.width + i)), half);
+        __m128 half_h = _mm_mul_ps(_mm_add_ps(bh, _mm_loadu_ps(batch.height + i)), half);
+        __m128 pen_x = _mm_sub_ps(half_w, _mm_andnot_ps(sign, rel_x));
+        __m128 pen_y = _mm_sub_ps(half_h, _mm_andnot_ps(sign, rel_y));
+        __m128 in_x = _mm_cmpgt_ps(pen_x, zero);
+        __m128 in_y = _mm_cmpgt_ps(pen_y, zero);
+        __m128 overlap = _mm_and_ps(in_x, in_y);
+
+        __m128 enter_x = neg_inf, exit_x = pos_inf, valid = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        if (dx != 0.0f)
+        {
+            __m128 t1 = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(half_w, sign), rel_x), vdx);
+            __m128 t2 = _mm_div_ps(_mm_sub_ps(half_w, rel_x), vdx);
+            enter_x = _mm_min_ps(t1, t2);
+            exit_x = _mm_max_ps(t1, t2);
+        }
+        else
+        {
+            valid = in_x;
+        }
+
+        __m128 enter_y = neg_inf, exit_y = pos_inf;
+        if (dy != 0.0f)
+        {
+            __m128 t1 = _mm_div_ps(_mm_sub_ps(_mm_xor_ps(half_h, sign), rel_y), vdy);
+            __m128 t2 = _mm_div_ps(_mm_sub_ps(half_h, rel_y), vdy);
+            enter_y = _mm_min_ps(t1, t2);
+            exit_y = _mm_max_ps(t1, t2);
+        }
+        else
+        {
+            valid = _mm_and_ps(valid, in_y);
+        }
+
+        __m128 enter = _mm_max_ps(enter_x, enter_y);
+        __m128 exit = _mm_min_ps(exit_x, exit_y);
+        __m128 hit = _mm_and_ps(valid, _mm_cmplt_ps(enter, exit));
+        hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(enter, zero), _mm_cmple_ps(enter, one)));
+
+        // Expand 4 active bytes to 4 lane masks
+        int active_bytes;
+        std::memcpy(&active_bytes, batch.active + i, sizeof(active_bytes));
+        __m128i active_i = _mm_cvtsi32_si128(active_bytes);
+        active_i = _mm_unpacklo_epi16(_mm_unpacklo_epi8(active_i, zero_i), zero_i);
+        __m128 active = _mm_castsi128_ps(_mm_cmpgt_epi32(active_i, zero_i));
+
+        __m128 time = _mm_or_ps(_mm_and_ps(hit, enter), _mm_andnot_ps(hit, no_hit));
+        time = _mm_andnot_ps(overlap, time); // Overlapping boxes are hit at time 0
+        time = _mm_or_ps(_mm_and_ps(active, time), _mm_andnot_ps(active, no_hit));
+        _mm_storeu_ps(times + i, time);
+    }
+    return i;
+}
+
+/**
+ * @brief AVX2 kernel: 8 boxes per iteration, the remainder is handled by the scalar kernel.
+ *
+ * Same operations as the SSE2 kernel on 256-bit registers.
+ */
+PONG_TARGET_AVX2
+static size_t sweepAvx2(const Box& box, float dx, float dy, const BoxBatch& batch, float* times)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 no_hit = _mm256_set1_ps(NO_HIT);
+    const __m256 neg_inf = _mm256_set1_ps(-INFINITY);
+    const __m256 pos_inf = _mm256_set1_ps(INFINITY);
+
+    const __m256 bx = _mm256_set1_ps(box.m_pos_x);
+    const __m256 by = _mm256_set1_ps(box.m_pos_y);
+    const __m256 bw = _mm256_set1_ps(box.m_width);
+    const __m256 bh = _mm256_set1_ps(box.m_height);
+    const __m256 vdx = _mm256_set1_ps(dx);
+    const __m256 vdy = _mm256_set1_ps(dy);
+
+    size_t i = 0;
+    for (; i + 8 <= batch.count; i += 8)
+    {
+        __m256 rel_x = _mm256_sub_ps(bx, _mm256_loadu_ps(batch.x + i));
+        __m256 rel_y = _mm256_sub_ps(by, _mm256_loadu_ps(batch.y + i));
+        __m256 half_w = _mm256_mul_ps(_mm256_add_ps(bw, _mm256_loadu_ps(batch.width + i)), half);
+        __m256 half_h = _mm256_mul_ps(_mm256_add_ps(bh, _mm256_loadu_ps(batch.height + i)), half);
+        __m256 pen_x = _mm256_sub_ps(half_w, _mm256_andnot_ps(sign, rel_x));
+        __m256 pen_y = _mm256_sub_ps(half_h, _mm256_andnot_ps(sign, rel_y));
+        __m256 in_x = _mm256_cmp_ps(pen_x, zero, _CMP_GT_OQ);
+        __m256 in_y = _mm256_cmp_ps(pen_y, zero, _CMP_GT_OQ);
+        __m256 overlap = _mm256_and_ps(in_x, in_y);
+
+        __m256 enter_x = neg_inf, exit_x = pos_inf, valid = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        if (dx != 0.0f)
+        {
+            __m256 t1 = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(half_w, sign), rel_x), vdx);
+            __m256 t2 = _mm256_div_ps(_mm256_sub_ps(half_w, rel_x), vdx);
+            enter_x = _mm256_min_ps(t1, t2);
+            exit_x = _mm256_max_ps(t1, t2);
+        }
+        else
+        {
+            valid = in_x;
+        }
+
+        __m256 enter_y = neg_inf, exit_y = pos_inf;
+        if (dy != 0.0f)
+        {
+            __m256 t1 = _mm256_div_ps(_mm256_sub_ps(_mm256_xor_ps(half_h, sign), rel_y), vdy);
+            __m256 t2 = _mm256_div_ps(_mm256_sub_ps(half_h, rel_y), vdy);
+            enter_y = _mm256_min_ps(t1, t2);
+            exit_y = _mm256_max_ps(t1, t2);
+        }
+        else
+        {
+            valid = _mm256_and_ps(valid, in_y);
+        }
+
+        __m256 enter = _mm256_max_ps(enter_x, enter_y);
+        __m256 exit = _mm256_min_ps(exit_x, exit_y);
+        __m256 hit = _mm256_and_ps(valid, _mm256_cmp_ps(enter, exit, _CMP_LT_OQ));
+        hit = _mm256_and_ps(hit, _mm256_and_ps(_mm256_cmp_ps(enter, zero, _CMP_GE_OQ), _mm256_cmp_ps(enter, one, _CMP_LE_OQ)));
+
+        // Expand 8 active bytes to 8 lane masks
+        __m256i active_i = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(batch.active + i)));
+        __m256 active = _mm256_castsi256_ps(_mm256_cmpgt_epi32(active_i, _mm256_setzero_si256()));
+
+        __m256 time = _mm256_blendv_ps(no_hit, enter, hit);
+        time = _mm256_blendv_ps(time, zero, overlap); // Overlapping boxes are hit at time 0
+        time = _mm256_blendv_ps(no_hit, time, active);
+        _mm256_storeu_ps(times + i, time);
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Computes the time of impact of a box moving by (dx, dy) against every box of a batch.
+ *
+ * @param box The moving box.
+ * @param dx Movement on the x-axis.
+ * @param dy Movement on the y-axis.
+ * @param batch The static boxes.
+ * @param times Receives one time per box: in [0, 1] if it is touched, greater than 1 otherwise.
+ * @param level Instruction set to use; must be supported by the CPU.
+ */
+void sweepBatchTimes(const Box& box, float dx, float dy, const BoxBatch& batch, float* times, SimdLevel level)
+{
+    size_t done = 0;
+#if defined(PONG_X86)
+    if (level == SimdLevel::AVX2)
+        done = sweepAvx2(box, dx, dy, batch, times);
+    else if (level == SimdLevel::SSE2)
+        done = sweepSse2(box, dx, dy, batch, times);
+#else
+    (void)level;
+#endif
+    sweepScalar(box, dx, dy, batch, times, done, batch.count);
+}
+
+/**
+ * @brief Finds every box of a batch touched by a box moving by (dx, dy), ordered by time of impact.
+ *
+ * Uses the fastest instruction set of the CPU.
+ *
+ * @param box The moving box.
+ * @param dx Movement on the x-axis.
+ * @param dy Movement on the y-axis.
+ * @param batch The static boxes.
+ * @param times Scratch buffer for the per-box times, resized as needed.
+ * @param hits Receives the boxes touched, earliest first (ties ordered by index).
+ */
+void sweepBatch(const Box& box, float dx, float dy, const BoxBatch& batch,
+    std::vector<float>& times, std::vector<SweepHit>& hits)
+{
+    hits.clear();
+    if (batch.count == 0)
+        return;
+
+    times.resize(batch.count);
+    sweepBatchTimes(box, dx, dy, batch, times.data(), getSimdLevel());
+
+    for (size_t i = 0; i < batch.count; i++)
+    {
+        if (times[i] <= 1.0f)
+            hits.push_back({ static_cast<uint32_t>(i), times[i] });
+    }
+
+    if (hits.size() > 1)
+    {
+        std::sort(hits.begin(), hits.end(), [](const SweepHit& a, const SweepHit& b)
+        {
+            return a.time < b.time || (a.time == b.time && a.index < b.index);
+        });
+    }
+}
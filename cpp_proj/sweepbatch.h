@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "box.h"
+
+/**
+ * @enum SimdLevel
+ * @brief Instruction sets the batch kernels can run on, from slowest to fastest.
+ */
+enum class SimdLevel
+{
+    SCALAR,     ///< Portable C++, one box at a time.
+    SSE2,       ///< 4 boxes at a time.
+    AVX2        ///< 8 boxes at a time.
+};
+
+/**
+ * @struct BoxBatch
+ * @brief Read-only view of boxes stored as structure of arrays, e.g. an ObstacleStore.
+ */
+struct BoxBatch
+{
+    const float* x = nullptr;           ///< Center x coordinates.
+    const float* y = nullptr;           ///< Center y coordinates.
+    const float* width = nullptr;
+    const float* height = nullptr;
+    const uint8_t* active = nullptr;    ///< Inactive boxes are never hit.
+    size_t count = 0;
+};
+
+/**
+ * @struct SweepHit
+ * @brief A box touched by a swept box, with the time of impact as a fraction of the movement.
+ */
+struct SweepHit
+{
+    uint32_t index;
+    float time;
+};
+
+/**
+ * @brief Detects the best instruction set supported by this CPU and OS. Detection runs once.
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Retrieves a printable name of an instruction set.
+ */
+const char* getSimdLevelName(SimdLevel level);
+
+/**
+ * @brief Computes the time of impact of a box moving by (dx, dy) against every box of a batch.
+ *
+ * Every level produces results bit-for-bit identical to Box::sweep(), so the choice of
+ * instruction set never changes the simulation.
+ *
+ * @param box The moving box.
+ * @param dx Movement on the x-axis.
+ * @param dy Movement on the y-axis.
+ * @param batch The static boxes.
+ * @param times Receives one time per box: in [0, 1] if it is touched, greater than 1 otherwise.
+ * @param level Instruction set to use; must be supported by the CPU.
+ */
+void sweepBatchTimes(const Box& box, float dx, float dy, const BoxBatch& batch, float* times, SimdLevel level);
+
+/**
+ * @brief Finds every box of a batch touched by a box moving by (dx, dy), ordered by time of impact.
+ *
+ * @param box The moving box.
+ * @param dx Movement on the x-axis.
+ * @param dy Movement on the y-axis.
+ * @param batch The static boxes.
+ * @param times Scratch buffer for the per-box times, resized as needed.
+ * @param hits Receives the boxes touched, earliest first (ties ordered by index).
+ */
+void sweepBatch(const Box& box, float dx, float dy, const BoxBatch& batch,
+    std::vector<float>& times, std::vector<SweepHit>& hits);
@@ -0,0 +1,236 @@
+#include "threadpool.h"
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Starts the worker threads, each with its own task queue.
+ *
+ * @param threads Number of workers, or 0 to use one per hardware thread.
+ */
+ThreadPool::ThreadPool(unsigned threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned i = 0; i < threads; i++)
+    {
+        m_queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (unsigned i = 0; i < threads; i++)
+    {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Finishes all queued tasks and joins the workers.
+ */
+ThreadPool::~ThreadPool()
+{
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        m_stop = true;
+    }
+    m_wake_cv.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Queues a function for execution on one of the workers.
+ *
+ * @param task The task to run.
+ */
+void ThreadPool::submit(std::function<void()> task)
+{
+    Task queued;
+    queued.function = std::move(task);
+    push(std::move(queued));
+}
+
+/**
+ * @brief Queues a task on the next worker queue in round-robin order and wakes a worker.
+ *
+ * @param task The task to run.
+ */
+void ThreadPool::push(Task&& task)
+{
+    // Count the task before it becomes visible, so no worker can finish it first
+    m_pending++;
+    m_queued++;
+
+    unsigned index = m_next_queue++ % m_queues.size();
+    try
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    catch (...)
+    {
+        // The queue could not grow: the task never became visible
+        m_queued--;
+        if (--m_pending == 0)
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_done_cv.notify_all();
+        }
+        throw;
+    }
+
+    // Taking the lock orders this wake-up after a worker's check of m_queued
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+    }
+    m_wake_cv.notify_one();
+}
+
+/**
+ * @brief Runs range_function over [0, count) in chunks and waits for completion.
+ *
+ * Iterations are grouped into several chunks per worker, so that workers finishing early can
+ * steal remaining chunks from slower ones.
+ *
+ * @param count Number of iterations.
+ * @param range_function Runs the body over one chunk.
+ * @param body The body of parallelFor(); must outlive every chunk.
+ */
+void ThreadPool::runRanges(size_t count, RangeFunction range_function, const void* body)
+{
+    const size_t chunks_per_worker = 8;
+    size_t chunk_count = std::max<size_t>(1, std::min(count, m_workers.size() * chunks_per_worker));
+    size_t chunk_size = (count + chunk_count - 1) / chunk_count;
+
+    try
+    {
+        for (size_t begin = 0; begin < count; begin += chunk_size)
+        {
+            Task task;
+            task.range_function = range_function;
+            task.body = body;
+            task.begin = begin;
+            task.end = std::min(count, begin + chunk_size);
+            push(std::move(task));
+        }
+    }
+    catch (...)
+    {
+        // The queued chunks still use the body, which the caller is about to destroy
+        waitIdle();
+        throw;
+    }
+    wait();
+}
+
+/**
+ * @brief Blocks until every submitted task has finished.
+ */
+void ThreadPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_wake_mutex);
+    m_done_cv.wait(lock, [this]() { return m_pending == 0; });
+}
+
+/**
+ * @brief Blocks until every submitted task has finished, then rethrows the first exception one
+ * of them threw.
+ */
+void ThreadPool::wait()
+{
+    waitIdle();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        std::swap(error, m_error);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+/**
+ * @brief Takes a task for a worker.
+ *
+ * The worker first pops the most recently queued task of its own queue, then tries to steal the
+ * oldest task of every other queue in turn.
+ *
+ * @param index Index of the worker.
+ * @param task Receives the task.
+ * @return True if a task was taken.
+ */
+bool ThreadPool::takeTask(unsigned index, Task& task)
+{
+    for (size_t n = 0; n < m_queues.size(); n++)
+    {
+        WorkQueue& queue = *m_queues[(index + n) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.front == queue.tasks.size())
+            continue;
+
+        if (n == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks[queue.front++]);
+        }
+        if (queue.front == queue.tasks.size())
+        {
+            queue.tasks.clear(); // Keeps the storage
+            queue.front = 0;
+        }
+        m_queued--;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Main loop of each worker: runs tasks while any are available, then sleeps until new
+ * tasks are submitted or the pool is stopped.
+ *
+ * @param index Index of the worker and of its own queue.
+ */
+void ThreadPool::workerLoop(unsigned index)
+{
+    for (;;)
+    {
+        Task task;
+        if (takeTask(index, task))
+        {
+            try
+            {
+                if (task.range_function)
+                    task.range_function(task.body, task.begin, task.end);
+                else
+                    task.function();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_wake_mutex);
+                if (!m_error)
+                    m_error = std::current_exception();
+            }
+            task.function = nullptr; // Releases what it captured before wait() can return
+
+            if (--m_pending == 0)
+            {
+                std::lock_guard<std::mutex> lock(m_wake_mutex);
+                m_done_cv.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        m_wake_cv.wait(lock, [this]() { return m_stop || m_queued > 0; });
+        if (m_stop && m_queued == 0)
+            return;
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <functional>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads with one task queue each. Workers take tasks from the back of
+ * their own queue and steal from the front of other queues when theirs runs empty, so uneven task
+ * durations still keep every core busy.
+ */
+class ThreadPool
+{
+private:
+    typedef void (*RangeFunction)(const void* body, size_t begin, size_t end);
+
+    /**
+     * @struct Task
+     * @brief A queued task: either a range of parallelFor() iterations, run through a plain
+     * function pointer, or a function given to submit().
+     */
+    struct Task
+    {
+        RangeFunction range_function = nullptr;
+        const void* body = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        std::function<void()> function;     // Empty for parallelFor() ranges
+    };
+
+    /**
+     * @struct WorkQueue
+     * @brief Task queue owned by a single worker. Its storage is kept when it runs empty, so
+     * queuing does not allocate once the queue has grown to its working size.
+     */
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        size_t front = 0;                   // Tasks before it were stolen
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::atomic<size_t> m_queued{ 0 };       // Tasks submitted but not yet taken by a worker
+    std::atomic<size_t> m_pending{ 0 };      // Tasks submitted but not yet finished
+    std::atomic<unsigned> m_next_queue{ 0 }; // Round-robin queue for the next submitted task
+
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake_cv;       // Signals workers that tasks are available
+    std::condition_variable m_done_cv;       // Signals wait() that all tasks are finished
+    bool m_stop = false;
+    std::exception_ptr m_error;              // First exception thrown by a task since the last wait()
+
+    /**
+     * @brief Queues a task on the next worker queue and wakes a worker.
+     */
+    void push(Task&& task);
+
+    /**
+     * @brief Splits [0, count) into ranges, queues them and waits for completion.
+     */
+    void runRanges(size_t count, RangeFunction range_function, const void* body);
+
+    /**
+     * @brief Runs body(i) for every i in a range; the function pointer behind parallelFor().
+     */
+    template <typename Body>
+    static void runRange(const void* body, size_t begin, size_t end)
+    {
+        const Body& typed_body = *static_cast<const Body*>(body);
+        for (size_t i = begin; i < end; i++)
+        {
+            typed_body(i);
+        }
+    }
+
+    /**
+     * @brief Blocks until every submitted task has finished, without rethrowing their exceptions.
+     */
+    void waitIdle();
+
+    /**
+     * @brief Takes a task from the worker's own queue, or steals one from another queue.
+     * @return True if a task was taken.
+     */
+    bool takeTask(unsigned index, Task& task);
+
+    /**
+     * @brief Main loop of each worker thread.
+     */
+    void workerLoop(unsigned index);
+
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param threads Number of workers, or 0 to use one per hardware thread.
+     */
+    explicit ThreadPool(unsigned threads = 0);
+
+    /**
+     * @brief Finishes all queued tasks and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task for execution on one of the workers.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Runs body(i) for every i in [0, count), split into chunks spread over the workers,
+     * and waits for completion. The body is called directly, without a std::function, and
+     * queuing the chunks does not allocate once the queues have grown to their working size.
+     * @param count Number of iterations.
+     * @param body Function called once per iteration; must be safe to call concurrently.
+     * @throws The first exception thrown by body, once every chunk has finished.
+     */
+    template <typename Body>
+    void parallelFor(size_t count, const Body& body)
+    {
+        runRanges(count, &runRange<Body>, &body);
+    }
+
+    /**
+     * @brief Blocks until every submitted task has finished.
+     * @throws The first exception thrown by a task since the last wait().
+     */
+    void wait();
+
+    /**
+     * @brief Retrieves the number of worker threads.
+     */
+    unsigned getThreadCount() const { return static_cast<unsigned>(m_workers.size()); }
+};
@@ -1,5 +1,6 @@
 #include "timer.h"
 #include <sgg/graphics.h>
+#include <cmath>
 
 /**
  * @brief Constructs a new Timer object.
@@ -99,11 +100,11 @@ Timer::operator float()
 			break;
 		case TIMER_LOOPING:
 			// Calculate the progress of a looping timer using modulo for continuous cycling
-			m_val = fmodf(graphics::getGlobalTime() / 1000.f - m_time_start, m_period) / m_period;
+			m_val = std::fmod(graphics::getGlobalTime() / 1000.f - m_time_start, m_period) / m_period;
 			break;
 		case TIMER_PINGPONG:
 			// Calculate the progress of a ping-pong timer, reversing direction at each end
-			m_val = fmodf(graphics::getGlobalTime() / 1000.f - m_time_start, 2.0f * m_period) / m_period;
+			m_val = std::fmod(graphics::getGlobalTime() / 1000.f - m_time_start, 2.0f * m_period) / m_period;
 			m_pingpong_descending = m_val > 1.0f;
 			m_val = (m_val <= 1.0f ? m_val : 2.0f - m_val);
 			break;
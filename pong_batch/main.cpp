@@ -0,0 +1,398 @@
+// pong_batch: runs many unattended matches in parallel for balancing sweeps
+#include "match.h"
+#include "threadpool.h"
+#include "profiler.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * @struct BatchOptions
+ * @brief Command line options of the batch runner.
+ */
+struct BatchOptions
+{
+    size_t matches = 1000;          ///< Number of matches to play.
+    unsigned threads = 0;           ///< Worker threads (0 = one per hardware thread).
+    uint32_t seed = 1;              ///< Base seed; match i uses a seed derived from it.
+    double max_minutes = 30.0;      ///< Game time after which a match is abandoned.
+    std::string csv_path;           ///< Optional per-match CSV output.
+    std::string record_dir;         ///< Optional directory receiving one replay per match.
+    std::string replay_path;        ///< Replay to verify instead of playing new matches.
+    std::string levels_path;        ///< Optional level file replacing the built-in levels.
+    LevelSet levels;                ///< Levels read from levels_path.
+    std::string profile_path;       ///< Chrome trace of one profiled match instead of a batch.
+    size_t profile_ticks = 2000;    ///< Most recent ticks kept in the trace.
+    SimConfig config;               ///< Gameplay constants under test.
+    bool use_ai = false;            ///< Play with PaddleAIs instead of MatchBots.
+    PaddleAIConfig ai;              ///< Skill of the PaddleAIs.
+};
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage()
+{
+    std::cout <<
+        "Usage: pong_batch [options]\n"
+        "  --matches N              Number of matches to play (default 1000)\n"
+        "  --threads N              Worker threads (default: all hardware threads)\n"
+        "  --seed N                 Base seed (default 1)\n"
+        "  --max-minutes F          Abandon matches after F minutes of game time (default 30)\n"
+        "  --ball-speed F           Base ball speed in units per ms (default 0.7)\n"
+        "  --sudden-death-factor F  Ball speed factor in Sudden Death (default 1.4)\n"
+        "  --speed-up F             SPEED_UP powerup factor (default 1.5)\n"
+        "  --slow-down F            SLOW_DOWN powerup factor (default 0.6)\n"
+        "  --tick-rate F            Simulation ticks per second (default 240)\n"
+        "  --grid-cell-size F       Broadphase grid cell size (default 100)\n"
+        "  --bot NAME               Paddle controllers: scripted (default) or ai\n"
+        "  --ai-reaction MS         Reaction delay of the ai bots (default 150)\n"
+        "  --ai-error F             Maximum aiming error of the ai bots (default 40)\n"
+        "  --csv PATH               Write one line per match to PATH\n"
+        "  --record DIR             Write the replay of every match to DIR\n"
+        "  --levels PATH            Level file to play, as text or compiled (.bin) (default: built-in levels)\n"
+        "  --replay PATH            Play back a replay and verify it reproduces the recorded match\n"
+        "  --profile PATH           Profile one match on the main thread and write a Chrome trace to PATH\n"
+        "  --profile-ticks N        Most recent ticks kept in the trace (default 2000)\n";
+}
+
+/**
+ * @brief Parses the command line into options.
+ * @return False if the arguments are invalid or help was requested.
+ */
+static bool parseOptions(int argc, char** argv, BatchOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h")
+            return false;
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "--matches")
+            options.matches = std::strtoull(value, nullptr, 10);
+        else if (arg == "--threads")
+            options.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--seed")
+            options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        else if (arg == "--max-minutes")
+            options.max_minutes = std::atof(value);
+        else if (arg == "--ball-speed")
+            options.config.ball_speed = static_cast<float>(std::atof(value));
+        else if (arg == "--sudden-death-factor")
+            options.config.sudden_death_speed_factor = static_cast<float>(std::atof(value));
+        else if (arg == "--speed-up")
+            options.config.speed_up_factor = static_cast<float>(std::atof(value));
+        else if (arg == "--slow-down")
+            options.config.slow_down_factor = static_cast<float>(std::atof(value));
+        else if (arg == "--tick-rate")
+            options.config.tick_rate = static_cast<float>(std::atof(value));
+        else if (arg == "--grid-cell-size")
+            options.config.grid_cell_size = static_cast<float>(std::atof(value));
+        else if (arg == "--bot")
+        {
+            if (std::strcmp(value, "scripted") != 0 && std::strcmp(value, "ai") != 0)
+            {
+                std::cerr << "Unknown bot " << value << "\n";
+                return false;
+            }
+            options.use_ai = std::strcmp(value, "ai") == 0;
+        }
+        else if (arg == "--ai-reaction")
+            options.ai.reaction_ms = static_cast<float>(std::atof(value));
+        else if (arg == "--ai-error")
+            options.ai.max_error = static_cast<float>(std::atof(value));
+        else if (arg == "--csv")
+            options.csv_path = value;
+        else if (arg == "--record")
+            options.record_dir = value;
+        else if (arg == "--levels")
+            options.levels_path = value;
+        else if (arg == "--replay")
+            options.replay_path = value;
+        else if (arg == "--profile")
+            options.profile_path = value;
+        else if (arg == "--profile-ticks")
+            options.profile_ticks = std::strtoull(value, nullptr, 10);
+        else
+        {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return options.matches > 0 && options.config.tick_rate > 0.0f && options.config.grid_cell_size > 0.0f;
+}
+
+/**
+ * @brief Derives the seed of match i from the base seed, so neighbouring matches are uncorrelated.
+ */
+static uint32_t matchSeed(uint32_t base_seed, size_t index)
+{
+    uint64_t z = base_seed + 0x9E3779B97F4A7C15ull * (index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+
+/**
+ * @brief Reads a level file: compiled if its name ends in ".bin", level text otherwise.
+ * @return False if the file could not be read or is invalid.
+ */
+static bool loadLevelFile(const std::string& path, LevelSet& levels)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Could not read level file " << path << "\n";
+        return false;
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    std::string error;
+    bool compiled = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    bool loaded = compiled ? levels.load(reinterpret_cast<const uint8_t*>(data.data()), data.size(), error)
+        : levels.parse(data.data(), data.size(), error);
+    if (!loaded)
+        std::cerr << "Invalid level file " << path << ": " << error << "\n";
+    return loaded;
+}
+
+/**
+ * @brief Writes one CSV line per match.
+ */
+static void writeCsv(const std::string& path, const std::vector<MatchResult>& results)
+{
+    std::ofstream out(path);
+    if (!out)
+    {
+        std::cerr << "Could not open " << path << " for writing.\n";
+        return;
+    }
+
+    out << "seed,winner,final_level,score1,score2,duration_s,points,paddle_hits,longest_rally\n";
+    for (const MatchResult& r : results)
+    {
+        out << r.seed << ',' << r.winner << ',' << r.final_level << ',' << r.score1 << ',' << r.score2 << ','
+            << r.getDuration() << ',' << r.points << ',' << r.paddle_hits << ',' << r.longest_rally << '\n';
+    }
+}
+
+/**
+ * @brief Prints win rates, rally lengths and match durations over all matches.
+ */
+static void printSummary(const BatchOptions& options, const std::vector<MatchResult>& results,
+    double wall_seconds, unsigned threads)
+{
+    size_t wins[3] = { 0, 0, 0 };
+    size_t sudden_death = 0;
+    uint64_t points = 0;
+    uint64_t paddle_hits = 0;
+    uint64_t ticks = 0;
+    int longest_rally = 0;
+    double min_duration = results.front().getDuration();
+    double max_duration = min_duration;
+    double total_duration = 0.0;
+
+    for (const MatchResult& r : results)
+    {
+        wins[r.winner]++;
+        if (r.final_level == 4)
+            sudden_death++;
+        points += r.points;
+        paddle_hits += r.paddle_hits;
+        ticks += r.ticks;
+        longest_rally = std::max(longest_rally, r.longest_rally);
+
+        double duration = r.getDuration();
+        total_duration += duration;
+        min_duration = std::min(min_duration, duration);
+        max_duration = std::max(max_duration, duration);
+    }
+
+    double n = static_cast<double>(results.size());
+    std::cout << "Matches:            " << results.size() << " on " << threads << " threads in "
+        << wall_seconds << " s (" << n / wall_seconds << " matches/s, "
+        << ticks / wall_seconds / 1e6 << " M ticks/s)\n";
+    std::cout << "Config:             ball_speed=" << options.config.ball_speed
+        << " sudden_death_factor=" << options.config.sudden_death_speed_factor
+        << " speed_up=" << options.config.speed_up_factor
+        << " slow_down=" << options.config.slow_down_factor
+        << " tick_rate=" << options.config.tick_rate << "\n";
+    std::cout << "Levels:             " << (options.levels_path.empty() ? "built-in" : options.levels_path) << "\n";
+    if (options.use_ai)
+        std::cout << "Bots:               ai reaction=" << options.ai.reaction_ms << " ms error=" << options.ai.max_error << "\n";
+    else
+        std::cout << "Bots:               scripted\n";
+    std::cout << "Player 1 wins:      " << 100.0 * wins[1] / n << " %\n";
+    std::cout << "Player 2 wins:      " << 100.0 * wins[2] / n << " %\n";
+    std::cout << "Abandoned:          " << 100.0 * wins[0] / n << " %\n";
+    std::cout << "Sudden Death:       " << 100.0 * sudden_death / n << " %\n";
+    std::cout << "Mean rally length:  " << (points ? static_cast<double>(paddle_hits) / points : 0.0)
+        << " hits (longest " << longest_rally << ")\n";
+    std::cout << "Match duration:     mean " << total_duration / n << " s, min " << min_duration
+        << " s, max " << max_duration << " s\n";
+}
+
+/**
+ * @brief Plays back a replay headlessly and checks that the final state matches the recording.
+ * @return The process exit code: 0 if the replay reproduced the match bit-for-bit.
+ */
+static int verifyReplay(const BatchOptions& options)
+{
+    const std::string& path = options.replay_path;
+    Replay replay;
+    if (!loadReplay(path, replay))
+    {
+        std::cerr << "Could not read replay " << path << "\n";
+        return 1;
+    }
+
+    const LevelSet& levels = options.levels_path.empty() ? LevelSet::getDefault() : options.levels;
+    if (levels.getHash() != replay.levels_hash)
+    {
+        std::cerr << "Replay " << path << " was recorded with other levels than "
+            << (options.levels_path.empty() ? "the built-in ones" : options.levels_path)
+            << "; pass the level file of the match with --levels.\n";
+        return 2;
+    }
+
+    Simulation sim;
+    auto start = std::chrono::steady_clock::now();
+    bool identical = playReplay(replay, levels, sim);
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double game_seconds = replay.tick_count * static_cast<double>(sim.getTickMs()) / 1000.0;
+
+    std::cout << "Replay:             " << path << " (seed " << replay.seed << ", " << replay.tick_count
+        << " ticks, " << replay.inputs.size() << " input bytes)\n";
+    std::cout << "Result:             level " << sim.getLevelNumber() << ", winner " << sim.getWinner()
+        << ", score " << sim.getScore(1) << " - " << sim.getScore(2) << "\n";
+    std::cout << "Playback:           " << game_seconds << " s of game time in " << wall_seconds << " s ("
+        << (wall_seconds > 0.0 ? game_seconds / wall_seconds : 0.0) << "x real time)\n";
+    std::cout << "State:              " << (identical ? "identical to the recording" : "DIVERGED from the recording") << "\n";
+    return identical ? 0 : 2;
+}
+
+/**
+ * @brief Plays the first match of the batch on the main thread with the profiler enabled, one
+ * frame per tick, and writes the most recent ticks as a Chrome trace (chrome://tracing, Perfetto).
+ * @return The process exit code.
+ */
+static int profileMatch(const BatchOptions& options, uint64_t max_ticks)
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.setFrameCapacity(options.profile_ticks + 1);
+    profiler.setEnabled(true);
+
+    uint32_t seed = matchSeed(options.seed, 0);
+    auto start = std::chrono::steady_clock::now();
+    MatchResult result = runMatch(seed, options.config, max_ticks, nullptr, options.use_ai ? &options.ai : nullptr,
+        options.levels_path.empty() ? nullptr : &options.levels);
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    profiler.nextFrame(); // Close the last tick
+    profiler.setEnabled(false);
+
+    // Average duration of each zone over the kept ticks
+    std::vector<std::pair<std::string, std::pair<uint64_t, uint64_t>>> zones;
+    for (size_t age = 0; age < profiler.getFrameCount(); age++)
+    {
+        for (const ProfileEvent& event : profiler.getFrame(age).events)
+        {
+            auto it = std::find_if(zones.begin(), zones.end(),
+                [&](const std::pair<std::string, std::pair<uint64_t, uint64_t>>& zone) { return zone.first == event.name; });
+            if (it == zones.end())
+                it = zones.insert(zones.end(), { event.name, { 0, 0 } });
+            it->second.first += event.end_ns - event.start_ns;
+            it->second.second++;
+        }
+    }
+
+    std::cout << "Profiled match:     seed " << seed << ", " << result.ticks << " ticks in " << wall_seconds << " s\n";
+    std::cout << "Kept ticks:         " << profiler.getFrameCount() << "\n";
+    for (const auto& zone : zones)
+    {
+        std::cout << "  " << zone.first << ": " << zone.second.second << " calls, "
+            << static_cast<double>(zone.second.first) / zone.second.second << " ns/call\n";
+    }
+
+    if (!profiler.exportChromeTrace(options.profile_path))
+    {
+        std::cerr << "Could not write profile " << options.profile_path << "\n";
+        return 1;
+    }
+    std::cout << "Trace:              " << options.profile_path << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    BatchOptions options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (!options.levels_path.empty() && !loadLevelFile(options.levels_path, options.levels))
+    {
+        return 1;
+    }
+
+    if (!options.replay_path.empty())
+    {
+        return verifyReplay(options);
+    }
+
+    const uint64_t max_ticks = static_cast<uint64_t>(options.max_minutes * 60.0 * options.config.tick_rate);
+    if (!options.profile_path.empty())
+    {
+        return profileMatch(options, max_ticks);
+    }
+
+    std::vector<MatchResult> results(options.matches);
+    const PaddleAIConfig* ai = options.use_ai ? &options.ai : nullptr;
+    const LevelSet* levels = options.levels_path.empty() ? nullptr : &options.levels;
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned threads;
+    {
+        ThreadPool pool(options.threads);
+        threads = pool.getThreadCount();
+        pool.parallelFor(options.matches, [&](size_t i)
+        {
+            uint32_t seed = matchSeed(options.seed, i);
+            if (options.record_dir.empty())
+            {
+                results[i] = runMatch(seed, options.config, max_ticks, nullptr, ai, levels);
+                return;
+            }
+
+            ReplayRecorder recorder;
+            results[i] = runMatch(seed, options.config, max_ticks, &recorder, ai, levels);
+            std::string path = options.record_dir + "/match_" + std::to_string(seed) + ".pongrec";
+            if (!saveReplay(path, recorder.getReplay()))
+            {
+                std::cerr << "Could not write replay " << path << "\n";
+            }
+        });
+    }
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printSummary(options, results, wall_seconds, threads);
+    if (!options.csv_path.empty())
+    {
+        writeCsv(options.csv_path, results);
+    }
+    return 0;
+}
@@ -0,0 +1,708 @@
+// pong_bench: microbenchmarks of the physics and game-loop hot paths, reported as JSON with
+// ns/op, allocations/op and instructions/op so runs can be compared across commits
+//
+// Usage: pong_bench [--json PATH] [--filter TEXT] [--min-time MS]
+#include "simulation.h"
+#include "paddleai.h"
+#include "pong_env.h"
+#include "threadpool.h"
+#include "leveldef.h"
+#include "alloccounter.h"
+#include "config.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class InstructionCounter
+ * @brief Counts the user-space instructions retired by the calling thread, through the Linux
+ * perf_event interface. Elsewhere, or when the kernel or the machine denies access to the
+ * hardware counters, isAvailable() is false and the count stays at zero.
+ */
+class InstructionCounter
+{
+    int m_fd = -1;
+
+public:
+    InstructionCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter()
+    {
+#ifdef __linux__
+        if (m_fd >= 0)
+            close(m_fd);
+#endif
+    }
+
+    InstructionCounter(const InstructionCounter&) = delete;
+    InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+    bool isAvailable() const { return m_fd >= 0; }
+
+    /**
+     * @brief Instructions retired since the counter was opened.
+     */
+    uint64_t read() const
+    {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (m_fd >= 0 && ::read(m_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+            count = 0;
+#endif
+        return count;
+    }
+};
+
+/**
+ * @class Meter
+ * @brief Accumulates time, heap allocations and instructions over the timed sections of a
+ * benchmark. Setup work between stop() and the next start() is not counted.
+ */
+class Meter
+{
+    using Clock = std::chrono::steady_clock;
+
+    const InstructionCounter& m_instructions;
+    Clock::time_point m_start;
+    uint64_t m_start_allocations = 0;
+    uint64_t m_start_instructions = 0;
+
+public:
+    double ns = 0.0;
+    uint64_t ops = 0;
+    uint64_t allocations = 0;
+    uint64_t instructions = 0;
+
+    explicit Meter(const InstructionCounter& instructions) : m_instructions(instructions) {}
+
+    void start()
+    {
+        m_start_allocations = AllocCounter::getThreadAllocations();
+        m_start_instructions = m_instructions.read();
+        m_start = Clock::now();
+    }
+
+    /**
+     * @param count Operations done since start().
+     */
+    void stop(uint64_t count)
+    {
+        Clock::time_point end = Clock::now();
+        instructions += m_instructions.read() - m_start_instructions;
+        allocations += AllocCounter::getThreadAllocations() - m_start_allocations;
+        ns += std::chrono::duration<double, std::nano>(end - m_start).count();
+        ops += count;
+    }
+};
+
+/**
+ * @struct BenchResult
+ * @brief Per-operation figures of one benchmark.
+ */
+struct BenchResult
+{
+    std::string name;
+    std::string op;         // What one operation is
+    uint64_t ops = 0;
+    double ns_per_op = 0.0;
+    double allocations_per_op = 0.0;
+    double instructions_per_op = 0.0;
+};
+
+/**
+ * @struct BenchOptions
+ * @brief Command line of the benchmark run.
+ */
+struct BenchOptions
+{
+    std::string json_path;  // Empty: write the JSON to stdout
+    std::string filter;     // Only benchmarks whose name contains this text
+    double min_time_ms = 200.0;
+};
+
+/**
+ * @class BenchRunner
+ * @brief Runs benchmark rounds until the timed sections add up to the minimum time, after one
+ * warm-up round, and collects the results.
+ */
+class BenchRunner
+{
+    const BenchOptions& m_options;
+    InstructionCounter m_instructions;
+    std::vector<BenchResult> m_results;
+
+public:
+    explicit BenchRunner(const BenchOptions& options) : m_options(options) {}
+
+    /**
+     * @param name Name of the benchmark, matched against --filter.
+     * @param op What one operation of the benchmark is, for the report.
+     * @param round Called with a Meter; does its setup, then times one or more operations
+     * between Meter::start() and Meter::stop().
+     */
+    template <typename Round>
+    void run(const std::string& name, const std::string& op, Round round)
+    {
+        if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos)
+            return;
+
+        Meter warm_up(m_instructions);
+        round(warm_up);
+
+        Meter meter(m_instructions);
+        do
+        {
+            round(meter);
+        } while (meter.ns < m_options.min_time_ms * 1e6 || meter.ops == 0);
+
+        BenchResult result;
+        result.name = name;
+        result.op = op;
+        result.ops = meter.ops;
+        result.ns_per_op = meter.ns / meter.ops;
+        result.allocations_per_op = static_cast<double>(meter.allocations) / meter.ops;
+        result.instructions_per_op = static_cast<double>(meter.instructions) / meter.ops;
+        m_results.push_back(result);
+
+        std::cerr << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << result.ns_per_op << " ns/op  " << std::setprecision(3)
+            << result.allocations_per_op << " allocs/op\n";
+    }
+
+    /**
+     * @brief Writes every result as JSON. Counts that this build or machine cannot measure are null.
+     */
+    void writeJson(std::ostream& out) const
+    {
+        out << "{\n";
+        out << "  \"instructions_available\": " << (m_instructions.isAvailable() ? "true" : "false") << ",\n";
+        out << "  \"allocations_available\": " << (AllocCounter::isEnabled() ? "true" : "false") << ",\n";
+        out << "  \"benchmarks\": [\n";
+        for (size_t i = 0; i < m_results.size(); i++)
+        {
+            const BenchResult& r = m_results[i];
+            out << "    { \"name\": \"" << r.name << "\", \"op\": \"" << r.op << "\", \"ops\": " << r.ops
+                << std::fixed << std::setprecision(3) << ", \"ns_per_op\": " << r.ns_per_op
+                << ", \"allocations_per_op\": ";
+            if (AllocCounter::isEnabled())
+                out << r.allocations_per_op;
+            else
+                out << "null";
+            out << ", \"instructions_per_op\": ";
+            if (m_instructions.isAvailable())
+                out << r.instructions_per_op;
+            else
+                out << "null";
+            out << " }" << (i + 1 < m_results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+};
+
+/**
+ * @brief Parses a generated level text, exiting on errors since the benchmarks rely on it.
+ */
+static void parseLevels(LevelSet& levels, const std::string& text)
+{
+    std::string error;
+    if (!levels.parse(text.data(), text.size(), error))
+    {
+        std::cerr << "Invalid benchmark level: " << error << "\n";
+        std::exit(1);
+    }
+}
+
+/**
+ * @brief A level without time limit or win score holding a number of obstacles in the middle of
+ * the canvas. Every other obstacle is an unbreakable one moving vertically, the others are
+ * breakable and static, like the obstacles of Level 3.
+ * @param moving_only Make every obstacle a moving unbreakable one.
+ */
+static std::string makeObstacleLevel(int number, int obstacles, bool moving_only)
+{
+    std::ostringstream text;
+    text << "level " << number << "\n";
+    const int columns = 40;
+    for (int i = 0; i < obstacles; i++)
+    {
+        float x = 150.0f + (i % columns) * 15.0f;
+        float y = 100.0f + ((i / columns) % 25) * 28.0f;
+        if (moving_only || i % 2 == 1)
+            text << "obstacle unbreakable " << x << " " << y << " 0 0.5\n";
+        else
+            text << "obstacle breakable " << x << " " << y << " 2 0\n";
+    }
+    return text.str();
+}
+
+/**
+ * @brief Input of paddles that follow the ball, so the benchmarks play rallies rather than
+ * scoring on every serve.
+ */
+static SimInput trackBall(const Simulation& sim)
+{
+    SimInput input;
+    const float ball_y = sim.getBall().y;
+    PaddleInput* paddles[2] = { &input.player1, &input.player2 };
+    for (int player = 1; player <= 2; player++)
+    {
+        float paddle_y = sim.getPaddle(player).y;
+        paddles[player - 1]->up = ball_y < paddle_y - 10.0f;
+        paddles[player - 1]->down = ball_y > paddle_y + 10.0f;
+    }
+    return input;
+}
+
+/**
+ * @brief Box pairs spread over the canvas, so about half of them overlap.
+ */
+static std::vector<Box> makeBoxPairs(size_t pairs)
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> pos(0.0f, 200.0f);
+    std::uniform_real_distribution<float> size(10.0f, 100.0f);
+
+    std::vector<Box> boxes;
+    for (size_t i = 0; i < pairs * 2; i++)
+    {
+        boxes.push_back(Box(pos(rng), pos(rng), size(rng), size(rng)));
+    }
+    return boxes;
+}
+
+/**
+ * @brief Box::intersect, intersectDown and intersectSideways over the same box pairs.
+ */
+static void benchBoxes(BenchRunner& runner)
+{
+    static const size_t PAIRS = 1024;
+    std::vector<Box> boxes = makeBoxPairs(PAIRS);
+    volatile float sink = 0.0f;
+
+    runner.run("box_intersect", "box pair", [&](Meter& meter) {
+        int hits = 0;
+        meter.start();
+        for (size_t i = 0; i < boxes.size(); i += 2)
+        {
+            hits += boxes[i].intersect(boxes[i + 1]) ? 1 : 0;
+        }
+        meter.stop(PAIRS);
+        sink = sink + static_cast<float>(hits);
+    });
+
+    runner.run("box_intersect_down", "box pair", [&](Meter& meter) {
+        float offset = 0.0f;
+        meter.start();
+        for (size_t i = 0; i < boxes.size(); i += 2)
+        {
+            offset += boxes[i].intersectDown(boxes[i + 1]);
+        }
+        meter.stop(PAIRS);
+        sink = sink + offset;
+    });
+
+    runner.run("box_intersect_sideways", "box pair", [&](Meter& meter) {
+        float offset = 0.0f;
+        meter.start();
+        for (size_t i = 0; i < boxes.size(); i += 2)
+        {
+            offset += boxes[i].intersectSideways(boxes[i + 1]);
+        }
+        meter.stop(PAIRS);
+        sink = sink + offset;
+    });
+}
+
+/**
+ * @brief The ball movement of a tick on an empty level, with and without an active powerup, and
+ * the serve that resets the ball.
+ *
+ * The ball has no update of its own any more: Simulation::tick moves it together with the
+ * paddles. On an empty level the tick is the ball movement, its wall and paddle contacts and the
+ * powerup timer. A powerup placed on the serve position is collected on the first ticks, so the
+ * powerup benchmark times the ticks while its effect is active.
+ */
+static void benchBall(BenchRunner& runner)
+{
+    static const int TICKS = 240;
+
+    LevelSet levels;
+    parseLevels(levels,
+        "level 1\n"
+        "level 2\n"
+        "powerup_schedule 0 0 0\n"
+        "powerup increase_size 450 450\n");
+
+    Simulation sim(1);
+    sim.setLevels(levels);
+
+    runner.run("ball_update", "tick", [&](Meter& meter) {
+        sim.loadLevel(1);
+        meter.start();
+        for (int i = 0; i < TICKS; i++)
+        {
+            sim.tick(trackBall(sim));
+            sim.clearEvents();
+        }
+        meter.stop(TICKS);
+    });
+
+    runner.run("ball_update_powerup", "tick", [&](Meter& meter) {
+        sim.loadLevel(2);
+        while (!sim.getBall().powerup_active && sim.getTick() < 1000)
+        {
+            sim.tick(trackBall(sim));
+            sim.clearEvents();
+        }
+
+        int ticks = 0;
+        meter.start();
+        while (sim.getBall().powerup_active && ticks < TICKS)
+        {
+            sim.tick(trackBall(sim));
+            sim.clearEvents();
+            ticks++;
+        }
+        meter.stop(static_cast<uint64_t>(ticks));
+    });
+
+    // A serve resets paddles and ball; loading the empty level is nothing more than that
+    runner.run("ball_reset", "serve", [&](Meter& meter) {
+        meter.start();
+        for (int i = 0; i < TICKS; i++)
+        {
+            sim.loadLevel(1);
+        }
+        meter.stop(TICKS);
+    });
+}
+
+/**
+ * @brief Movement of unbreakable obstacles, per obstacle and tick.
+ *
+ * Obstacles are moved by Simulation::tick from their store; with 1000 moving obstacles the
+ * movement and the grid updates it causes dominate the tick, so the tick divided by the
+ * obstacle count is the cost of one obstacle update.
+ */
+static void benchObstacles(BenchRunner& runner)
+{
+    static const int OBSTACLES = 1000;
+    static const int TICKS = 60;
+
+    LevelSet levels;
+    parseLevels(levels, makeObstacleLevel(1, OBSTACLES, true));
+    Simulation sim(1);
+    sim.setLevels(levels);
+
+    runner.run("obstacle_update", "obstacle", [&](Meter& meter) {
+        sim.loadLevel(1);
+        meter.start();
+        for (int i = 0; i < TICKS; i++)
+        {
+            sim.tick(trackBall(sim));
+            sim.clearEvents();
+        }
+        meter.stop(static_cast<uint64_t>(TICKS) * OBSTACLES);
+    });
+}
+
+/**
+ * @brief Loading a compiled level file of 10,000 objects, which should take well under 1 ms.
+ *
+ * Half of the objects are obstacles and half powerups; each round loads the same bytes into the
+ * set that was loaded last, like a level reload does.
+ */
+static void benchLevelLoad(BenchRunner& runner)
+{
+    static const int OBJECTS = 10000;
+
+    std::string text = makeObstacleLevel(1, OBJECTS / 2, false);
+    text += "powerup_schedule 1 1 2\n";
+    for (int i = 0; i < OBJECTS / 2; i++)
+    {
+        text += "powerup speed_up " + std::to_string(200 + i % 500) + " " + std::to_string(200 + i / 500 * 50) + "\n";
+    }
+    LevelSet source;
+    parseLevels(source, text);
+    const std::vector<uint8_t> data = source.save();
+
+    LevelSet levels;
+    runner.run("level_load_10k", "level file", [&](Meter& meter) {
+        std::string error;
+        meter.start();
+        bool loaded = levels.load(data.data(), data.size(), error);
+        meter.stop(1);
+        if (!loaded)
+        {
+            std::cerr << "Invalid compiled benchmark level: " << error << "\n";
+            std::exit(1);
+        }
+    });
+}
+
+/**
+ * @brief The random spawners of Sudden Death, with their intervals cut to zero so one spawns an
+ * object on every tick, up to their limits.
+ */
+static void benchSpawning(BenchRunner& runner)
+{
+    static const int LIMIT = 200;
+
+    std::ostringstream text;
+    text << "level 4\nsudden_death\n"
+        << "spawn obstacle unbreakable hit_points=0 speed=0.5 limit=" << LIMIT << " first=0 interval=0,0 area=250,200,650,650\n"
+        << "spawn obstacle breakable hit_points=2 speed=0 limit=" << LIMIT << " first=0 interval=0,0 area=250,200,650,650\n"
+        << "spawn powerup types=slow_down,increase_size,decrease_size,slow_down limit=" << LIMIT
+        << " first=0 interval=0,0 area=200,200,700,700 min_distance=100\n";
+
+    LevelSet levels;
+    parseLevels(levels, text.str());
+    Simulation sim(1);
+    sim.setLevels(levels);
+
+    runner.run("sudden_death_spawn", "spawn", [&](Meter& meter) {
+        sim.loadLevel(4);
+        uint64_t spawns = 0;
+        meter.start();
+        for (int i = 0; i < LIMIT; i++)
+        {
+            sim.tick(trackBall(sim));
+            for (const SimEvent& event : sim.getEvents())
+            {
+                if (event.type == SimEventType::OBSTACLE_SPAWNED || event.type == SimEventType::POWERUP_SPAWNED)
+                    spawns++;
+            }
+            sim.clearEvents();
+        }
+        meter.stop(spawns);
+    });
+}
+
+/**
+ * @brief The closed-form intercept prediction of PaddleAI, and a whole PaddleAI input with its
+ * reaction delay, during a rally between two PaddleAIs.
+ */
+static void benchPaddleAI(BenchRunner& runner)
+{
+    static const size_t STATES = 1024;
+    static const int TICKS = 240;
+    static const int POLLS = 16;
+
+    // Ball states anywhere on the canvas, flying at up to several wall bounces per crossing
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> pos(10.0f, CANVAS_WIDTH - 10.0f);
+    std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+    std::vector<float> states;
+    for (size_t i = 0; i < STATES; i++)
+    {
+        float speed_x = speed(rng);
+        states.push_back(pos(rng));
+        states.push_back(pos(rng));
+        states.push_back(speed_x != 0.0f ? speed_x : 1.0f);
+        states.push_back(speed(rng) * 3.0f);
+    }
+    volatile float sink = 0.0f;
+
+    runner.run("ai_predict", "prediction", [&](Meter& meter) {
+        float sum = 0.0f;
+        meter.start();
+        for (size_t i = 0; i < states.size(); i += 4)
+        {
+            float target_x = states[i + 2] < 0.0f ? 62.5f : CANVAS_WIDTH - 62.5f;
+            sum += predictBallY(states[i], states[i + 1], states[i + 2], states[i + 3], 15.0f, target_x);
+        }
+        meter.stop(STATES);
+        sink = sink + sum;
+    });
+
+    LevelSet levels;
+    parseLevels(levels, "level 1\n");
+    Simulation sim(1);
+    sim.setLevels(levels);
+    PaddleAI ai1(1), ai2(2);
+
+    // Each AI is polled several times per tick, so the clock reads are spread over many calls
+    runner.run("ai_input", "input", [&](Meter& meter) {
+        sim.loadLevel(1);
+        const float dt = sim.getTickMs() / POLLS;
+        for (int i = 0; i < TICKS; i++)
+        {
+            SimInput input;
+            meter.start();
+            for (int poll = 0; poll < POLLS; poll++)
+            {
+                input.player1 = ai1.getInput(sim, 1, dt);
+                input.player2 = ai2.getInput(sim, 2, dt);
+            }
+            meter.stop(2 * POLLS);
+            sim.tick(input);
+            sim.clearEvents();
+        }
+    });
+}
+
+/**
+ * @brief One 60 Hz frame of gameplay at 0, 10, 100 and 1000 obstacles: Simulation::advance, the
+ * part of Level::update that runs the rules of an active level.
+ */
+static void benchLevel(BenchRunner& runner)
+{
+    static const int FRAMES = 60;
+    static const float FRAME_MS = 1000.0f / 60.0f;
+    const int counts[] = { 0, 10, 100, 1000 };
+
+    for (int count : counts)
+    {
+        LevelSet levels;
+        parseLevels(levels, makeObstacleLevel(1, count, false));
+        Simulation sim(1);
+        sim.setLevels(levels);
+        sim.reserveFrameEvents();
+
+        runner.run("level_update_" + std::to_string(count), "frame", [&](Meter& meter) {
+            sim.loadLevel(1);
+            meter.start();
+            for (int i = 0; i < FRAMES; i++)
+            {
+                sim.advance(FRAME_MS, trackBall(sim));
+            }
+            meter.stop(FRAMES);
+        });
+    }
+}
+
+/**
+ * @brief Hands 4096 iterations to the workers and waits for them, as pong_env does on every step:
+ * the cost of a parallelFor() call, queuing included.
+ */
+static void benchThreadPool(BenchRunner& runner)
+{
+    static const size_t COUNT = 4096;
+    static const int CALLS = 16;
+
+    ThreadPool pool(4);
+    std::vector<uint32_t> values(COUNT);
+
+    runner.run("parallel_for_" + std::to_string(COUNT), "call", [&](Meter& meter) {
+        meter.start();
+        for (int i = 0; i < CALLS; i++)
+        {
+            pool.parallelFor(COUNT, [&values](size_t index)
+            {
+                values[index] = values[index] * 1664525u + 1013904223u;
+            });
+        }
+        meter.stop(CALLS);
+    });
+}
+
+/**
+ * @brief A training loop over the pong_env C API: step 4096 environments with random actions and
+ * read their observations, per environment step.
+ */
+static void benchEnv(BenchRunner& runner)
+{
+    static const uint32_t ENVS = 4096;
+    static const int STEPS = 16;
+
+    PongEnv* env = pong_env_create(ENVS);
+    std::vector<int8_t> actions(2 * ENVS);
+    std::vector<float> rewards(ENVS);
+    std::vector<uint8_t> dones(ENVS);
+    std::vector<float> observations(ENVS * PONG_ENV_OBSERVATION_SIZE);
+    std::mt19937 rng(1);
+
+    runner.run("env_step_" + std::to_string(ENVS), "env step", [&](Meter& meter) {
+        for (int8_t& action : actions)
+        {
+            action = static_cast<int8_t>(static_cast<int>(rng() % 3) - 1);
+        }
+        meter.start();
+        for (int i = 0; i < STEPS; i++)
+        {
+            pong_env_step(env, actions.data(), rewards.data(), dones.data());
+            pong_env_observe(env, observations.data());
+        }
+        meter.stop(static_cast<uint64_t>(STEPS) * ENVS);
+    });
+
+    pong_env_destroy(env);
+}
+
+static void printUsage()
+{
+    std::cerr << "Usage: pong_bench [--json PATH] [--filter TEXT] [--min-time MS]\n";
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc)
+            options.json_path = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc)
+            options.filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc)
+            options.min_time_ms = std::atof(argv[++i]);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    BenchRunner runner(options);
+    benchBoxes(runner);
+    benchBall(runner);
+    benchObstacles(runner);
+    benchSpawning(runner);
+    benchLevelLoad(runner);
+    benchPaddleAI(runner);
+    benchThreadPool(runner);
+    benchEnv(runner);
+    benchLevel(runner);
+
+    if (options.json_path.empty())
+    {
+        runner.writeJson(std::cout);
+        return 0;
+    }
+
+    std::ofstream file(options.json_path);
+    runner.writeJson(file);
+    if (!file)
+    {
+        std::cerr << "Cannot write " << options.json_path << "\n";
+        return 1;
+    }
+    return 0;
+}
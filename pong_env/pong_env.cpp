@@ -0,0 +1,250 @@
+#include "pong_env.h"
+#include "simulation.h"
+#include "threadpool.h"
+#include <vector>
+#include <memory>
+#include <new>
+#include <thread>
+
+// Game time after which a match is abandoned, as in pong_batch
+static const double MAX_MATCH_MINUTES = 30.0;
+
+// Below this many environments a step is shorter than handing it to the workers and back
+static const size_t MIN_PARALLEL_ENVS = 256;
+
+/**
+ * @struct PongEnv
+ * @brief The environments: one Simulation each, plus their match bookkeeping as parallel arrays.
+ */
+struct PongEnv
+{
+    uint32_t seed;
+    std::vector<Simulation> sims;
+    std::vector<uint64_t> match_ticks;  // Ticks played in the current match of each environment
+    std::vector<uint32_t> matches;      // Matches started by each environment
+    uint64_t max_ticks;
+    std::unique_ptr<ThreadPool> pool;   // None with a single thread
+};
+
+/**
+ * @brief Runs body(i) for every environment, spread over the workers if there are enough
+ * environments to pay for it.
+ */
+template <typename Body>
+static void forEachEnv(const PongEnv& env, const Body& body)
+{
+    if (!env.pool || env.sims.size() < MIN_PARALLEL_ENVS)
+    {
+        for (size_t i = 0; i < env.sims.size(); i++)
+        {
+            body(i);
+        }
+        return;
+    }
+    env.pool->parallelFor(env.sims.size(), body);
+}
+
+/**
+ * @brief Runs the body of an exported function and turns its exceptions into an error code, since
+ * none may cross the C boundary.
+ * @return PONG_ENV_OK, or a PONG_ENV_ERROR_* code.
+ */
+template <typename Body>
+static int guard(const Body& body)
+{
+    try
+    {
+        body();
+        return PONG_ENV_OK;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return PONG_ENV_ERROR_OUT_OF_MEMORY;
+    }
+    catch (...)
+    {
+        return PONG_ENV_ERROR_INTERNAL;
+    }
+}
+
+/**
+ * @brief Derives the seed of a match from the base seed, the environment and the match number,
+ * so neighbouring environments and matches are uncorrelated.
+ */
+static uint32_t matchSeed(uint32_t base_seed, uint32_t env_index, uint32_t match)
+{
+    uint64_t z = base_seed + 0x9E3779B97F4A7C15ull * ((static_cast<uint64_t>(match) << 32 | env_index) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<uint32_t>(z ^ (z >> 31));
+}
+
+/**
+ * @brief Starts the next match of an environment: reseeds it and loads Level 1 with fresh scores,
+ * as the game does when a match starts.
+ */
+static void startMatch(PongEnv& env, uint32_t i)
+{
+    Simulation& sim = env.sims[i];
+    sim.seed(matchSeed(env.seed, i, env.matches[i]++));
+    sim.resetScores();
+    sim.loadLevel(1);
+    sim.clearEvents();
+    env.match_ticks[i] = 0;
+}
+
+/**
+ * @brief Converts an action to the input of one paddle.
+ */
+static PaddleInput toInput(int8_t action)
+{
+    PaddleInput input;
+    input.up = action == PONG_ENV_ACTION_UP;
+    input.down = action == PONG_ENV_ACTION_DOWN;
+    return input;
+}
+
+/**
+ * @brief Advances one environment by a tick, applying the level progression rules of runMatch().
+ * @return True if its match is over.
+ */
+static bool stepEnv(PongEnv& env, uint32_t i, const int8_t* actions, float& reward)
+{
+    Simulation& sim = env.sims[i];
+
+    SimInput input;
+    input.player1 = toInput(actions[2 * i]);
+    input.player2 = toInput(actions[2 * i + 1]);
+
+    sim.clearEvents();
+    sim.tick(input);
+    env.match_ticks[i]++;
+
+    // Points come from goals and from broken obstacles
+    reward = 0.0f;
+    for (const SimEvent& event : sim.getEvents())
+    {
+        if (event.type == SimEventType::SCORED || (event.type == SimEventType::OBSTACLE_BROKEN && event.player != 0))
+            reward += (event.player == 1) ? 1.0f : -1.0f;
+    }
+
+    if (env.match_ticks[i] >= env.max_ticks)
+        return true;
+    if (!sim.isLevelOver())
+        return false;
+
+    int next_level = sim.resolveLevelEnd();
+    if (next_level == 0)
+        return true;
+    sim.loadLevel(next_level);
+    return false;
+}
+
+/**
+ * @brief Writes the observation row of one environment.
+ */
+static void observeEnv(const Simulation& sim, float* out)
+{
+    const SimBall& ball = sim.getBall();
+    out[0] = ball.x;
+    out[1] = ball.y;
+    out[2] = ball.speed_x;
+    out[3] = ball.speed_y;
+    out[4] = ball.width;
+    out[5] = ball.height;
+    out[6] = sim.getPaddle(1).y;
+    out[7] = sim.getPaddle(2).y;
+    out[8] = static_cast<float>(sim.getScore(1));
+    out[9] = static_cast<float>(sim.getScore(2));
+    out[10] = static_cast<float>(sim.getLevelNumber());
+    out[11] = sim.getLevelTimer() / 10.0f;
+    out[12] = ball.powerup_active ? 1.0f : 0.0f;
+    out[13] = static_cast<float>(sim.getObstacles().size()); // Broken ones are compacted away by every tick
+}
+
+PongEnv* pong_env_create(uint32_t num_envs)
+{
+    return pong_env_create_seeded(num_envs, 1, 0);
+}
+
+PongEnv* pong_env_create_seeded(uint32_t num_envs, uint32_t seed, uint32_t threads)
+{
+    if (num_envs == 0)
+        return nullptr;
+
+    std::unique_ptr<PongEnv> env;
+    int result = guard([&]()
+    {
+        env.reset(new PongEnv());
+        env->seed = seed;
+        env->sims.reserve(num_envs);
+        for (uint32_t i = 0; i < num_envs; i++)
+        {
+            env->sims.emplace_back(seed);
+        }
+        env->match_ticks.assign(num_envs, 0);
+        env->matches.assign(num_envs, 0);
+        env->max_ticks = static_cast<uint64_t>(MAX_MATCH_MINUTES * 60.0 * env->sims.front().getConfig().tick_rate);
+        unsigned workers = threads ? threads : std::thread::hardware_concurrency();
+        if (workers > 1)
+            env->pool.reset(new ThreadPool(workers));
+    });
+    if (result != PONG_ENV_OK || pong_env_reset(env.get()) != PONG_ENV_OK)
+        return nullptr;
+    return env.release();
+}
+
+void pong_env_destroy(PongEnv* env)
+{
+    guard([env]()
+    {
+        delete env;
+    });
+}
+
+uint32_t pong_env_count(const PongEnv* env)
+{
+    return static_cast<uint32_t>(env->sims.size());
+}
+
+int pong_env_reset(PongEnv* env)
+{
+    return guard([env]()
+    {
+        forEachEnv(*env, [env](size_t i)
+        {
+            startMatch(*env, static_cast<uint32_t>(i));
+        });
+    });
+}
+
+int pong_env_step(PongEnv* env, const int8_t* actions, float* rewards, uint8_t* dones)
+{
+    return guard([env, actions, rewards, dones]()
+    {
+        forEachEnv(*env, [env, actions, rewards, dones](size_t index)
+        {
+            uint32_t i = static_cast<uint32_t>(index);
+            float reward;
+            bool done = stepEnv(*env, i, actions, reward);
+            if (done)
+                startMatch(*env, i);
+
+            if (rewards)
+                rewards[i] = reward;
+            if (dones)
+                dones[i] = done ? 1 : 0;
+        });
+    });
+}
+
+int pong_env_observe(const PongEnv* env, float* out)
+{
+    return guard([env, out]()
+    {
+        forEachEnv(*env, [env, out](size_t i)
+        {
+            observeEnv(env->sims[i], out + i * PONG_ENV_OBSERVATION_SIZE);
+        });
+    });
+}
@@ -0,0 +1,108 @@
+/*
+ * pong_env: C API stepping many independent matches in lockstep, for training paddle policies
+ * against the game rules without a window. Each environment is a Simulation playing full matches
+ * (Levels 1-3, then Sudden Death on a tie) and starting a new one when a match ends.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(PONG_ENV_EXPORTS)
+#define PONG_ENV_API __declspec(dllexport)
+#elif defined(_WIN32) && !defined(PONG_ENV_STATIC)
+#define PONG_ENV_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define PONG_ENV_API __attribute__((visibility("default")))
+#else
+#define PONG_ENV_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Floats written per environment by pong_env_observe(), in this order:
+ *
+ *   0  ball x          5  ball height          10  level number
+ *   1  ball y          6  Player 1 paddle y    11  level time left in seconds (0: no limit)
+ *   2  ball speed x    7  Player 2 paddle y    12  1 while a powerup affects the ball, else 0
+ *   3  ball speed y    8  Player 1 score       13  obstacles in play
+ *   4  ball width      9  Player 2 score
+ *
+ * Positions and sizes are in canvas units (900 x 900, y grows downwards), speeds in units per ms.
+ */
+#define PONG_ENV_OBSERVATION_SIZE 14
+
+/**
+ * @brief Paddle actions, two per environment: Player 1 first, then Player 2.
+ */
+#define PONG_ENV_ACTION_UP (-1)
+#define PONG_ENV_ACTION_STAY 0
+#define PONG_ENV_ACTION_DOWN 1
+
+/**
+ * @brief Results of pong_env_reset(), pong_env_step() and pong_env_observe(). After an error the
+ * environments may be partly stepped; reset them before going on.
+ */
+#define PONG_ENV_OK 0
+#define PONG_ENV_ERROR_OUT_OF_MEMORY (-1)
+#define PONG_ENV_ERROR_INTERNAL (-2)
+
+typedef struct PongEnv PongEnv;
+
+/**
+ * @brief Creates num_envs environments seeded from 1, stepped on one thread per hardware thread.
+ * @return The environments, or NULL if num_envs is 0 or they could not be created.
+ */
+PONG_ENV_API PongEnv* pong_env_create(uint32_t num_envs);
+
+/**
+ * @brief Creates environments with a base seed and a number of worker threads.
+ * @param num_envs Number of environments.
+ * @param seed Base seed; every match of every environment gets a seed derived from it.
+ * @param threads Worker threads, or 0 for one per hardware thread.
+ * @return The environments, or NULL if num_envs is 0 or they could not be created.
+ */
+PONG_ENV_API PongEnv* pong_env_create_seeded(uint32_t num_envs, uint32_t seed, uint32_t threads);
+
+/**
+ * @brief Destroys the environments. Does nothing for NULL.
+ */
+PONG_ENV_API void pong_env_destroy(PongEnv* env);
+
+/**
+ * @brief Number of environments.
+ */
+PONG_ENV_API uint32_t pong_env_count(const PongEnv* env);
+
+/**
+ * @brief Starts a new match in every environment.
+ * @return PONG_ENV_OK, or a PONG_ENV_ERROR_* code.
+ */
+PONG_ENV_API int pong_env_reset(PongEnv* env);
+
+/**
+ * @brief Advances every environment by one simulation tick.
+ *
+ * An environment whose match ended in this tick, or hit the tick limit of 30 minutes of game
+ * time, reports done and starts a new match at once: its next observation is the first of the
+ * new match.
+ *
+ * @param actions 2 * count actions: Player 1 and Player 2 of environment 0, then of environment 1...
+ * @param rewards Optional, count floats: the points Player 1 won minus the points Player 2 won.
+ * @param dones Optional, count bytes: 1 if the match ended, else 0.
+ * @return PONG_ENV_OK, or a PONG_ENV_ERROR_* code.
+ */
+PONG_ENV_API int pong_env_step(PongEnv* env, const int8_t* actions, float* rewards, uint8_t* dones);
+
+/**
+ * @brief Writes the observations of every environment into a buffer of
+ * count * PONG_ENV_OBSERVATION_SIZE floats, one row per environment.
+ * @return PONG_ENV_OK, or a PONG_ENV_ERROR_* code.
+ */
+PONG_ENV_API int pong_env_observe(const PongEnv* env, float* out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+// Test runner of pong_tests (gameplay core) and pong_game_tests (game code on the headless SGG
+// backend), run by ctest
+//
+// Usage: pong_tests [TEXT]   runs the tests whose name contains TEXT, or all of them
+#include "test.h"
+#include <iostream>
+#include <string>
+
+// Failed checks of the running test
+static int s_failures = 0;
+
+std::vector<TestCase>& getTestCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void reportFailure(const char* file, int line, const char* expression)
+{
+    std::cerr << file << ":" << line << ": check failed: " << expression << "\n";
+    s_failures++;
+}
+
+int main(int argc, char** argv)
+{
+    std::string filter = (argc > 1) ? argv[1] : "";
+
+    int run = 0;
+    int failed = 0;
+    for (const TestCase& test : getTestCases())
+    {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos)
+            continue;
+
+        s_failures = 0;
+        test.run();
+        run++;
+        if (s_failures > 0)
+            failed++;
+        std::cout << (s_failures > 0 ? "[FAIL] " : "[ OK ] ") << test.name << "\n";
+    }
+
+    std::cout << run - failed << " of " << run << " tests passed\n";
+    return (failed > 0 || run == 0) ? 1 : 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @struct TestCase
+ * @brief A named test function, registered by TEST_CASE.
+ */
+struct TestCase
+{
+    const char* name;
+    void (*run)();
+};
+
+/**
+ * @brief Retrieves every registered test, in registration order.
+ */
+std::vector<TestCase>& getTestCases();
+
+/**
+ * @brief Records a failed check of the running test. The test goes on, so one run reports every
+ * failed check.
+ */
+void reportFailure(const char* file, int line, const char* expression);
+
+/**
+ * @struct TestRegistrar
+ * @brief Registers a test when a test file is loaded.
+ */
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, void (*run)()) { getTestCases().push_back(TestCase{ name, run }); }
+};
+
+/**
+ * @brief Defines and registers a test: TEST_CASE(name) { ...checks... }
+ */
+#define TEST_CASE(name) \
+    static void name(); \
+    static TestRegistrar name##_registrar(#name, name); \
+    static void name()
+
+/**
+ * @brief Fails the running test if an expression is false.
+ */
+#define CHECK(expression) \
+    do { if (!(expression)) reportFailure(__FILE__, __LINE__, #expression); } while (0)
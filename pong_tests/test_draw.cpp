@@ -0,0 +1,81 @@
+#include "test.h"
+#include "gamestate.h"
+#include "drawlist.h"
+#include "alloccounter.h"
+#include "logger.h"
+#include <sgg/graphics.h>
+#include <iostream>
+
+/**
+ * @struct DrawAllocations
+ * @brief Heap allocations of the draw paths over the gameplay frames of a run.
+ */
+struct DrawAllocations
+{
+    DrawList list;
+    bool playing = false;       // The last recorded frame is a gameplay frame
+    uint64_t frames = 0;
+    uint64_t commands = 0;
+    uint64_t recording = 0;     // Allocations while recording the frames
+    uint64_t submitting = 0;    // Allocations while submitting them
+};
+
+// Runs the game on the headless backend; PONG_HEADLESS_SCRIPT must start matches (e.g. soak.txt)
+TEST_CASE(gameplay_frame_draw_does_not_allocate)
+{
+    if (!AllocCounter::isEnabled())
+    {
+        std::cout << "Allocation counting is compiled out; nothing to check.\n";
+        return;
+    }
+
+    Logger::getInstance().start();
+    graphics::createWindow(900, 900, "pong_game_tests");
+    graphics::setCanvasScaleMode(graphics::CANVAS_SCALE_WINDOW);
+    GameState::getInstance()->init();
+
+    // Records every frame into a list of its own, as GameState::update does, and submits it from
+    // the draw callback. Menu frames warm the list up like in the game (the first text sets the
+    // font); only the gameplay frames are counted.
+    static DrawAllocations counts;
+    graphics::setUpdateFunction([](float dt)
+    {
+        GameState::getInstance()->update(dt);
+        const Level* level = GameState::getInstance()->getCurrentLevel();
+        if (!level)
+            return;
+
+        uint64_t before = AllocCounter::getThreadAllocations();
+        counts.list.begin();
+        level->draw(counts.list);
+        counts.list.end();
+        counts.playing = level->isPlaying();
+        if (counts.playing)
+        {
+            counts.recording += AllocCounter::getThreadAllocations() - before;
+            counts.commands += counts.list.getStats().commands;
+        }
+    });
+    graphics::setDrawFunction([]()
+    {
+        uint64_t before = AllocCounter::getThreadAllocations();
+        counts.list.submit();
+        if (counts.playing)
+        {
+            counts.submitting += AllocCounter::getThreadAllocations() - before;
+            counts.frames++;
+        }
+    });
+    graphics::startMessageLoop();
+
+    GameState::getInstance()->releaseInstance();
+    graphics::destroyWindow();
+    Logger::getInstance().stop();
+
+    std::cout << counts.frames << " gameplay frames, " << counts.commands << " draw commands, "
+        << counts.recording << " allocations recording, " << counts.submitting << " submitting\n";
+    CHECK(counts.frames > 1000);
+    CHECK(counts.commands > counts.frames);
+    CHECK(counts.recording == 0);
+    CHECK(counts.submitting == 0);
+}
@@ -0,0 +1,140 @@
+#include "test.h"
+#include "entitystore.h"
+#include "spatialgrid.h"
+#include "config.h"
+#include <algorithm>
+
+TEST_CASE(entity_slots_resolve_handles_across_swap_remove)
+{
+    EntitySlots slots;
+    EntityHandle a = slots.add();
+    EntityHandle b = slots.add();
+    EntityHandle c = slots.add();
+    CHECK(slots.find(a) == 0 && slots.find(b) == 1 && slots.find(c) == 2);
+
+    // c moves into the place of a; a goes stale
+    slots.swapRemove(0);
+    CHECK(slots.find(a) == -1);
+    CHECK(slots.find(b) == 1);
+    CHECK(slots.find(c) == 0);
+
+    // The freed slot is reused under a new generation, so a stays stale
+    EntityHandle d = slots.add();
+    CHECK(getEntitySlot(d) == getEntitySlot(a));
+    CHECK(d != a);
+    CHECK(slots.find(d) == 2);
+    CHECK(slots.find(a) == -1);
+
+    // Removing the last entity moves nothing
+    slots.swapRemove(2);
+    CHECK(slots.find(d) == -1);
+    CHECK(slots.find(b) == 1 && slots.find(c) == 0);
+}
+
+TEST_CASE(entity_slots_clear_makes_every_handle_stale)
+{
+    EntitySlots slots;
+    EntityHandle a = slots.add();
+    EntityHandle b = slots.add();
+    slots.clear();
+    CHECK(slots.find(a) == -1 && slots.find(b) == -1);
+
+    EntityHandle c = slots.add();
+    CHECK(c != a && c != b);
+    CHECK(slots.find(c) == 0);
+    CHECK(slots.find(NO_ENTITY) == -1);
+}
+
+TEST_CASE(obstacle_store_compaction_keeps_handles)
+{
+    ObstacleStore store;
+    EntityHandle handles[5];
+    for (int i = 0; i < 5; i++)
+    {
+        handles[i] = store.add(Obstacle::Type::Breakable, 100.0f * i, 50.0f, 20.0f, 60.0f, i + 1, 0.0f);
+    }
+
+    store.remove(1);
+    store.remove(4);
+    CHECK(store.counts.pending == 2);
+    CHECK(store.size() == 5);
+
+    // The same moves a compaction does: the last obstacle fills each gap
+    store.swapRemove(4);
+    store.swapRemove(1);
+    CHECK(store.size() == 3);
+    CHECK(store.counts.pending == 0);
+    CHECK(store.counts.removed == 2);
+
+    CHECK(store.find(handles[1]) == -1);
+    CHECK(store.find(handles[4]) == -1);
+    for (int i : { 0, 2, 3 })
+    {
+        int index = store.find(handles[i]);
+        CHECK(index >= 0 && index < 3);
+        if (index >= 0)
+        {
+            // Every field moved with the handle
+            CHECK(store.x[index] == 100.0f * i);
+            CHECK(store.hit_points[index] == i + 1);
+            CHECK(store.active[index] == 1);
+        }
+    }
+}
+
+TEST_CASE(compaction_keeps_grid_ids_within_store)
+{
+    // Every set of obstacles broken in one tick, including the tail and neighbours of each other
+    const uint32_t count = 6;
+    for (uint32_t broken = 1; broken < (1u << count); broken++)
+    {
+        ObstacleStore store;
+        SpatialGrid grid;
+        EntityHandle handles[count];
+        for (uint32_t i = 0; i < count; i++)
+        {
+            float x = 100.0f + 120.0f * i;
+            handles[i] = store.add(Obstacle::Type::Breakable, x, 300.0f, 20.0f, 60.0f, 1, 0.0f);
+            grid.insert(i, Box(x, 300.0f, 20.0f, 60.0f));
+        }
+
+        // As the simulation breaks an obstacle: it leaves the grid at once, the store at compaction
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (broken & (1u << i))
+            {
+                grid.remove(i);
+                store.remove(i);
+            }
+        }
+        compactStore(store, grid);
+        CHECK(store.counts.pending == 0);
+
+        std::vector<uint32_t> ids;
+        grid.query(Box(CANVAS_WIDTH / 2.0f, CANVAS_HEIGHT / 2.0f, 2.0f * CANVAS_WIDTH, 2.0f * CANVAS_HEIGHT), ids);
+        CHECK(ids.size() == store.size());
+        for (uint32_t id : ids)
+        {
+            CHECK(id < store.size());
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            CHECK(grid.contains(i) == (i < store.size()));
+        }
+
+        // Each survivor is registered under its new index, with its own box
+        for (uint32_t i = 0; i < count; i++)
+        {
+            int index = store.find(handles[i]);
+            CHECK((index >= 0) == ((broken & (1u << i)) == 0));
+            if (index < 0)
+                continue;
+            CHECK(store.active[index] == 1);
+            CHECK(store.x[index] == 100.0f + 120.0f * i);
+
+            ids.clear();
+            grid.query(Box(store.x[index], store.y[index], 1.0f, 1.0f), ids);
+            CHECK(std::find(ids.begin(), ids.end(), static_cast<uint32_t>(index)) != ids.end());
+        }
+    }
+}
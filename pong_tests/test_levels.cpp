@@ -0,0 +1,176 @@
+#include "test.h"
+#include "leveldef.h"
+#include <cstring>
+#include <string>
+
+// A level using every statement of the text format
+static const char TEST_LEVELS[] =
+    "# Test level\n"
+    "level 7\n"
+    "time_limit 45.5\n"
+    "reset_scores\n"
+    "sudden_death\n"
+    "win_score 5\n"
+    "next_level 0\n"
+    "tie_level 7\n"
+    "music test.mp3\n"
+    "obstacle breakable 450 700 3 0\n"
+    "obstacle unbreakable 350 300 0 0.25\n"
+    "powerup_schedule 4 1.5 2.5\n"
+    "powerup speed_up 300 300\n"
+    "powerup decrease_size 600 200\n"
+    "spawn obstacle breakable hit_points=2 speed=0.5 limit=3 total=4 first=2 interval=1,3 area=250,200,650,650\n"
+    "spawn powerup types=slow_down,increase_size limit=5 first=3 interval=2,5 area=200,200,700,700 min_distance=90\n";
+
+/**
+ * @brief Checks that two level sets hold the same levels, field by field.
+ */
+static void checkSameLevels(const LevelSet& a, const LevelSet& b)
+{
+    CHECK(a.getLevels().size() == b.getLevels().size());
+    if (a.getLevels().size() != b.getLevels().size())
+        return;
+
+    for (size_t i = 0; i < a.getLevels().size(); i++)
+    {
+        const LevelDef& x = a.getLevels()[i];
+        const LevelDef& y = b.getLevels()[i];
+        CHECK(x.number == y.number);
+        CHECK(x.time_limit == y.time_limit);
+        CHECK(x.reset_scores == y.reset_scores);
+        CHECK(x.sudden_death == y.sudden_death);
+        CHECK(x.win_score == y.win_score);
+        CHECK(x.next_level == y.next_level);
+        CHECK(x.tie_level == y.tie_level);
+        CHECK(x.music == y.music);
+        CHECK(x.obstacle_type == y.obstacle_type);
+        CHECK(x.obstacle_x == y.obstacle_x);
+        CHECK(x.obstacle_y == y.obstacle_y);
+        CHECK(x.obstacle_hit_points == y.obstacle_hit_points);
+        CHECK(x.obstacle_speed == y.obstacle_speed);
+        CHECK(x.powerup_first_time == y.powerup_first_time);
+        CHECK(x.powerup_interval_min == y.powerup_interval_min);
+        CHECK(x.powerup_interval_max == y.powerup_interval_max);
+        CHECK(x.powerup_type == y.powerup_type);
+        CHECK(x.powerup_x == y.powerup_x);
+        CHECK(x.powerup_y == y.powerup_y);
+        CHECK(x.spawners.size() == y.spawners.size());
+        for (size_t s = 0; s < x.spawners.size() && s < y.spawners.size(); s++)
+        {
+            const LevelSpawner& p = x.spawners[s];
+            const LevelSpawner& q = y.spawners[s];
+            CHECK(p.kind == q.kind);
+            CHECK(p.obstacle_type == q.obstacle_type);
+            CHECK(p.hit_points == q.hit_points);
+            CHECK(p.speed == q.speed);
+            CHECK(p.powerup_types == q.powerup_types);
+            CHECK(p.limit == q.limit);
+            CHECK(p.total_limit == q.total_limit);
+            CHECK(p.first_time == q.first_time);
+            CHECK(p.interval_min == q.interval_min);
+            CHECK(p.interval_max == q.interval_max);
+            CHECK(p.min_x == q.min_x && p.min_y == q.min_y && p.max_x == q.max_x && p.max_y == q.max_y);
+            CHECK(p.min_distance == q.min_distance);
+        }
+    }
+}
+
+TEST_CASE(level_text_parses_every_statement)
+{
+    LevelSet levels;
+    std::string error;
+    CHECK(levels.parse(TEST_LEVELS, sizeof(TEST_LEVELS) - 1, error));
+    CHECK(error.empty());
+
+    const LevelDef* level = levels.find(7);
+    CHECK(level != nullptr);
+    if (!level)
+        return;
+    CHECK(level->time_limit == 45.5f);
+    CHECK(level->reset_scores && level->sudden_death);
+    CHECK(level->win_score == 5 && level->tie_level == 7);
+    CHECK(level->music == "test.mp3");
+    CHECK(level->obstacle_x.size() == 2);
+    CHECK(level->obstacle_speed.size() == 2 && level->obstacle_speed[1] == 0.25f);
+    CHECK(level->powerup_type.size() == 2);
+    CHECK(level->spawners.size() == 2);
+    if (level->spawners.size() == 2)
+    {
+        CHECK(level->spawners[0].kind == LevelSpawner::Kind::OBSTACLE);
+        CHECK(level->spawners[0].total_limit == 4);
+        CHECK(level->spawners[1].kind == LevelSpawner::Kind::POWERUP);
+        CHECK(level->spawners[1].powerup_types.size() == 2);
+        CHECK(level->spawners[1].min_distance == 90.0f);
+    }
+    CHECK(levels.find(1) == nullptr);
+}
+
+TEST_CASE(level_text_binary_load_round_trip)
+{
+    const LevelSet* sources[2];
+    LevelSet test_levels;
+    std::string error;
+    CHECK(test_levels.parse(TEST_LEVELS, sizeof(TEST_LEVELS) - 1, error));
+    sources[0] = &LevelSet::getDefault();
+    sources[1] = &test_levels;
+
+    for (const LevelSet* source : sources)
+    {
+        std::vector<uint8_t> binary = source->save();
+        LevelSet loaded;
+        CHECK(loaded.load(binary.data(), binary.size(), error));
+        checkSameLevels(*source, loaded);
+
+        // Compiling the loaded set gives back the same bytes
+        CHECK(loaded.save() == binary);
+    }
+}
+
+TEST_CASE(level_text_reports_error_line)
+{
+    const char text[] =
+        "level 1\n"
+        "time_limit 30\n"
+        "obstacle wobbly 450 700 2 0\n";
+
+    LevelSet levels;
+    std::string error;
+    CHECK(!levels.parse(text, sizeof(text) - 1, error));
+    CHECK(error.compare(0, 7, "line 3:") == 0);
+    CHECK(levels.getLevels().empty());
+}
+
+TEST_CASE(level_binary_rejects_corrupt_data)
+{
+    std::vector<uint8_t> binary = LevelSet::getDefault().save();
+    LevelSet levels;
+    std::string error;
+
+    std::vector<uint8_t> truncated(binary.begin(), binary.begin() + binary.size() / 2);
+    CHECK(!levels.load(truncated.data(), truncated.size(), error));
+
+    std::vector<uint8_t> wrong_magic = binary;
+    wrong_magic[0] ^= 0xFF;
+    CHECK(!levels.load(wrong_magic.data(), wrong_magic.size(), error));
+    CHECK(levels.getLevels().empty());
+}
+
+TEST_CASE(level_set_hash_follows_the_levels)
+{
+    LevelSet text;
+    std::string error;
+    CHECK(text.parse(TEST_LEVELS, sizeof(TEST_LEVELS) - 1, error));
+
+    // Text and compiled forms of the same levels hash equal; other levels do not
+    std::vector<uint8_t> binary = text.save();
+    LevelSet compiled;
+    CHECK(compiled.load(binary.data(), binary.size(), error));
+    CHECK(compiled.getHash() == text.getHash());
+    CHECK(text.getHash() != LevelSet::getDefault().getHash());
+
+    std::string changed(TEST_LEVELS);
+    changed.replace(changed.find("45.5"), 4, "45.6");
+    LevelSet other;
+    CHECK(other.parse(changed.data(), changed.size(), error));
+    CHECK(other.getHash() != text.getHash());
+}
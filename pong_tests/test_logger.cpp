@@ -0,0 +1,61 @@
+#include "test.h"
+#include "logger.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Threads keep logging while the logger stops: every message is written or counted as dropped
+TEST_CASE(logger_stop_loses_no_message_silently)
+{
+    const int THREADS = 4;
+    const int MESSAGES = 20000;
+
+    std::ostringstream output;
+    std::streambuf* console = std::cout.rdbuf(output.rdbuf());
+
+    for (int round = 0; round < 5; round++)
+    {
+        output.str("");
+        Logger& logger = Logger::getInstance();
+        uint64_t dropped_before = logger.getDroppedCount();
+        logger.start();
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back([t]()
+            {
+                for (int i = 0; i < MESSAGES; i++)
+                {
+                    Logger::getInstance().write(LogLevel::Info, "logger test {} {}", t, i);
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        logger.stop();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // Written lines, plus the drops the logger reported
+        std::istringstream lines(output.str());
+        std::string line;
+        uint64_t written = 0;
+        uint64_t reported = 0;
+        while (std::getline(lines, line))
+        {
+            if (line.find("logger test ") != std::string::npos)
+                written++;
+            else if (line.compare(0, 9, "[logger] ") == 0)
+                reported += std::stoull(line.substr(9));
+        }
+        uint64_t dropped = logger.getDroppedCount() - dropped_before;
+        CHECK(reported == dropped);
+        CHECK(written + dropped == static_cast<uint64_t>(THREADS) * MESSAGES);
+    }
+
+    std::cout.rdbuf(console);
+}
@@ -0,0 +1,106 @@
+#include "test.h"
+#include "paddleai.h"
+#include "simulation.h"
+#include <cmath>
+
+TEST_CASE(predict_ball_y_folds_wall_bounces)
+{
+    // Ball of height 100: the center moves between 50 and 850, a span of 800
+    CHECK(predictBallY(0.0f, 450.0f, 1.0f, 0.0f, 100.0f, 300.0f) == 450.0f);
+    CHECK(predictBallY(0.0f, 450.0f, 1.0f, 1.0f, 100.0f, 300.0f) == 750.0f);
+    // One bounce off the bottom wall: 450 + 500 = 950, 100 past 850
+    CHECK(predictBallY(0.0f, 450.0f, 1.0f, 1.0f, 100.0f, 500.0f) == 750.0f);
+    // Off the top wall, moving left
+    CHECK(predictBallY(800.0f, 450.0f, -1.0f, -1.0f, 100.0f, 300.0f) == 150.0f);
+    // Two bounces: 450 + 1700 = 2150 unrolled, a full period of 1600 plus 100
+    CHECK(predictBallY(0.0f, 450.0f, 1.0f, 1.0f, 100.0f, 1700.0f) == 550.0f);
+    // A line behind the ball is reached at once
+    CHECK(predictBallY(500.0f, 300.0f, 1.0f, 1.0f, 100.0f, 100.0f) == 300.0f);
+}
+
+TEST_CASE(predict_ball_y_matches_stepped_simulation)
+{
+    const SimInput no_input;
+    int compared = 0;
+
+    for (uint32_t seed = 1; seed <= 200; seed++)
+    {
+        // Level 1 has no obstacles or powerups: only the walls and paddles deflect the ball
+        Simulation sim(seed);
+        sim.loadLevel(1);
+        const SimBall& ball = sim.getBall();
+
+        // During the serve ramp-up the speed grows but the direction stays that of the target speed
+        const float start_x = ball.x;
+        const float start_y = ball.y;
+        const float speed_x = ball.target_speed_x;
+        const float speed_y = ball.target_speed_y;
+        const float height = ball.height;
+
+        const SimPaddle& paddle = sim.getPaddle(speed_x > 0.0f ? 2 : 1);
+        const float face_x = paddle.x - (speed_x > 0.0f ? 1.0f : -1.0f) * (paddle.width + ball.width) / 2.0f;
+
+        bool done = false;
+        while (!done && sim.getTick() < 10000)
+        {
+            sim.clearEvents();
+            sim.tick(no_input);
+            for (const SimEvent& event : sim.getEvents())
+            {
+                if (event.type == SimEventType::PADDLE_HIT || event.type == SimEventType::SCORED)
+                    done = true;
+            }
+            if (done || (ball.x - face_x) * speed_x > 0.0f)
+                break;
+
+            // Every position along the flight lies on the predicted path
+            float predicted = predictBallY(start_x, start_y, speed_x, speed_y, height, ball.x);
+            CHECK(std::fabs(predicted - ball.y) < 1.0f);
+            compared++;
+        }
+    }
+    CHECK(compared > 10000);
+}
+
+TEST_CASE(paddle_ai_without_delay_or_error_returns_serves)
+{
+    PaddleAIConfig config;
+    config.reaction_ms = 0.0f;
+    config.max_error = 0.0f;
+
+    int returned = 0;
+    int missed = 0;
+    for (uint32_t seed = 1; seed <= 50; seed++)
+    {
+        Simulation sim(seed);
+        sim.loadLevel(1);
+        PaddleAI ai1(seed, config);
+        PaddleAI ai2(seed + 1000, config);
+
+        // Play until the first point or the first return of each side
+        bool done = false;
+        while (!done && sim.getTick() < 20000)
+        {
+            SimInput input;
+            input.player1 = ai1.getInput(sim, 1, sim.getTickMs());
+            input.player2 = ai2.getInput(sim, 2, sim.getTickMs());
+            sim.clearEvents();
+            sim.tick(input);
+            for (const SimEvent& event : sim.getEvents())
+            {
+                if (event.type == SimEventType::PADDLE_HIT)
+                {
+                    returned++;
+                    done = true;
+                }
+                else if (event.type == SimEventType::SCORED)
+                {
+                    missed++;
+                    done = true;
+                }
+            }
+        }
+    }
+    CHECK(returned == 50);
+    CHECK(missed == 0);
+}
@@ -0,0 +1,191 @@
+#include "test.h"
+#include "match.h"
+#include "replay.h"
+#include <cstdio>
+#include <string>
+
+// Game time after which the test matches are abandoned: 30 minutes at the default tick rate
+static const uint64_t MAX_TICKS = static_cast<uint64_t>(30 * 60 * SIM_TICK_RATE);
+
+TEST_CASE(replay_input_bits_round_trip)
+{
+    for (uint8_t bits = 0; bits < 16; bits++)
+    {
+        CHECK(encodeInput(decodeInput(bits)) == bits);
+    }
+}
+
+TEST_CASE(replay_reader_returns_recorded_entries)
+{
+    SimInput up;
+    up.player1.up = true;
+    SimInput down;
+    down.player2.down = true;
+
+    ReplayRecorder recorder;
+    recorder.begin(7, SimConfig(), LevelSet::getDefault());
+    recorder.recordLevelLoad(1);
+    recorder.record(up, 3);
+    recorder.record(up);
+    recorder.recordLevelLoad(2);
+    recorder.record(down, 2);
+    const Replay& replay = recorder.finish(0);
+    CHECK(replay.tick_count == 6);
+
+    ReplayReader reader(replay);
+    SimInput input;
+    int level_number;
+    CHECK(reader.next(input, level_number) && level_number == 1);
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(reader.next(input, level_number) && level_number == 0);
+        CHECK(encodeInput(input) == encodeInput(up));
+    }
+    CHECK(reader.next(input, level_number) && level_number == 2);
+    for (int i = 0; i < 2; i++)
+    {
+        CHECK(reader.next(input, level_number) && level_number == 0);
+        CHECK(encodeInput(input) == encodeInput(down));
+    }
+    CHECK(!reader.next(input, level_number));
+}
+
+TEST_CASE(replay_save_load_play_reproduces_match)
+{
+    const char* path = "pong_tests_replay.pongrec";
+
+    for (uint32_t seed = 1; seed <= 3; seed++)
+    {
+        ReplayRecorder recorder;
+        MatchResult result = runMatch(seed, SimConfig(), MAX_TICKS, &recorder);
+        const Replay& recorded = recorder.getReplay();
+        CHECK(recorded.tick_count == result.ticks);
+
+        CHECK(saveReplay(path, recorded));
+        Replay loaded;
+        CHECK(loadReplay(path, loaded));
+        CHECK(loaded.seed == recorded.seed);
+        CHECK(loaded.tick_count == recorded.tick_count);
+        CHECK(loaded.final_hash == recorded.final_hash);
+        CHECK(loaded.config.ball_speed == recorded.config.ball_speed);
+        CHECK(loaded.config.tick_rate == recorded.config.tick_rate);
+        CHECK(loaded.levels_hash == recorded.levels_hash);
+        CHECK(loaded.inputs == recorded.inputs);
+
+        Simulation sim;
+        CHECK(playReplay(loaded, LevelSet::getDefault(), sim));
+        CHECK(sim.getStateHash() == recorded.final_hash);
+        CHECK(sim.getWinner() == result.winner);
+    }
+    std::remove(path);
+}
+
+TEST_CASE(replay_with_other_input_diverges)
+{
+    ReplayRecorder recorder;
+    runMatch(4, SimConfig(), MAX_TICKS, &recorder);
+    const Replay& recorded = recorder.getReplay();
+
+    // Holding Player 1 up for the whole match plays a different match
+    SimInput up;
+    up.player1.up = true;
+    ReplayRecorder altered;
+    altered.begin(recorded.seed, recorded.config, LevelSet::getDefault());
+    altered.recordLevelLoad(1);
+    altered.record(up, static_cast<int>(recorded.tick_count));
+
+    Simulation sim;
+    CHECK(!playReplay(altered.finish(recorded.final_hash), LevelSet::getDefault(), sim));
+}
+
+TEST_CASE(replay_plays_back_only_with_its_levels)
+{
+    // One short level with an obstacle in the middle, replayed on a tie
+    const char text[] =
+        "level 1\n"
+        "time_limit 20\n"
+        "reset_scores\n"
+        "tie_level 1\n"
+        "obstacle unbreakable 450 450 0 0\n";
+    LevelSet levels;
+    std::string error;
+    CHECK(levels.parse(text, sizeof(text) - 1, error));
+
+    ReplayRecorder recorder;
+    MatchResult result = runMatch(5, SimConfig(), MAX_TICKS, &recorder, nullptr, &levels);
+    const Replay& recorded = recorder.getReplay();
+    CHECK(recorded.levels_hash == levels.getHash());
+    CHECK(recorded.levels_hash != LevelSet::getDefault().getHash());
+
+    // The same levels read again play the same match
+    LevelSet reread;
+    CHECK(reread.parse(text, sizeof(text) - 1, error));
+    Simulation sim;
+    CHECK(playReplay(recorded, reread, sim));
+    CHECK(sim.getWinner() == result.winner);
+
+    CHECK(!playReplay(recorded, LevelSet::getDefault(), sim));
+}
+
+TEST_CASE(replay_keeps_level_numbers_above_15)
+{
+    // Level numbers are free in level files; 16 and 17 must not wrap to 0 and 1
+    const char text[] =
+        "level 16\n"
+        "time_limit 10\n"
+        "reset_scores\n"
+        "next_level 17\n"
+        "level 17\n"
+        "time_limit 10\n"
+        "next_level 300\n"
+        "level 300\n"
+        "time_limit 10\n"
+        "tie_level 16\n";
+    LevelSet levels;
+    std::string error;
+    CHECK(levels.parse(text, sizeof(text) - 1, error));
+
+    const char* path = "pong_tests_levels.pongrec";
+    ReplayRecorder recorder;
+    MatchResult result = runMatch(6, SimConfig(), MAX_TICKS, &recorder, nullptr, &levels);
+    CHECK(saveReplay(path, recorder.getReplay()));
+    Replay loaded;
+    CHECK(loadReplay(path, loaded));
+    std::remove(path);
+
+    // Every level is read back with its own number
+    ReplayReader reader(loaded);
+    SimInput input;
+    int level_number;
+    bool loaded_level[3] = { false, false, false };
+    while (reader.next(input, level_number))
+    {
+        CHECK(level_number == 0 || level_number == 1 || levels.find(level_number) != nullptr);
+        loaded_level[0] |= level_number == 16;
+        loaded_level[1] |= level_number == 17;
+        loaded_level[2] |= level_number == 300;
+    }
+    CHECK(loaded_level[1] && loaded_level[2]);
+
+    Simulation sim;
+    CHECK(playReplay(loaded, levels, sim));
+    CHECK(sim.getStateHash() == loaded.final_hash);
+    CHECK(sim.getLevelNumber() == result.final_level);
+}
+
+TEST_CASE(replay_load_rejects_invalid_file)
+{
+    const char* path = "pong_tests_invalid.pongrec";
+    std::FILE* file = std::fopen(path, "wb");
+    CHECK(file != nullptr);
+    if (file)
+    {
+        std::fputs("not a replay", file);
+        std::fclose(file);
+    }
+
+    Replay replay;
+    CHECK(!loadReplay(path, replay));
+    CHECK(!loadReplay("pong_tests_missing.pongrec", replay));
+    std::remove(path);
+}
@@ -0,0 +1,51 @@
+#include "test.h"
+#include "simulation.h"
+#include <algorithm>
+#include <string>
+
+TEST_CASE(advance_bounds_the_ticks_of_a_stalled_frame)
+{
+    Simulation sim(1);
+    const int max_ticks = static_cast<int>(250.0f / sim.getTickMs()) + 1;
+
+    // A 10 s stall runs at most 250 ms of ticks, and the dropped time is not caught up later
+    int ticks = sim.advance(10000.0f, SimInput());
+    CHECK(ticks >= max_ticks - 2 && ticks <= max_ticks);
+    CHECK(sim.advance(0.0f, SimInput()) <= 1);
+}
+
+TEST_CASE(advance_events_fit_the_reserved_list)
+{
+    // Obstacles and powerups spawned on every tick around rows of obstacles that break at once
+    std::string text =
+        "level 1\n"
+        "spawn obstacle breakable hit_points=1 speed=0 limit=2000 first=0 interval=0,0 area=150,100,750,800\n"
+        "spawn obstacle unbreakable speed=0.5 limit=2000 first=0 interval=0,0 area=150,100,750,800\n"
+        "spawn powerup types=speed_up,slow_down,increase_size,decrease_size limit=2000 first=0 interval=0,0 area=150,100,750,800\n";
+    for (int i = 0; i < 400; i++)
+    {
+        text += "obstacle breakable " + std::to_string(200 + (i % 40) * 13) + " " + std::to_string(150 + (i / 40) * 60) + " 1 0\n";
+    }
+    LevelSet levels;
+    std::string error;
+    CHECK(levels.parse(text.data(), text.size(), error));
+
+    for (uint32_t seed = 1; seed <= 20; seed++)
+    {
+        Simulation sim(seed);
+        sim.setLevels(levels);
+        sim.reserveFrameEvents();
+        sim.loadLevel(1);
+        const size_t capacity = sim.getEvents().capacity();
+
+        // Every frame a stall, so each advance() runs the most ticks it may
+        size_t most_events = 0;
+        for (int frame = 0; frame < 40 && !sim.isLevelOver(); frame++)
+        {
+            sim.advance(1000.0f, SimInput());
+            most_events = std::max(most_events, sim.getEvents().size());
+            CHECK(sim.getEvents().capacity() == capacity);
+        }
+        CHECK(most_events > 100);
+    }
+}
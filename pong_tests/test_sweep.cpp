@@ -0,0 +1,137 @@
+#include "test.h"
+#include "box.h"
+#include "sweepbatch.h"
+#include "config.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST_CASE(box_sweep_head_on_hit)
+{
+    // 10-wide boxes 30 apart: they touch after 20 of the 40 units moved
+    Box ball(0.0f, 0.0f, 10.0f, 10.0f);
+    Box wall(30.0f, 0.0f, 10.0f, 10.0f);
+    float normal_x, normal_y;
+    float time = ball.sweep(wall, 40.0f, 0.0f, normal_x, normal_y);
+    CHECK(time == 0.5f);
+    CHECK(normal_x == -1.0f && normal_y == 0.0f);
+
+    time = ball.sweep(wall, 0.0f, 40.0f, normal_x, normal_y);
+    CHECK(time > 1.0f);
+}
+
+TEST_CASE(box_sweep_stops_tunneling)
+{
+    // The movement jumps over a thin box without ever overlapping it at either end
+    Box ball(0.0f, 450.0f, 15.0f, 15.0f);
+    Box thin(100.0f, 450.0f, 2.0f, 80.0f);
+    float normal_x, normal_y;
+    float time = ball.sweep(thin, 200.0f, 0.0f, normal_x, normal_y);
+    CHECK(time > 0.0f && time < 1.0f);
+    CHECK(normal_x == -1.0f);
+
+    Box after(200.0f, 450.0f, 15.0f, 15.0f);
+    CHECK(!after.intersect(thin));
+}
+
+TEST_CASE(box_sweep_overlap_pushes_out_along_least_penetration)
+{
+    Box ball(0.0f, 8.0f, 10.0f, 10.0f);
+    Box other(0.0f, 0.0f, 40.0f, 10.0f);
+    float normal_x, normal_y;
+    CHECK(ball.sweep(other, 1.0f, 1.0f, normal_x, normal_y) == 0.0f);
+    CHECK(normal_x == 0.0f && normal_y == 1.0f);
+}
+
+TEST_CASE(box_sweep_touching_counts_only_when_approaching)
+{
+    Box ball(0.0f, 0.0f, 10.0f, 10.0f);
+    Box other(10.0f, 0.0f, 10.0f, 10.0f);
+    float normal_x, normal_y;
+    CHECK(ball.sweep(other, 5.0f, 0.0f, normal_x, normal_y) == 0.0f);
+    CHECK(ball.sweep(other, -5.0f, 0.0f, normal_x, normal_y) > 1.0f);
+}
+
+TEST_CASE(sweep_batch_kernels_match_box_sweep)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos_x(0.0f, CANVAS_WIDTH);
+    std::uniform_real_distribution<float> pos_y(0.0f, CANVAS_HEIGHT);
+    std::uniform_real_distribution<float> size(2.0f, 120.0f);
+    std::uniform_real_distribution<float> move(-80.0f, 80.0f);
+
+    // 203 boxes: the vector kernels also run their scalar tail
+    const size_t count = 203;
+    std::vector<float> x, y, width, height;
+    std::vector<uint8_t> active;
+    for (size_t i = 0; i < count; i++)
+    {
+        x.push_back(pos_x(rng));
+        y.push_back(pos_y(rng));
+        width.push_back(size(rng));
+        height.push_back(size(rng));
+        active.push_back(i % 7 != 3 ? 1 : 0);
+    }
+
+    BoxBatch batch;
+    batch.x = x.data();
+    batch.y = y.data();
+    batch.width = width.data();
+    batch.height = height.data();
+    batch.active = active.data();
+    batch.count = count;
+
+    std::vector<float> times(count);
+    for (int query = 0; query < 500; query++)
+    {
+        Box ball(pos_x(rng), pos_y(rng), 15.0f, 15.0f);
+        float dx = (query % 11 == 0) ? 0.0f : move(rng);
+        float dy = (query % 13 == 0) ? 0.0f : move(rng);
+
+        for (int level = 0; level <= static_cast<int>(getSimdLevel()); level++)
+        {
+            sweepBatchTimes(ball, dx, dy, batch, times.data(), static_cast<SimdLevel>(level));
+            for (size_t i = 0; i < count; i++)
+            {
+                float normal_x, normal_y;
+                float expected = ball.sweep(Box(x[i], y[i], width[i], height[i]), dx, dy, normal_x, normal_y);
+                if (!active[i] || expected > 1.0f)
+                {
+                    CHECK(times[i] > 1.0f);
+                }
+                else
+                {
+                    // Bit for bit, so the instruction set never changes a replay
+                    CHECK(std::memcmp(&times[i], &expected, sizeof(float)) == 0);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(sweep_batch_orders_hits_by_time)
+{
+    float x[] = { 300.0f, 100.0f, 200.0f, 200.0f };
+    float y[] = { 0.0f, 0.0f, 0.0f, 100.0f };
+    float width[] = { 10.0f, 10.0f, 10.0f, 10.0f };
+    float height[] = { 10.0f, 10.0f, 10.0f, 10.0f };
+    uint8_t active[] = { 1, 1, 1, 1 };
+
+    BoxBatch batch;
+    batch.x = x;
+    batch.y = y;
+    batch.width = width;
+    batch.height = height;
+    batch.active = active;
+    batch.count = 4;
+
+    std::vector<float> times;
+    std::vector<SweepHit> hits;
+    sweepBatch(Box(0.0f, 0.0f, 10.0f, 10.0f), 400.0f, 0.0f, batch, times, hits);
+    CHECK(hits.size() == 3);
+    if (hits.size() == 3)
+    {
+        CHECK(hits[0].index == 1 && hits[1].index == 2 && hits[2].index == 0);
+        CHECK(hits[0].time < hits[1].time && hits[1].time < hits[2].time);
+    }
+}
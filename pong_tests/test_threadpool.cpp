@@ -0,0 +1,58 @@
+#include "test.h"
+#include "threadpool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE(parallel_for_runs_every_iteration_once)
+{
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> runs(1000);
+    for (int round = 0; round < 3; round++)
+    {
+        pool.parallelFor(runs.size(), [&runs](size_t i)
+        {
+            runs[i]++;
+        });
+    }
+
+    bool all_three = true;
+    for (const std::atomic<int>& count : runs)
+    {
+        all_three = all_three && count == 3;
+    }
+    CHECK(all_three);
+}
+
+TEST_CASE(parallel_for_rethrows_after_every_chunk_finished)
+{
+    ThreadPool pool(4);
+    std::atomic<int> finished{ 0 };
+    bool thrown = false;
+    try
+    {
+        pool.parallelFor(1000, [&finished](size_t i)
+        {
+            if (i == 500)
+                throw std::runtime_error("iteration 500");
+            finished++;
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+    // Only the rest of the throwing chunk is skipped, and nothing runs after parallelFor returned
+    int after_throw = finished;
+    CHECK(after_throw >= 1000 - 32 && after_throw < 1000);
+    CHECK(finished == after_throw);
+
+    // The error is reported once: the pool keeps working
+    finished = 0;
+    pool.parallelFor(1000, [&finished](size_t)
+    {
+        finished++;
+    });
+    CHECK(finished == 1000);
+}
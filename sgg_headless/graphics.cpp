@@ -0,0 +1,486 @@
+// sgg_headless: the SGG API without a window, for running the game on build machines
+//
+// Links in place of sgg.lib. startMessageLoop() calls the update and draw callbacks back to back
+// on a virtual clock, as fast as the CPU allows, with keyboard input replayed from a script. Draw
+// and audio calls are only counted. Configured through environment variables, so the game runs
+// unmodified:
+//
+//   PONG_HEADLESS_FRAMES    Frames to run (default 3600; 0 runs until the game exits)
+//   PONG_HEADLESS_FRAME_MS  Virtual duration of a frame in ms (default 16.667, 60 frames/s)
+//   PONG_HEADLESS_SCRIPT    Input script to replay (see parseScript)
+#include <sgg/graphics.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <dirent.h>
+
+namespace
+{
+    // Scancodes are SDL scancodes, all below SDL_NUM_SCANCODES
+    const int KEY_COUNT = 512;
+
+    /**
+     * @struct ScriptEvent
+     * @brief A key press or release of the input script.
+     */
+    struct ScriptEvent
+    {
+        uint64_t frame = 0;
+        int key = 0;
+        bool down = false;
+    };
+
+    /**
+     * @struct HeadlessStats
+     * @brief Calls counted while the message loop runs.
+     */
+    struct HeadlessStats
+    {
+        uint64_t frames = 0;
+        uint64_t rects = 0;
+        uint64_t disks = 0;
+        uint64_t texts = 0;
+        uint64_t other_draws = 0;   ///< Lines and sectors.
+        uint64_t sounds = 0;
+        uint64_t music = 0;
+    };
+
+    /**
+     * @struct HeadlessState
+     * @brief Everything a window would hold: callbacks, canvas, clock and input.
+     */
+    struct HeadlessState
+    {
+        std::function<void()> draw;
+        std::function<void(float)> update;
+        std::function<void(int, int)> resize;
+        const void* user_data = nullptr;
+
+        int window_width = 0;
+        int window_height = 0;
+        float canvas_width = 0.0f;
+        float canvas_height = 0.0f;
+        graphics::scale_mode_t scale_mode = graphics::CANVAS_SCALE_WINDOW;
+
+        bool running = false;
+        uint64_t frame_limit = 3600;
+        float frame_ms = 1000.0f / 60.0f;
+        double global_time = 0.0;           // Virtual ms since createWindow()
+        float delta_time = 0.0f;
+
+        bool keys[KEY_COUNT] = {};
+        std::vector<ScriptEvent> script;    // Sorted by frame
+        uint64_t script_loop = 0;           // Script length in frames if it repeats, else 0
+        uint64_t script_quit = 0;           // Frame at which the script stops the loop, else 0
+        size_t script_next = 0;             // Next event to apply
+
+        std::unordered_map<std::string, bool> files;    // Fonts checked by setFont()
+        HeadlessStats stats;
+        std::chrono::steady_clock::time_point loop_start;
+        bool looping = false;                           // The message loop ran and its summary is due
+    };
+
+    HeadlessState s_state;
+
+    /**
+     * @brief Looks up a key by the name of its scancode without the SCANCODE_ prefix: A-Z, 0-9,
+     * F1-F12, UP, DOWN, LEFT, RIGHT, SPACE, RETURN, ESCAPE, BACKSPACE and TAB.
+     *
+     * @return The scancode, or SCANCODE_UNKNOWN for other names.
+     */
+    int findKey(const std::string& name)
+    {
+        if (name.size() == 1 && name[0] >= 'A' && name[0] <= 'Z')
+            return graphics::SCANCODE_A + (name[0] - 'A');
+        if (name.size() == 1 && name[0] >= '1' && name[0] <= '9')
+            return graphics::SCANCODE_1 + (name[0] - '1');
+        if (name == "0")
+            return graphics::SCANCODE_0;
+        if (name.size() >= 2 && name[0] == 'F')
+        {
+            int number = std::atoi(name.c_str() + 1);
+            if (number >= 1 && number <= 12)
+                return graphics::SCANCODE_F1 + number - 1;
+        }
+
+        static const struct { const char* name; int key; } named[] = {
+            { "UP", graphics::SCANCODE_UP },
+            { "DOWN", graphics::SCANCODE_DOWN },
+            { "LEFT", graphics::SCANCODE_LEFT },
+            { "RIGHT", graphics::SCANCODE_RIGHT },
+            { "SPACE", graphics::SCANCODE_SPACE },
+            { "RETURN", graphics::SCANCODE_RETURN },
+            { "ESCAPE", graphics::SCANCODE_ESCAPE },
+            { "BACKSPACE", graphics::SCANCODE_BACKSPACE },
+            { "TAB", graphics::SCANCODE_TAB }
+        };
+        for (const auto& entry : named)
+        {
+            if (name == entry.name)
+                return entry.key;
+        }
+        return graphics::SCANCODE_UNKNOWN;
+    }
+
+    /**
+     * @brief Reads an input script: one statement per line, '#' starts a comment.
+     *
+     *   FRAME down KEY    Presses KEY at FRAME and holds it
+     *   FRAME up KEY      Releases KEY at FRAME
+     *   FRAME tap KEY     Presses KEY at FRAME and releases it one frame later
+     *   FRAME loop        Starts the script over at FRAME, from frame 0
+     *   FRAME quit        Stops the message loop at FRAME, as closing the window does
+     *
+     * Frames count from 0, the first update. KEY is a scancode name without the SCANCODE_ prefix.
+     *
+     * @param path Path of the script.
+     * @return False if the file cannot be read or has an invalid line; the error is printed.
+     */
+    bool parseScript(const char* path)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::fprintf(stderr, "headless: cannot read input script %s\n", path);
+            return false;
+        }
+
+        std::string line;
+        int line_number = 0;
+        while (std::getline(file, line))
+        {
+            line_number++;
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream words(line);
+            std::string frame_word, action, key_name;
+            if (!(words >> frame_word))
+                continue;
+            words >> action >> key_name;
+
+            char* end = nullptr;
+            uint64_t frame = std::strtoull(frame_word.c_str(), &end, 10);
+            bool valid = *end == '\0';
+
+            if (valid && action == "loop")
+            {
+                s_state.script_loop = frame;
+            }
+            else if (valid && action == "quit")
+            {
+                s_state.script_quit = frame;
+            }
+            else
+            {
+                ScriptEvent event;
+                event.frame = frame;
+                event.key = findKey(key_name);
+                valid = valid && event.key != graphics::SCANCODE_UNKNOWN;
+
+                if (valid && (action == "down" || action == "tap"))
+                {
+                    event.down = true;
+                    s_state.script.push_back(event);
+                }
+                if (valid && (action == "up" || action == "tap"))
+                {
+                    event.frame = action == "tap" ? frame + 1 : frame;
+                    event.down = false;
+                    s_state.script.push_back(event);
+                }
+                valid = valid && (action == "down" || action == "up" || action == "tap");
+            }
+
+            if (!valid)
+            {
+                std::fprintf(stderr, "headless: %s:%d: invalid statement '%s'\n", path, line_number, line.c_str());
+                return false;
+            }
+        }
+
+        std::stable_sort(s_state.script.begin(), s_state.script.end(),
+            [](const ScriptEvent& a, const ScriptEvent& b) { return a.frame < b.frame; });
+        return true;
+    }
+
+    /**
+     * @brief Applies the script events of a frame to the key state.
+     */
+    void applyScript(uint64_t frame)
+    {
+        uint64_t script_frame = frame;
+        if (s_state.script_loop > 0)
+        {
+            script_frame = frame % s_state.script_loop;
+            if (script_frame == 0)
+                s_state.script_next = 0;
+        }
+
+        const std::vector<ScriptEvent>& script = s_state.script;
+        while (s_state.script_next < script.size() && script[s_state.script_next].frame <= script_frame)
+        {
+            const ScriptEvent& event = script[s_state.script_next++];
+            if (event.frame == script_frame)
+                s_state.keys[event.key] = event.down;
+        }
+    }
+
+    /**
+     * @brief Reads the configuration from the environment.
+     * @return False if the input script is invalid.
+     */
+    bool configure()
+    {
+        if (const char* frames = std::getenv("PONG_HEADLESS_FRAMES"))
+            s_state.frame_limit = std::strtoull(frames, nullptr, 10);
+        if (const char* frame_ms = std::getenv("PONG_HEADLESS_FRAME_MS"))
+            s_state.frame_ms = std::max(0.001f, static_cast<float>(std::atof(frame_ms)));
+        if (const char* script = std::getenv("PONG_HEADLESS_SCRIPT"))
+            return parseScript(script);
+        return true;
+    }
+
+    /**
+     * @brief Prints the frame rate reached and the calls counted, once the message loop ends or,
+     * as the game exits from within the loop, when the process exits.
+     */
+    void printSummary()
+    {
+        if (!s_state.looping)
+            return;
+        s_state.looping = false;
+
+        const HeadlessStats& stats = s_state.stats;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - s_state.loop_start).count();
+        double frames = static_cast<double>(std::max<uint64_t>(stats.frames, 1));
+        std::fprintf(stderr,
+            "headless: %llu frames (%.1f s of game time) in %.3f s: %.0f frames/s\n"
+            "headless: per frame %.1f rects, %.1f disks, %.1f texts, %.1f other draws; %llu sounds, %llu music calls\n",
+            static_cast<unsigned long long>(stats.frames), s_state.global_time / 1000.0, seconds,
+            seconds > 0.0 ? stats.frames / seconds : 0.0,
+            stats.rects / frames, stats.disks / frames, stats.texts / frames, stats.other_draws / frames,
+            static_cast<unsigned long long>(stats.sounds), static_cast<unsigned long long>(stats.music));
+    }
+}
+
+namespace graphics
+{
+    void createWindow(int width, int height, std::string title)
+    {
+        s_state.window_width = width;
+        s_state.window_height = height;
+        s_state.canvas_width = static_cast<float>(width);
+        s_state.canvas_height = static_cast<float>(height);
+        s_state.global_time = 0.0;
+        s_state.running = configure();
+        std::atexit(printSummary);
+        std::fprintf(stderr, "headless: window '%s' (%dx%d), %.3f ms per frame\n", title.c_str(), width, height, s_state.frame_ms);
+    }
+
+    void setWindowBackground(Brush) {}
+
+    void destroyWindow()
+    {
+        s_state.running = false;
+    }
+
+    /**
+     * @brief Runs update and draw once per virtual frame until the frame limit, a quit statement
+     * of the script, or stopMessageLoop()/destroyWindow() from a callback.
+     */
+    void startMessageLoop()
+    {
+        HeadlessStats& stats = s_state.stats;
+        s_state.loop_start = std::chrono::steady_clock::now();
+        s_state.looping = true;
+
+        while (s_state.running)
+        {
+            uint64_t frame = stats.frames;
+            if ((s_state.frame_limit > 0 && frame >= s_state.frame_limit) ||
+                (s_state.script_quit > 0 && frame >= s_state.script_quit))
+                break;
+
+            applyScript(frame);
+
+            s_state.delta_time = s_state.frame_ms;
+            if (s_state.update)
+                s_state.update(s_state.frame_ms);
+            if (s_state.draw)
+                s_state.draw();
+
+            s_state.global_time += s_state.frame_ms;
+            stats.frames++;
+        }
+
+        printSummary();
+    }
+
+    void stopMessageLoop()
+    {
+        s_state.running = false;
+    }
+
+    void setCanvasSize(float w, float h)
+    {
+        s_state.canvas_width = w;
+        s_state.canvas_height = h;
+    }
+
+    void setCanvasScaleMode(scale_mode_t sm)
+    {
+        s_state.scale_mode = sm;
+    }
+
+    void setFullScreen(bool) {}
+
+    float windowToCanvasX(float x, bool clamped)
+    {
+        float canvas_x = s_state.scale_mode == CANVAS_SCALE_WINDOW || s_state.window_width == 0 ? x :
+            x * s_state.canvas_width / s_state.window_width;
+        return clamped ? std::min(std::max(canvas_x, 0.0f), s_state.canvas_width) : canvas_x;
+    }
+
+    float windowToCanvasY(float y, bool clamped)
+    {
+        float canvas_y = s_state.scale_mode == CANVAS_SCALE_WINDOW || s_state.window_height == 0 ? y :
+            y * s_state.canvas_height / s_state.window_height;
+        return clamped ? std::min(std::max(canvas_y, 0.0f), s_state.canvas_height) : canvas_y;
+    }
+
+    void setUserData(const void* user_data)
+    {
+        s_state.user_data = user_data;
+    }
+
+    void* getUserData()
+    {
+        return const_cast<void*>(s_state.user_data);
+    }
+
+    void setDrawFunction(std::function<void()> draw)
+    {
+        s_state.draw = draw;
+    }
+
+    void setUpdateFunction(std::function<void(float)> update)
+    {
+        s_state.update = update;
+    }
+
+    void setResizeFunction(std::function<void(int, int)> resize)
+    {
+        s_state.resize = resize;
+    }
+
+    void getMouseState(MouseState& ms)
+    {
+        std::memset(&ms, 0, sizeof(ms));
+    }
+
+    bool getKeyState(scancode_t key)
+    {
+        return key >= 0 && key < KEY_COUNT && s_state.keys[key];
+    }
+
+    float getDeltaTime()
+    {
+        return s_state.delta_time;
+    }
+
+    float getGlobalTime()
+    {
+        return static_cast<float>(s_state.global_time);
+    }
+
+    void drawRect(float, float, float, float, const Brush&)
+    {
+        s_state.stats.rects++;
+    }
+
+    void drawLine(float, float, float, float, const Brush&)
+    {
+        s_state.stats.other_draws++;
+    }
+
+    void drawDisk(float, float, float, const Brush&)
+    {
+        s_state.stats.disks++;
+    }
+
+    void drawSector(float, float, float, float, float, float, const Brush&)
+    {
+        s_state.stats.other_draws++;
+    }
+
+    /**
+     * @brief Succeeds if the font file can be opened, as SGG fails for a missing font. Each path
+     * is checked once.
+     */
+    bool setFont(std::string fontname)
+    {
+        auto found = s_state.files.find(fontname);
+        if (found != s_state.files.end())
+            return found->second;
+
+        bool exists = static_cast<bool>(std::ifstream(fontname));
+        s_state.files.emplace(fontname, exists);
+        return exists;
+    }
+
+    void drawText(float, float, float, const std::string&, const Brush&)
+    {
+        s_state.stats.texts++;
+    }
+
+    void setOrientation(float) {}
+    void setScale(float, float) {}
+    void resetPose() {}
+
+    /**
+     * @brief Lists the PNG files of a directory, without decoding them.
+     */
+    std::vector<std::string> preloadBitmaps(std::string dir)
+    {
+        std::vector<std::string> bitmaps;
+        DIR* directory = opendir(dir.c_str());
+        if (!directory)
+            return bitmaps;
+
+        std::string prefix = dir.empty() || dir.back() == '/' ? dir : dir + "/";
+        while (dirent* entry = readdir(directory))
+        {
+            std::string name = entry->d_name;
+            if (name.size() < 4)
+                continue;
+
+            std::string extension = name.substr(name.size() - 4);
+            for (char& c : extension)
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            if (extension == ".png")
+                bitmaps.push_back(prefix + name);
+        }
+        closedir(directory);
+        std::sort(bitmaps.begin(), bitmaps.end());
+        return bitmaps;
+    }
+
+    void playSound(std::string, float, bool)
+    {
+        s_state.stats.sounds++;
+    }
+
+    void playMusic(std::string, float, bool, int)
+    {
+        s_state.stats.music++;
+    }
+
+    void stopMusic(int) {}
+}